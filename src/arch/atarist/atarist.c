@@ -53,6 +53,7 @@
 #include <lib/initerm.h>
 #include <lib/load.h>
 #include <lib/log.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 #include <libini/libini.h>
@@ -704,6 +705,10 @@ void st_init (atari_st_t *sim, ini_sct_t *ini)
 
 	bps_init (&sim->bps);
 
+	prof_init (&sim->prof);
+
+	cover_init (&sim->cover);
+
 	st_setup_system (sim, ini);
 	st_setup_mem (sim, ini);
 	st_setup_cpu (sim, ini);
@@ -737,6 +742,22 @@ void st_init (atari_st_t *sim, ini_sct_t *ini)
 	st_clock_discontinuity (sim);
 }
 
+static
+void st_stats_update (void *ext)
+{
+	atari_st_t *sim;
+
+	sim = ext;
+
+	pce_stats_set_sim (e68_get_opcnt (sim->cpu), sim->clk_cnt, ST_CPU_CLOCK);
+	pce_stats_set_disks (sim->dsks);
+	pce_stats_set_trm (sim->trm);
+	pce_stats_set_snd ("psg", sim->psg.drv);
+	pce_stats_set_chr ("parport", sim->parport_drv);
+	pce_stats_set_chr ("serport", sim->serport_drv);
+	pce_stats_set_chr ("midi", sim->midi_drv);
+}
+
 atari_st_t *st_new (ini_sct_t *ini)
 {
 	atari_st_t *sim;
@@ -749,6 +770,8 @@ atari_st_t *st_new (ini_sct_t *ini)
 
 	st_init (sim, ini);
 
+	pce_stats_set_update_fct (st_stats_update, sim);
+
 	return (sim);
 }
 
@@ -777,6 +800,10 @@ void st_free (atari_st_t *sim)
 	mem_del (sim->mem);
 
 	bps_free (&sim->bps);
+	prof_free (&sim->prof);
+	cover_free (&sim->cover);
+
+	pce_stats_set_update_fct (NULL, NULL);
 }
 
 void st_del (atari_st_t *sim)
@@ -972,6 +999,10 @@ void st_clock (atari_st_t *sim, unsigned n)
 
 	sim->clk_cnt += n;
 
+	if (sim->prof.enabled) {
+		prof_add (&sim->prof, e68_get_pc (sim->cpu), cpuclk);
+	}
+
 	e68_clock (sim->cpu, cpuclk);
 
 	st_video_clock (sim->video, n);
@@ -1040,6 +1071,8 @@ void st_clock (atari_st_t *sim, unsigned n)
 
 	st_fdc_clock_media_change (&sim->fdc, 8192);
 
+	pce_stats_check();
+
 	st_realtime_sync (sim, 8192);
 
 	sim->clk_div[2] -= 8192;
@@ -49,6 +49,8 @@
 #include <drivers/video/keys.h>
 
 #include <lib/brkpt.h>
+#include <lib/cover.h>
+#include <lib/prof.h>
 
 #include <libini/libini.h>
 
@@ -69,6 +71,9 @@ struct atari_st_s {
 	memory_t      *mem;
 	mem_blk_t     *ram;
 	bp_set_t      bps;
+	prof_t        prof;
+
+	cover_t       cover;
 	e68901_t      mfp;
 	e6850_t       acia0;
 	e6850_t       acia1;
@@ -28,9 +28,12 @@
 #include <string.h>
 
 #include <lib/console.h>
+#include <lib/cover.h>
 #include <lib/log.h>
 #include <lib/monitor.h>
 #include <lib/msgdsk.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
@@ -41,16 +44,21 @@
 
 mon_cmd_t par_cmd[] = {
 	{ "c", "[cnt]", "clock" },
+	{ "cover", "[on|off|clear|list|save fname]", "control guest code coverage" },
 	{ "gb", "[addr..]", "run with breakpoints at addr" },
 	{ "ge", "[exception]", "run until exception" },
 	{ "g", "", "run" },
 	{ "halt", "[val]", "set halt state [2]" },
 	{ "hm", "", "print help on messages" },
 	{ "p", "[cnt]", "execute cnt instructions, skip calls [1]" },
+	{ "prof", "[on|off|clear|stack on|off]", "control the profiler" },
+	{ "prof", "[flat [cnt]|folded|save fname]", "print or save the profile" },
 	{ "reset", "", "reset" },
 	{ "rte", "", "execute to next rte" },
 	{ "r", "reg [val]", "get or set a register" },
 	{ "s", "[what]", "print status (acia0|acia1|cpu|disks|dma|mem|mfp|psg|video)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
 	{ "u", "[w][[-]addr [cnt]]", "disassemble" },
 	{ "uw", "[addr [cnt]]", "disassemble as constant words" }
@@ -665,6 +673,31 @@ void st_log_exception (void *ext, unsigned tn)
 	);
 }
 
+static
+void st_log_opcode (void *ext, unsigned long ir)
+{
+	atari_st_t *sim = ext;
+
+	if (sim->cover.enabled) {
+		cover_add (&sim->cover, e68_get_pc (sim->cpu));
+	}
+
+	if (sim->prof.enabled && sim->prof.stack) {
+		prof_op_e68 (&sim->prof, e68_get_pc (sim->cpu), ir);
+	}
+}
+
+void st_prof_update (atari_st_t *sim)
+{
+	if ((sim->prof.enabled && sim->prof.stack) || sim->cover.enabled) {
+		sim->cpu->log_opcode = st_log_opcode;
+	}
+	else {
+		sim->cpu->log_opcode = NULL;
+		sim->prof.call = 0;
+	}
+}
+
 
 /*
  * c - clock
@@ -1295,6 +1328,10 @@ int st_cmd (atari_st_t *sim, cmd_t *cmd)
 	if (cmd_match (cmd, "b")) {
 		cmd_do_b (cmd, &sim->bps);
 	}
+	else if (cmd_match (cmd, "cover")) {
+		cover_cmd (cmd, &sim->cover);
+		st_prof_update (sim);
+	}
 	else if (cmd_match (cmd, "c")) {
 		st_cmd_c (cmd, sim);
 	}
@@ -1307,6 +1344,10 @@ int st_cmd (atari_st_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "hm")) {
 		st_cmd_hm (cmd);
 	}
+	else if (cmd_match (cmd, "prof")) {
+		prof_cmd (cmd, &sim->prof);
+		st_prof_update (sim);
+	}
 	else if (cmd_match (cmd, "p")) {
 		st_cmd_p (cmd, sim);
 	}
@@ -1322,6 +1363,9 @@ int st_cmd (atari_st_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "r")) {
 		st_cmd_r (cmd, sim);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		st_cmd_s (cmd, sim);
 	}
@@ -1352,4 +1396,6 @@ void st_cmd_init (atari_st_t *sim, monitor_t *mon)
 	sim->cpu->log_undef = NULL;
 	sim->cpu->log_exception = st_log_exception;
 	sim->cpu->log_mem = NULL;
+
+	st_prof_update (sim);
 }
@@ -36,6 +36,8 @@ void st_run (atari_st_t *sim);
 
 int st_cmd (atari_st_t *sim, cmd_t *cmd);
 
+void st_prof_update (atari_st_t *sim);
+
 void st_cmd_init (atari_st_t *sim, monitor_t *mon);
 
 
@@ -80,6 +80,8 @@ int st_write_track (void *ext, unsigned d, unsigned c, unsigned h, pri_trk_t *tr
 
 	fdc->modified[d & 1] = 1;
 
+	trk->dirty = 1;
+
 	return (0);
 }
 
@@ -449,7 +451,15 @@ int st_fdc_save_disk_psi (st_fdc_t *fdc, disk_t *dsk, unsigned drive)
 		return (1);
 	}
 
+	pri_img_clear_dirty (fdc->img[drive]);
+
 	psi = dsk->ext;
+
+	/* keep the tracks modified since the last commit */
+	if (psi_img_copy_dirty (img, psi->img)) {
+		psi->compact = 1;
+	}
+
 	psi_img_del (psi->img);
 	psi->img = img;
 	psi->dirty = 1;
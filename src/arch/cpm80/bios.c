@@ -374,112 +374,239 @@ int bios_map_sector (const c80_disk_t *dt, unsigned trk, unsigned sct, c80_chsi_
 }
 
 static
-int bios_read_sector (cpm80_t *sim, void *buf, unsigned drv, unsigned trk, unsigned sct)
+int bios_read_phys (disk_t *dsk, void *buf, unsigned n, unsigned c, unsigned h, unsigned s)
 {
-	unsigned      cnt;
-	disk_t        *dsk;
-	c80_disk_t    *dt;
-	c80_chsi_t    chs;
-	unsigned char tmp[2048];
+	unsigned cnt;
 
-	if (bios_get_disk (sim, drv, &dsk, &dt)) {
-		return (1);
-	}
+	if (dsk_get_type (dsk) == PCE_DISK_PSI) {
+		cnt = n;
 
-	if (dt->n > 2048) {
-		return (1);
+		if (dsk_psi_read_chs (dsk->ext, buf, &cnt, c, h, s, 0) != 0) {
+			return (1);
+		}
+
+		if (cnt != n) {
+			return (1);
+		}
 	}
+	else {
+		if (n != 512) {
+			return (1);
+		}
 
-	if (bios_map_sector (dt, trk, sct, &chs)) {
-		return (1);
+		if (dsk_read_chs (dsk, buf, c, h, s, 1)) {
+			return (1);
+		}
 	}
 
+	return (0);
+}
+
+static
+int bios_write_phys (disk_t *dsk, const void *buf, unsigned n, unsigned c, unsigned h, unsigned s)
+{
+	unsigned cnt;
+
 	if (dsk_get_type (dsk) == PCE_DISK_PSI) {
-		cnt = dt->n;
+		cnt = n;
 
-		if (dsk_psi_read_chs (dsk->ext, tmp, &cnt, chs.c, chs.h, chs.s, 0) != 0) {
+		if (dsk_psi_write_chs (dsk->ext, buf, &cnt, c, h, s, 0) != 0) {
 			return (1);
 		}
 
-		if (cnt != dt->n) {
+		if (cnt != n) {
 			return (1);
 		}
 	}
 	else {
-		if (dt->n != 512) {
+		if (n != 512) {
 			return (1);
 		}
 
-		if (dsk_read_chs (dsk, tmp, chs.c, chs.h, chs.s, 1)) {
+		if (dsk_write_chs (dsk, buf, c, h, s, 1)) {
 			return (1);
 		}
+	}
+
+	return (0);
+}
+
+/*
+ * Write back all modified sectors in a track buffer.
+ */
+static
+int bios_buf_flush (c80_trk_t *buf)
+{
+	int      r;
+	unsigned i;
 
+	if (buf->dsk == NULL) {
+		return (0);
 	}
 
-	memcpy (buf, tmp + 128 * chs.i, 128);
+	r = 0;
 
-	return (0);
+	for (i = 0; i < buf->cnt; i++) {
+		if (buf->dirty[i] == 0) {
+			continue;
+		}
+
+		if (bios_write_phys (buf->dsk, buf->data + i * buf->n, buf->n, buf->c, buf->h, buf->id[i])) {
+			pce_log (MSG_ERR, "*** bios: write error (drive %u, %u/%u/%u)\n",
+				buf->dsk->drive, buf->c, buf->h, buf->id[i]
+			);
+
+			r = 1;
+		}
+
+		buf->dirty[i] = 0;
+	}
+
+	return (r);
 }
 
 static
-int bios_write_sector (cpm80_t *sim, const void *buf, unsigned drv, unsigned trk, unsigned sct)
+void bios_buf_discard (c80_trk_t *buf)
 {
-	unsigned      cnt;
-	disk_t        *dsk;
-	c80_disk_t    *dt;
-	c80_chsi_t    chs;
-	unsigned char tmp[512];
+	buf->dsk = NULL;
+	buf->cnt = 0;
+}
 
-	if (bios_get_disk (sim, drv, &dsk, &dt)) {
-		return (1);
+/*
+ * Make a track buffer hold the track c/h of disk dsk.
+ */
+static
+int bios_buf_select (c80_trk_t *buf, disk_t *dsk, const c80_disk_t *dt, unsigned c, unsigned h)
+{
+	unsigned long size;
+	unsigned char *tmp;
+
+	if ((buf->dsk == dsk) && (buf->c == c) && (buf->h == h) && (buf->n == dt->n)) {
+		return (0);
 	}
 
-	if (dt->n > 2048) {
-		return (1);
+	if (buf->dsk == dsk) {
+		bios_buf_flush (buf);
 	}
 
-	if (bios_map_sector (dt, trk, sct, &chs)) {
+	/*
+	 * If the disk changed, the old disk is gone and there is
+	 * nothing left to write the buffer to.
+	 */
+	bios_buf_discard (buf);
+
+	if ((dt->s == 0) || (dt->s > CPM80_TRK_MAX)) {
 		return (1);
 	}
 
-	if (dsk_get_type (dsk) == PCE_DISK_PSI) {
-		cnt = dt->n;
+	size = (unsigned long) dt->s * dt->n;
 
-		if (dsk_psi_read_chs (dsk->ext, tmp, &cnt, chs.c, chs.h, chs.s, 0) != 0) {
+	if (size > buf->size) {
+		if ((tmp = realloc (buf->data, size)) == NULL) {
 			return (1);
 		}
 
-		if (cnt != dt->n) {
-			return (1);
-		}
+		buf->data = tmp;
+		buf->size = size;
+	}
 
-		memcpy (tmp + 128 * chs.i, buf, 128);
+	buf->dsk = dsk;
+	buf->c = c;
+	buf->h = h;
+	buf->n = dt->n;
+	buf->max = dt->s;
 
-		if (dsk_psi_write_chs (dsk->ext, tmp, &cnt, chs.c, chs.h, chs.s, 0) != 0) {
-			return (1);
-		}
+	return (0);
+}
 
-		if (cnt != dt->n) {
-			return (1);
+/*
+ * Get a pointer to a 128 byte CP/M sector in the track buffer, reading
+ * the physical sector if necessary.
+ */
+static
+unsigned char *bios_get_sector (cpm80_t *sim, unsigned drv, unsigned trk, unsigned sct, int wr)
+{
+	unsigned   i;
+	disk_t     *dsk;
+	c80_disk_t *dt;
+	c80_chsi_t chs;
+	c80_trk_t  *buf;
+
+	if (bios_get_disk (sim, drv, &dsk, &dt)) {
+		return (NULL);
+	}
+
+	if (bios_map_sector (dt, trk, sct, &chs)) {
+		return (NULL);
+	}
+
+	buf = &sim->bios_buf[drv];
+
+	if (bios_buf_select (buf, dsk, dt, chs.c, chs.h)) {
+		return (NULL);
+	}
+
+	for (i = 0; i < buf->cnt; i++) {
+		if (buf->id[i] == chs.s) {
+			break;
 		}
 	}
-	else {
-		if (dt->n != 512) {
-			return (1);
+
+	if (i >= buf->cnt) {
+		if (buf->cnt >= buf->max) {
+			bios_buf_flush (buf);
+			buf->cnt = 0;
 		}
 
-		if (dsk_read_chs (dsk, tmp, chs.c, chs.h, chs.s, 1)) {
-			return (1);
+		i = buf->cnt;
+
+		if (bios_read_phys (dsk, buf->data + i * buf->n, buf->n, chs.c, chs.h, chs.s)) {
+			return (NULL);
 		}
 
-		memcpy (tmp + 128 * chs.i, buf, 128);
+		buf->id[i] = chs.s;
+		buf->dirty[i] = 0;
+		buf->cnt += 1;
+	}
 
-		if (dsk_write_chs (dsk, tmp, chs.c, chs.h, chs.s, 1)) {
-			return (1);
+	if (wr) {
+		buf->dirty[i] = 1;
+	}
+
+	return (buf->data + i * buf->n + 128 * chs.i);
+}
+
+int c80_bios_flush (cpm80_t *sim, int discard)
+{
+	int      r;
+	unsigned i;
+
+	r = 0;
+
+	for (i = 0; i < CPM80_DRIVE_MAX; i++) {
+		if (bios_buf_flush (&sim->bios_buf[i])) {
+			r = 1;
+		}
+
+		if (discard) {
+			bios_buf_discard (&sim->bios_buf[i]);
 		}
 	}
 
-	return (0);
+	return (r);
+}
+
+/*
+ * Get a pointer to the 128 byte DMA buffer, if it is in RAM.
+ */
+static
+unsigned char *bios_get_dma (cpm80_t *sim)
+{
+	if (mem_get_blk (sim->mem, sim->bios_dma) != sim->ram) {
+		return (NULL);
+	}
+
+	return (mem_get_ptr (sim->mem, sim->bios_dma, 128));
 }
 
 static
@@ -659,6 +786,8 @@ void bios_boot (cpm80_t *sim, int warm)
 #endif
 	}
 
+	c80_bios_flush (sim, 1);
+
 	if (pce_load_mem (sim->mem, sim->cpm, NULL, 0)) {
 		con_puts (sim, "ERROR 01: ");
 		con_puts (sim, sim->cpm);
@@ -839,6 +968,9 @@ void bios_home (cpm80_t *sim)
 #endif
 
 	sim->bios_trk = 0;
+
+	/* the bdos homes a drive when it logs it in after a disk reset */
+	c80_bios_flush (sim, 0);
 }
 
 /*
@@ -919,7 +1051,7 @@ static
 void bios_read (cpm80_t *sim)
 {
 	unsigned      i;
-	unsigned char buf[128];
+	unsigned char *buf, *dma;
 
 #if DEBUG_BIOS >= 2
 	sim_log_deb ("BIOS: %c: READ T=%02X S=%02X A=%04X\n",
@@ -927,13 +1059,20 @@ void bios_read (cpm80_t *sim)
 	);
 #endif
 
-	if (bios_read_sector (sim, buf, sim->bios_dsk, sim->bios_trk, sim->bios_sec)) {
+	buf = bios_get_sector (sim, sim->bios_dsk, sim->bios_trk, sim->bios_sec, 0);
+
+	if (buf == NULL) {
 		e8080_set_a (sim->cpu, 1);
 		return;
 	}
 
-	for (i = 0; i < 128; i++) {
-		mem_set_uint8 (sim->mem, sim->bios_dma + i, buf[i]);
+	if ((dma = bios_get_dma (sim)) != NULL) {
+		memcpy (dma, buf, 128);
+	}
+	else {
+		for (i = 0; i < 128; i++) {
+			mem_set_uint8 (sim->mem, sim->bios_dma + i, buf[i]);
+		}
 	}
 
 	e8080_set_a (sim->cpu, 0);
@@ -946,7 +1085,7 @@ static
 void bios_write (cpm80_t *sim)
 {
 	unsigned      i;
-	unsigned char buf[128];
+	unsigned char *buf, *dma;
 
 #if DEBUG_BIOS >= 2
 	sim_log_deb ("BIOS: %c: WRITE T=%02X S=%02X A=%04X\n",
@@ -954,15 +1093,30 @@ void bios_write (cpm80_t *sim)
 	);
 #endif
 
-	for (i = 0; i < 128; i++) {
-		buf[i] = mem_get_uint8 (sim->mem, sim->bios_dma + i);
-	}
+	buf = bios_get_sector (sim, sim->bios_dsk, sim->bios_trk, sim->bios_sec, 1);
 
-	if (bios_write_sector (sim, buf, sim->bios_dsk, sim->bios_trk, sim->bios_sec)) {
+	if (buf == NULL) {
 		e8080_set_a (sim->cpu, 1);
 		return;
 	}
 
+	if ((dma = bios_get_dma (sim)) != NULL) {
+		memcpy (buf, dma, 128);
+	}
+	else {
+		for (i = 0; i < 128; i++) {
+			buf[i] = mem_get_uint8 (sim->mem, sim->bios_dma + i);
+		}
+	}
+
+	/* CP/M 2 sets C to 1 for directory writes, which are not deferred */
+	if ((sim->cpm_version >= 0x20) && (e8080_get_c (sim->cpu) == 1)) {
+		if (bios_buf_flush (&sim->bios_buf[sim->bios_dsk])) {
+			e8080_set_a (sim->cpu, 1);
+			return;
+		}
+	}
+
 	e8080_set_a (sim->cpu, 0);
 }
 
@@ -1116,5 +1270,21 @@ void c80_bios_init (cpm80_t *sim)
 		sim->bios_disk_type[i] = 0;
 	}
 
+	c80_bios_flush (sim, 1);
+
 	bios_init_traps (sim, 0);
 }
+
+void c80_bios_free (cpm80_t *sim)
+{
+	unsigned i;
+
+	c80_bios_flush (sim, 1);
+
+	for (i = 0; i < CPM80_DRIVE_MAX; i++) {
+		free (sim->bios_buf[i].data);
+
+		sim->bios_buf[i].data = NULL;
+		sim->bios_buf[i].size = 0;
+	}
+}
@@ -38,6 +38,13 @@ int lst_putc (cpm80_t *sim, unsigned char c);
 
 void c80_bios (cpm80_t *sim, unsigned fct);
 void c80_bios_init (cpm80_t *sim);
+void c80_bios_free (cpm80_t *sim);
+
+/*!***************************************************************************
+ * @short Write back all modified sectors in the BIOS track buffers
+ * @param discard If true, the buffers are emptied as well
+ *****************************************************************************/
+int c80_bios_flush (cpm80_t *sim, int discard);
 
 
 #endif
@@ -32,6 +32,8 @@
 #include <lib/console.h>
 #include <lib/log.h>
 #include <lib/monitor.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
@@ -42,8 +44,12 @@ static mon_cmd_t par_cmd[] = {
 	{ "i", "port", "input a byte from a port" },
 	{ "o", "port val", "output a byte to a port" },
 	{ "p", "[cnt]", "execute cnt instructions, skip calls [1]" },
+	{ "prof", "[on|off|clear]", "control the profiler" },
+	{ "prof", "[flat [cnt]|folded|save fname]", "print or save the profile" },
 	{ "r", "reg [val]", "set a register" },
 	{ "s", "[what]", "print status (cpu|mem)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "trace", "on|off|expr", "turn trace on or off" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
 	{ "u", "[addr [cnt]]", "disassemble" }
@@ -380,6 +386,8 @@ void c80_run (cpm80_t *sim)
 		}
 	}
 
+	c80_bios_flush (sim, 0);
+
 	pce_stop();
 }
 
@@ -785,12 +793,18 @@ int c80_cmd (cpm80_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "o")) {
 		c80_cmd_o (sim, cmd);
 	}
+	else if (cmd_match (cmd, "prof")) {
+		prof_cmd (cmd, &sim->prof);
+	}
 	else if (cmd_match (cmd, "p")) {
 		c80_cmd_p (sim, cmd);
 	}
 	else if (cmd_match (cmd, "r")) {
 		c80_cmd_r (sim, cmd);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		c80_cmd_s (sim, cmd);
 	}
@@ -42,6 +42,7 @@
 #include <lib/iniram.h>
 #include <lib/load.h>
 #include <lib/log.h>
+#include <lib/stats.h>
 #include <lib/msg.h>
 #include <lib/path.h>
 #include <lib/string.h>
@@ -333,6 +334,20 @@ void c80_setup_disks (cpm80_t *sim, ini_sct_t *ini)
 	}
 }
 
+static
+void c80_stats_update (void *ext)
+{
+	cpm80_t *sim;
+
+	sim = ext;
+
+	pce_stats_set_sim (e8080_get_opcnt (sim->cpu), e8080_get_clock (sim->cpu), sim->clock);
+	pce_stats_set_disks (sim->dsks);
+	pce_stats_set_chr ("con", sim->con);
+	pce_stats_set_chr ("aux", sim->aux);
+	pce_stats_set_chr ("lst", sim->lst);
+}
+
 cpm80_t *c80_new (ini_sct_t *ini)
 {
 	cpm80_t *sim;
@@ -344,6 +359,7 @@ cpm80_t *c80_new (ini_sct_t *ini)
 	memset (sim, 0, sizeof (cpm80_t));
 
 	bps_init (&sim->bps);
+	prof_init (&sim->prof);
 
 	c80_setup_system (sim, ini);
 	c80_setup_mem (sim, ini);
@@ -356,6 +372,8 @@ cpm80_t *c80_new (ini_sct_t *ini)
 		c80_bios_init (sim);
 	}
 
+	pce_stats_set_update_fct (c80_stats_update, sim);
+
 	return (sim);
 }
 
@@ -381,14 +399,18 @@ void c80_del (cpm80_t *sim)
 		return;
 	}
 
+	pce_stats_set_update_fct (NULL, NULL);
+
 	free (sim->load);
 	free (sim->cpm);
 
+	c80_bios_free (sim);
 	dsks_del (sim->dsks);
 	c80_del_char (sim);
 	e8080_del (sim->cpu);
 	mem_del (sim->mem);
 	bps_free (&sim->bps);
+	prof_free (&sim->prof);
 
 	free (sim);
 }
@@ -583,8 +605,14 @@ void c80_clock (cpm80_t *sim, unsigned n)
 	if (sim->clk_div >= 16384) {
 		sim->clk_div -= 16384;
 
+		pce_stats_check();
+
 		c80_realtime_sync (sim, 16384);
 	}
 
+	if (sim->prof.enabled) {
+		prof_add (&sim->prof, e8080_get_pc (sim->cpu), n);
+	}
+
 	e8080_clock (sim->cpu, n);
 }
@@ -30,6 +30,7 @@
 #include <drivers/char/char.h>
 #include <libini/libini.h>
 #include <lib/brkpt.h>
+#include <lib/prof.h>
 
 
 #define PCE_BRK_STOP  1
@@ -38,11 +39,36 @@
 
 #define CPM80_CPU_SYNC  100
 #define CPM80_DRIVE_MAX 16
+#define CPM80_TRK_MAX   64
 
 #define CPM80_MODEL_PLAIN 0
 #define CPM80_MODEL_CPM   1
 
 
+/*****************************************************************************
+ * @short A BIOS track buffer
+ *
+ * The buffer holds the physical sectors of one track, in the order in
+ * which they were first accessed. Modified sectors are written back
+ * when the track changes or when the buffer is flushed.
+ *****************************************************************************/
+typedef struct {
+	disk_t         *dsk;
+
+	unsigned short c;
+	unsigned short h;
+	unsigned short n;
+
+	unsigned       cnt;
+	unsigned       max;
+	unsigned short id[CPM80_TRK_MAX];
+	unsigned char  dirty[CPM80_TRK_MAX];
+
+	unsigned long  size;
+	unsigned char  *data;
+} c80_trk_t;
+
+
 /*****************************************************************************
  * @short The cpm80 context struct
  *****************************************************************************/
@@ -55,6 +81,7 @@ typedef struct cpm80_s {
 	mem_blk_t      *ram;
 
 	bp_set_t       bps;
+	prof_t         prof;
 
 	unsigned long  clk_cnt;
 	unsigned long  clk_div;
@@ -101,6 +128,7 @@ typedef struct cpm80_s {
 	unsigned       bios_disk_cnt;
 	unsigned char  bios_disk_type[CPM80_DRIVE_MAX];
 	unsigned short bios_disk_dph[CPM80_DRIVE_MAX];
+	c80_trk_t      bios_buf[CPM80_DRIVE_MAX];
 
 	unsigned short bios_index;
 	unsigned long  bios_limit;
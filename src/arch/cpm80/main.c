@@ -39,6 +39,8 @@
 #include <lib/log.h>
 #include <lib/monitor.h>
 #include <lib/path.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
@@ -49,6 +51,8 @@ ini_sct_t  *par_cfg = NULL;
 
 static ini_strings_t par_ini_str;
 
+static const char    *par_prof = NULL;
+
 
 static pce_option_t opts[] = {
 	{ '?', 0, "help", NULL, "Print usage information" },
@@ -57,7 +61,9 @@ static pce_option_t opts[] = {
 	{ 'd', 1, "path", "string", "Add a directory to the search path" },
 	{ 'i', 1, "ini-prefix", "string", "Add an ini string before the config file" },
 	{ 'I', 1, "ini-append", "string", "Add an ini string after the config file" },
+	{ 'k', 1, "config-cache", "string", "Set the config cache file name [none]" },
 	{ 'l', 1, "log", "string", "Set the log file name [none]" },
+	{ 'P', 1, "profile", "string", "Profile guest code and save the profile [none]" },
 	{ 'q', 0, "quiet", NULL, "Set the log level to error [no]" },
 	{ 'r', 0, "run", NULL, "Start running immediately [no]" },
 	{ 'R', 0, "no-monitor", NULL, "Never stop running [no]" },
@@ -212,6 +218,8 @@ int main (int argc, char *argv[])
 	pce_log_init();
 	pce_log_add_fp (stderr, 0, MSG_INF);
 
+	pce_stats_init();
+
 	par_cfg = ini_sct_new (NULL);
 
 	if (par_cfg == NULL) {
@@ -266,10 +274,18 @@ int main (int argc, char *argv[])
 			ini_str_add (&par_ini_str, optarg[0], "\n", NULL);
 			break;
 
+		case 'k':
+			pce_set_config_cache (optarg[0]);
+			break;
+
 		case 'l':
 			pce_log_add_fname (optarg[0], MSG_DEB);
 			break;
 
+		case 'P':
+			par_prof = optarg[0];
+			break;
+
 		case 'q':
 			pce_log_set_level (stderr, MSG_ERR);
 			break;
@@ -339,6 +355,10 @@ int main (int argc, char *argv[])
 	cmd_init (par_sim, cmd_get_sym, cmd_set_sym);
 	c80_cmd_init (par_sim, &par_mon);
 
+	if (par_prof != NULL) {
+		par_sim->prof.enabled = 1;
+	}
+
 	c80_reset (par_sim);
 
 	if (nomon) {
@@ -361,9 +381,18 @@ int main (int argc, char *argv[])
 		mon_run (&par_mon);
 	}
 
+	if (par_prof != NULL) {
+		if (prof_save (&par_sim->prof, par_prof)) {
+			fprintf (stderr, "%s: writing profile failed (%s)\n",
+				argv[0], par_prof
+			);
+		}
+	}
+
 	c80_del (par_sim);
 
 	mon_free (&par_mon);
+	pce_stats_done();
 	pce_console_done();
 	pce_log_done();
 
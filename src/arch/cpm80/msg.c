@@ -21,6 +21,7 @@
 
 
 #include "main.h"
+#include "bios.h"
 #include "cpm80.h"
 #include "msg.h"
 
@@ -158,6 +159,8 @@ int c80_set_msg_emu_disk_commit (cpm80_t *sim, const char *msg, const char *val)
 	int      r;
 	unsigned drv;
 
+	c80_bios_flush (sim, 0);
+
 	if (strcmp (val, "all") == 0) {
 		pce_log (MSG_INF, "commiting all drives\n");
 
@@ -202,6 +205,8 @@ int c80_set_msg_emu_disk_eject (cpm80_t *sim, const char *msg, const char *val)
 	unsigned drv;
 	disk_t   *dsk;
 
+	c80_bios_flush (sim, 1);
+
 	while (*val != 0) {
 		if (msg_get_prefix_uint (&val, &drv, ":", " \t")) {
 			pce_log (MSG_ERR,
@@ -234,6 +239,8 @@ int c80_set_msg_emu_disk_eject (cpm80_t *sim, const char *msg, const char *val)
 static
 int c80_set_msg_emu_disk_insert (cpm80_t *sim, const char *msg, const char *val)
 {
+	c80_bios_flush (sim, 1);
+
 	if (dsk_insert (sim->dsks, val, 1)) {
 		return (1);
 	}
@@ -119,7 +119,7 @@ unsigned char sim_get_port8 (void *ext, unsigned long addr)
 	}
 
 	fprintf (stderr, "unknown port8 read: %04lX\n", addr);
-	exit (1);
+	sim_exit (ext, 1);
 
 	return (0);
 }
@@ -128,7 +128,7 @@ static
 unsigned short sim_get_port16 (void *ext, unsigned long addr)
 {
 	fprintf (stderr, "unknown port16 read: %04lX\n", addr);
-	exit (1);
+	sim_exit (ext, 1);
 
 	return (0);
 }
@@ -137,14 +137,14 @@ static
 void sim_set_port8 (void *ext, unsigned long addr, unsigned char val)
 {
 	fprintf (stderr, "unknown port8 write: %04lX <- %02X\n", addr, val);
-	exit (1);
+	sim_exit (ext, 1);
 }
 
 static
 void sim_set_port16 (void *ext, unsigned long addr, unsigned short val)
 {
 	fprintf (stderr, "unknown port16 write: %04lX <- %04X\n", addr, val);
-	exit (1);
+	sim_exit (ext, 1);
 }
 
 unsigned char sim_get_uint8 (dos_t *sim, unsigned short seg, unsigned short ofs)
@@ -431,6 +431,9 @@ int sim_init (dos_t *sim, unsigned kb)
 	sim->log_int = 0;
 	sim->cur_drive = 2;
 
+	sim->terminated = 0;
+	sim->exit_code = 0;
+
 	sim->file_cnt = DOS_FILES_MAX;
 
 	for (i = 0; i < sim->file_cnt; i++) {
@@ -449,22 +452,68 @@ int sim_init (dos_t *sim, unsigned kb)
 
 	sim_set_drive (sim, 2, ".");
 
-	sim->search_dir = NULL;
+	sim->search_idx = 0;
 	sim->search_dir_name = NULL;
 
+	sim->dir_valid = 0;
+	sim->dir_name = NULL;
+	sim->dir_mtime = 0;
+	sim->dir_cnt = 0;
+	sim->dir_ent = NULL;
+
 	return (0);
 }
 
 void sim_free (dos_t *sim)
 {
+	unsigned i;
+
+	for (i = 3; i < sim->file_cnt; i++) {
+		if (sim->file[i] != NULL) {
+			fclose (sim->file[i]);
+			sim->file[i] = NULL;
+		}
+	}
+
+	for (i = 0; i < sim->drive_cnt; i++) {
+		free (sim->drive[i]);
+		sim->drive[i] = NULL;
+	}
+
+	free (sim->search_dir_name);
+	sim->search_dir_name = NULL;
+
+	for (i = 0; i < sim->dir_cnt; i++) {
+		free (sim->dir_ent[i]);
+	}
+
+	free (sim->dir_ent);
+	free (sim->dir_name);
+
+	sim->dir_cnt = 0;
+	sim->dir_ent = NULL;
+	sim->dir_name = NULL;
+
 	free (sim->mem);
 
 	e86_free (&sim->cpu);
 }
 
-void sim_run (dos_t *sim)
+void sim_exit (dos_t *sim, unsigned code)
 {
-	while (1) {
+	sim->terminated = 1;
+	sim->exit_code = code & 0xff;
+
+	sim->cpu.state |= E86_STATE_HALT;
+}
+
+int sim_run (dos_t *sim)
+{
+	while (sim->terminated == 0) {
 		e86_clock (&sim->cpu, 64);
 	}
+
+	fflush (stdout);
+
+	return (sim->exit_code);
 }
@@ -28,7 +28,7 @@
 
 #include <cpu/e8086/e8086.h>
 
-#include <dirent.h>
+#include <time.h>
 
 
 #define DOS_FILES_MAX  32
@@ -44,6 +44,10 @@ typedef struct {
 
 	char           log_int;
 
+	/* the program has terminated */
+	char           terminated;
+	unsigned char  exit_code;
+
 	unsigned short env;
 	unsigned short psp;
 	unsigned short dta[2];
@@ -55,10 +59,17 @@ typedef struct {
 	unsigned       drive_cnt;
 	char           *drive[DOS_DRIVES_MAX];
 
-	DIR            *search_dir;
+	unsigned       search_idx;
 	unsigned char  search_attr;
 	char           *search_dir_name;
 	char           search_name[12];
+
+	/* the cached listing of the last searched directory */
+	char           dir_valid;
+	char           *dir_name;
+	time_t         dir_mtime;
+	unsigned       dir_cnt;
+	char           **dir_ent;
 } dos_t;
 
 
@@ -78,7 +89,18 @@ int sim_init_args (dos_t *sim, const char **argv);
 int sim_init (dos_t *sim, unsigned kb);
 void sim_free (dos_t *sim);
 
-void sim_run (dos_t *sim);
+/*!***************************************************************************
+ * @short Terminate the program
+ *
+ * This stops the CPU and makes sim_run() return exit code.
+ *****************************************************************************/
+void sim_exit (dos_t *sim, unsigned code);
+
+/*!***************************************************************************
+ * @short Run the program until it terminates
+ * @return The program exit code
+ *****************************************************************************/
+int sim_run (dos_t *sim);
 
 
 #endif
@@ -28,6 +28,34 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+
+/*
+ * Files that were modified less than this many seconds ago are not
+ * cached. st_mtime has a resolution of one second, so a file that is
+ * rewritten with the same size in the same second would look unchanged.
+ */
+#define EXEC_CACHE_AGE 2
+
+
+/* a host file that is kept in memory between programs */
+typedef struct exec_cache_s {
+	struct exec_cache_s *next;
+
+	char                *name;
+
+	unsigned long       size;
+	unsigned long       ino;
+	time_t              mtime;
+
+	unsigned char       *data;
+} exec_cache_t;
+
+
+static char         par_cache_enabled = 0;
+static exec_cache_t *par_cache = NULL;
 
 
 static
@@ -43,20 +71,18 @@ unsigned short get_uint16_le (const void *buf, unsigned addr)
 }
 
 static
-int sim_reloc_exe (dos_t *sim, FILE *fp, unsigned base, unsigned para, unsigned relofs, unsigned relcnt)
+int sim_reloc_exe (dos_t *sim, const unsigned char *img, unsigned long size, unsigned base, unsigned para, unsigned relofs, unsigned relcnt)
 {
-	unsigned       i;
-	unsigned short rseg, rofs, val;
-	unsigned char  buf[4];
+	unsigned            i;
+	unsigned short      rseg, rofs, val;
+	const unsigned char *buf;
 
-	if (fseek (fp, relofs, SEEK_SET)) {
+	if ((relofs + 4UL * relcnt) > size) {
 		return (1);
 	}
 
 	for (i = 0; i < relcnt; i++) {
-		if (fread (buf, 4, 1, fp) != 1) {
-			return (1);
-		}
+		buf = img + relofs + 4UL * i;
 
 		rofs = ((unsigned) buf[1] << 8) | buf[0];
 		rseg = ((unsigned) buf[3] << 8) | buf[2];
@@ -70,7 +96,7 @@ int sim_reloc_exe (dos_t *sim, FILE *fp, unsigned base, unsigned para, unsigned
 }
 
 static
-int sim_exec_exe (dos_t *sim, FILE *fp)
+int sim_exec_exe (dos_t *sim, const unsigned char *img, unsigned long fsize)
 {
 	unsigned short para;
 	unsigned short size1, size2;
@@ -81,12 +107,14 @@ int sim_exec_exe (dos_t *sim, FILE *fp)
 	unsigned long  para_min, para_max;
 	unsigned short hsize;
 	unsigned short cs, ip, ss, sp;
-	unsigned char  hdr[32];
+	const unsigned char *hdr;
 
-	if (fread (hdr, 1, 32, fp) != 32) {
+	if (fsize < 32) {
 		return (1);
 	}
 
+	hdr = img;
+
 	if ((hdr[0] != 'M') || (hdr[1] != 'Z')) {
 		return (1);
 	}
@@ -125,16 +153,14 @@ int sim_exec_exe (dos_t *sim, FILE *fp)
 		return (1);
 	}
 
-	if (fseek (fp, imgbase, SEEK_SET)) {
+	if ((imgbase > size) || (size > fsize)) {
 		return (1);
 	}
 
-	if (fread (sim->mem + 16UL * sim->psp + 256, 1, imgsize, fp) != imgsize) {
-		return (1);
-	}
+	memcpy (sim->mem + 16UL * sim->psp + 256, img + imgbase, imgsize);
 
 	if (reloccnt > 0) {
-		if (sim_reloc_exe (sim, fp, sim->psp + 16, para, relocofs, reloccnt)) {
+		if (sim_reloc_exe (sim, img, fsize, sim->psp + 16, para, relocofs, reloccnt)) {
 			return (1);
 		}
 	}
@@ -154,19 +180,10 @@ int sim_exec_exe (dos_t *sim, FILE *fp)
 }
 
 static
-int sim_exec_com (dos_t *sim, FILE *fp)
+int sim_exec_com (dos_t *sim, const unsigned char *img, unsigned long size)
 {
-	unsigned long  size;
 	unsigned short sp;
 
-	if (fseek (fp, 0, SEEK_END)) {
-		return (1);
-	}
-
-	size = ftell (fp);
-
-	rewind (fp);
-
 	if (size > (65536 - 512)) {
 		return (1);
 	}
@@ -177,9 +194,7 @@ int sim_exec_com (dos_t *sim, FILE *fp)
 		return (1);
 	}
 
-	if (fread (sim->mem + 16UL * sim->psp + 256, 1, size, fp) != size) {
-		return (1);
-	}
+	memcpy (sim->mem + 16UL * sim->psp + 256, img, size);
 
 	sp = sim_mem_get_size (sim, sim->psp);
 	sp = (sp < 0x1000) ? (sp << 4) : 0;
@@ -197,23 +212,148 @@ int sim_exec_com (dos_t *sim, FILE *fp)
 	return (0);
 }
 
-int sim_exec (dos_t *sim, const char *name)
+static
+unsigned char *sim_exec_read (const char *name, unsigned long size)
 {
-	int           r;
-	unsigned      magic;
 	FILE          *fp;
-	unsigned char buf[16];
+	unsigned char *buf;
+
+	if ((buf = malloc (size + 1)) == NULL) {
+		return (NULL);
+	}
 
 	if ((fp = fopen (name, "rb")) == NULL) {
-		return (1);
+		free (buf);
+		return (NULL);
 	}
 
-	if (fread (buf, 1, 16, fp) != 16) {
+	if (fread (buf, 1, size, fp) != size) {
 		fclose (fp);
-		return (1);
+		free (buf);
+		return (NULL);
 	}
 
-	rewind (fp);
+	fclose (fp);
+
+	return (buf);
+}
+
+static
+void sim_exec_cache_del (exec_cache_t *ce)
+{
+	free (ce->data);
+	free (ce->name);
+	free (ce);
+}
+
+/*
+ * Get the contents of a host file, from the cache if it has not
+ * changed since it was cached. Returns NULL if the file can't be
+ * cached.
+ */
+static
+const unsigned char *sim_exec_cache_get (const char *name, unsigned long *size)
+{
+	struct stat  st;
+	exec_cache_t *ce, **prv;
+
+	if (stat (name, &st)) {
+		return (NULL);
+	}
+
+	if ((time (NULL) - st.st_mtime) < EXEC_CACHE_AGE) {
+		return (NULL);
+	}
+
+	prv = &par_cache;
+
+	while ((ce = *prv) != NULL) {
+		if (strcmp (ce->name, name) == 0) {
+			if ((ce->size == st.st_size) && (ce->ino == st.st_ino) && (ce->mtime == st.st_mtime)) {
+				*size = ce->size;
+				return (ce->data);
+			}
+
+			*prv = ce->next;
+			sim_exec_cache_del (ce);
+
+			break;
+		}
+
+		prv = &ce->next;
+	}
+
+	if ((ce = malloc (sizeof (exec_cache_t))) == NULL) {
+		return (NULL);
+	}
+
+	if ((ce->name = malloc (strlen (name) + 1)) == NULL) {
+		free (ce);
+		return (NULL);
+	}
+
+	strcpy (ce->name, name);
+
+	ce->size = st.st_size;
+	ce->ino = st.st_ino;
+	ce->mtime = st.st_mtime;
+
+	if ((ce->data = sim_exec_read (name, ce->size)) == NULL) {
+		free (ce->name);
+		free (ce);
+		return (NULL);
+	}
+
+	ce->next = par_cache;
+	par_cache = ce;
+
+	*size = ce->size;
+
+	return (ce->data);
+}
+
+void sim_exec_cache (int enable)
+{
+	exec_cache_t *ce;
+
+	par_cache_enabled = (enable != 0);
+
+	if (par_cache_enabled) {
+		return;
+	}
+
+	while (par_cache != NULL) {
+		ce = par_cache;
+		par_cache = ce->next;
+		sim_exec_cache_del (ce);
+	}
+}
+
+int sim_exec (dos_t *sim, const char *name)
+{
+	int                 r;
+	unsigned            magic;
+	unsigned long       size;
+	struct stat         st;
+	unsigned char       *tmp;
+	const unsigned char *buf;
+
+	buf = NULL;
+	tmp = NULL;
+
+	if (par_cache_enabled) {
+		buf = sim_exec_cache_get (name, &size);
+	}
+
+	if ((buf == NULL) && (stat (name, &st) == 0)) {
+		size = st.st_size;
+		buf = tmp = sim_exec_read (name, size);
+	}
+
+	if ((buf == NULL) || (size < 16)) {
+		free (tmp);
+		return (1);
+	}
 
 	e86_set_ax (&sim->cpu, 0);
 	e86_set_bx (&sim->cpu, 0);
@@ -226,13 +366,13 @@ int sim_exec (dos_t *sim, const char *name)
 	magic = get_uint16_le (buf, 0);
 
 	if ((magic == 0x5a4d) || (magic == 0x4d5a)) {
-		r = sim_exec_exe (sim, fp);
+		r = sim_exec_exe (sim, buf, size);
 	}
 	else {
-		r = sim_exec_com (sim, fp);
+		r = sim_exec_com (sim, buf, size);
 	}
 
-	fclose (fp);
+	free (tmp);
 
 	if (r) {
 		return (1);
@@ -27,6 +27,15 @@
 #include "dos.h"
 
 
+/*!***************************************************************************
+ * @short Enable or disable the program cache
+ *
+ * If the cache is enabled, program files are kept in memory after they
+ * are loaded and are only read again if their size or modification
+ * time changes. Disabling the cache frees all cached files.
+ *****************************************************************************/
+void sim_exec_cache (int enable);
+
 int sim_exec (dos_t *sim, const char *name);
 
 
@@ -161,6 +161,6 @@ void sim_int (dos_t *sim, unsigned char val)
 	if (ret) {
 		sim_print_state_cpu (sim, stderr);
 		fprintf (stderr, "unknown int: %02X / %04X\n", val, e86_get_ax (&sim->cpu));
-		exit (1);
+		sim_exit (sim, 1);
 	}
 }
@@ -27,6 +27,7 @@
 #include "path.h"
 
 #include <ctype.h>
+#include <dirent.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -60,14 +61,95 @@ FILE *int21_get_fp (dos_t *sim, unsigned fd)
 	return (sim->file[fd]);
 }
 
+/*
+ * Invalidate the cached directory listing. This must be called whenever
+ * a file is created, deleted or renamed.
+ */
 static
-void int21_find_done (dos_t *sim)
+void int21_dir_flush (dos_t *sim)
+{
+	sim->dir_valid = 0;
+}
+
+/*
+ * Read a directory listing into the cache, unless the cached listing
+ * is still valid.
+ */
+static
+int int21_dir_load (dos_t *sim, const char *dir)
 {
-	if (sim->search_dir != NULL) {
-		closedir (sim->search_dir);
-		sim->search_dir = NULL;
+	unsigned      i, max;
+	char          **tmp;
+	DIR           *dp;
+	struct dirent *ent;
+	struct stat   st;
+
+	if (stat (dir, &st)) {
+		return (1);
+	}
+
+	if (sim->dir_valid && (sim->dir_mtime == st.st_mtime)) {
+		if (strcmp (sim->dir_name, dir) == 0) {
+			return (0);
+		}
+	}
+
+	for (i = 0; i < sim->dir_cnt; i++) {
+		free (sim->dir_ent[i]);
+	}
+
+	free (sim->dir_name);
+
+	sim->dir_valid = 0;
+	sim->dir_cnt = 0;
+
+	if ((sim->dir_name = malloc (strlen (dir) + 1)) == NULL) {
+		return (1);
+	}
+
+	strcpy (sim->dir_name, dir);
+
+	if ((dp = opendir (dir)) == NULL) {
+		return (1);
 	}
 
+	max = 0;
+
+	while ((ent = readdir (dp)) != NULL) {
+		if (sim->dir_cnt >= max) {
+			max = (max < 64) ? 64 : (2 * max);
+
+			if ((tmp = realloc (sim->dir_ent, max * sizeof (char *))) == NULL) {
+				break;
+			}
+
+			sim->dir_ent = tmp;
+		}
+
+		if ((sim->dir_ent[sim->dir_cnt] = malloc (strlen (ent->d_name) + 1)) == NULL) {
+			break;
+		}
+
+		strcpy (sim->dir_ent[sim->dir_cnt], ent->d_name);
+
+		sim->dir_cnt += 1;
+	}
+
+	closedir (dp);
+
+	if (ent != NULL) {
+		return (1);
+	}
+
+	sim->dir_valid = 1;
+	sim->dir_mtime = st.st_mtime;
+
+	return (0);
+}
+
+static
+void int21_find_done (dos_t *sim)
+{
 	if (sim->search_dir_name != NULL) {
 		free (sim->search_dir_name);
 		sim->search_dir_name = NULL;
@@ -89,10 +171,13 @@ int int21_find_start (dos_t *sim, char *name, unsigned attr)
 		return (1);
 	}
 
-	if ((sim->search_dir = opendir (sim->search_dir_name)) == NULL) {
+	if (int21_dir_load (sim, sim->search_dir_name)) {
+		int21_find_done (sim);
 		return (1);
 	}
 
+	sim->search_idx = 0;
+
 	return (0);
 }
 
@@ -146,20 +231,31 @@ int int21_find_cont (dos_t *sim)
 	unsigned short date, time;
 	unsigned char  attr;
 	char           *str;
+	const char     *name;
 	struct stat    st;
-	struct dirent  *ent;
 
-	if ((sim->search_dir == NULL) || (sim->search_dir_name == NULL)) {
+	if (sim->search_dir_name == NULL) {
 		return (1);
 	}
 
-	while ((ent = readdir (sim->search_dir)) != NULL) {
-		if ((str = sim_make_path (sim->search_dir_name, ent->d_name)) == NULL) {
+	name = NULL;
+
+	while (sim->search_idx < sim->dir_cnt) {
+		name = sim->dir_ent[sim->search_idx++];
+
+		if (int21_find_match (sim, name) == 0) {
+			name = NULL;
+			continue;
+		}
+
+		if ((str = sim_make_path (sim->search_dir_name, name)) == NULL) {
+			name = NULL;
 			continue;
 		}
 
 		if (stat (str, &st)) {
 			free (str);
+			name = NULL;
 			continue;
 		}
 
@@ -173,15 +269,14 @@ int int21_find_cont (dos_t *sim)
 		}
 
 		if (attr & ~sim->search_attr & ~0x20) {
+			name = NULL;
 			continue;
 		}
 
-		if (int21_find_match (sim, ent->d_name)) {
-			break;
-		}
+		break;
 	}
 
-	if (ent == NULL) {
+	if (name == NULL) {
 		int21_find_done (sim);
 		return (1);
 	}
@@ -198,7 +293,7 @@ int int21_find_cont (dos_t *sim)
 	sim_set_uint16 (sim, seg, ofs + 28, (st.st_size >> 16) & 0xffff);
 
 	for (i = 0; i < 12; i++) {
-		c = toupper (ent->d_name[i]);
+		c = toupper (name[i]);
 
 		sim_set_uint8 (sim, seg, ofs + 30 + i, c);
 
@@ -227,7 +322,9 @@ int int21_ret (dos_t *sim, int cf, unsigned ax)
 static
 int int21_fct_00 (dos_t *sim)
 {
-	exit (0);
+	sim_exit (sim, 0);
+
+	return (0);
 }
 
 /*
@@ -687,6 +784,7 @@ int int21_fct_3c (dos_t *sim)
 	}
 	else {
 		sim->file[fd] = fopen (name, "w+b");
+		int21_dir_flush (sim);
 	}
 
 	if (sim->file[fd] == NULL) {
@@ -794,6 +892,99 @@ int int21_fct_3e (dos_t *sim)
 	return (0);
 }
 
+/*
+ * Read cnt bytes from a file into memory at seg:ofs. The offset wraps
+ * around at the end of the segment.
+ */
+static
+unsigned int21_read_block (dos_t *sim, FILE *fp, unsigned short seg, unsigned short ofs, unsigned cnt)
+{
+	int           c;
+	unsigned      i, n, r;
+	unsigned long addr;
+
+	i = 0;
+
+	while (i < cnt) {
+		n = 0x10000 - ofs;
+
+		if (n > (cnt - i)) {
+			n = cnt - i;
+		}
+
+		addr = ((unsigned long) seg << 4) + ofs;
+
+		if ((addr + n) > sim->mem_cnt) {
+			if ((c = fgetc (fp)) == EOF) {
+				break;
+			}
+
+			sim_set_uint8 (sim, seg, ofs, c);
+
+			i += 1;
+			ofs = (ofs + 1) & 0xffff;
+
+			continue;
+		}
+
+		r = fread (sim->mem + addr, 1, n, fp);
+
+		i += r;
+		ofs = (ofs + r) & 0xffff;
+
+		if (r < n) {
+			break;
+		}
+	}
+
+	return (i);
+}
+
+/*
+ * Write cnt bytes from memory at seg:ofs to a file. The offset wraps
+ * around at the end of the segment.
+ */
+static
+unsigned int21_write_block (dos_t *sim, FILE *fp, unsigned short seg, unsigned short ofs, unsigned cnt)
+{
+	unsigned      i, n, r;
+	unsigned long addr;
+
+	i = 0;
+
+	while (i < cnt) {
+		n = 0x10000 - ofs;
+
+		if (n > (cnt - i)) {
+			n = cnt - i;
+		}
+
+		addr = ((unsigned long) seg << 4) + ofs;
+
+		if ((addr + n) > sim->mem_cnt) {
+			if (fputc (sim_get_uint8 (sim, seg, ofs), fp) == EOF) {
+				break;
+			}
+
+			i += 1;
+			ofs = (ofs + 1) & 0xffff;
+
+			continue;
+		}
+
+		r = fwrite (sim->mem + addr, 1, n, fp);
+
+		i += r;
+		ofs = (ofs + r) & 0xffff;
+
+		if (r < n) {
+			break;
+		}
+	}
+
+	return (i);
+}
+
 /*
  * 3F: Read
  */
@@ -816,6 +1007,10 @@ int int21_fct_3f (dos_t *sim)
 	seg = e86_get_ds (&sim->cpu);
 	ofs = e86_get_dx (&sim->cpu);
 
+	if (tty == 0) {
+		return (int21_ret (sim, 0, int21_read_block (sim, fp, seg, ofs, cnt)));
+	}
+
 	lf = 0;
 
 	for (i = 0; i < cnt; i++) {
@@ -854,7 +1049,6 @@ int int21_fct_3f (dos_t *sim)
 static
 int int21_fct_40 (dos_t *sim)
 {
-	int            c;
 	unsigned       i, cnt;
 	unsigned short seg, ofs;
 	FILE           *fp;
@@ -871,11 +1065,7 @@ int int21_fct_40 (dos_t *sim)
 		ftruncate (fileno (fp), ftell (fp));
 	}
 
-	for (i = 0; i < cnt; i++) {
-		c = sim_get_uint8 (sim, seg, ofs);
-		fputc (c, fp);
-		ofs = (ofs + 1) & 0xfffff;
-	}
+	i = int21_write_block (sim, fp, seg, ofs, cnt);
 
 	fflush (fp);
 
@@ -905,6 +1095,8 @@ int int21_fct_41 (dos_t *sim)
 		return (int21_ret (sim, 1, 0x0001));
 	}
 
+	int21_dir_flush (sim);
+
 	if (remove (name)) {
 		free (name);
 		return (int21_ret (sim, 1, 0x0002));
@@ -1224,7 +1416,9 @@ int int21_fct_4a (dos_t *sim)
 static
 int int21_fct_4c (dos_t *sim)
 {
-	exit (e86_get_al (&sim->cpu));
+	sim_exit (sim, e86_get_al (&sim->cpu));
+
+	return (0);
 }
 
 /*
@@ -1271,7 +1465,7 @@ int int21_fct_4e (dos_t *sim)
 static
 int int21_fct_4f (dos_t *sim)
 {
-	if (sim->search_dir == NULL) {
+	if (sim->search_dir_name == NULL) {
 		return (int21_ret (sim, 1, 0x0001));
 	}
 
@@ -1338,6 +1532,8 @@ int int21_fct_56 (dos_t *sim)
 		return (int21_ret (sim, 1, 0x0001));
 	}
 
+	int21_dir_flush (sim);
+
 	if (rename (src, dst)) {
 		int21_ret (sim, 1, 0x0001);
 	}
@@ -1503,6 +1699,7 @@ int int21_fct_5b (dos_t *sim)
 		}
 		else {
 			sim->file[fd] = fopen (name, "w+b");
+			int21_dir_flush (sim);
 		}
 	}
 
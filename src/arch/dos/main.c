@@ -37,6 +37,7 @@
 
 static pce_option_t opts[] = {
 	{ '?', 0, "help", NULL, "Print usage information" },
+	{ 'b', 1, "batch", "file", "Run the commands in a file" },
 	{ 'c', 0, "command", NULL, "Set the DOS command" },
 	{ 'd', 2, "drive", "char string", "Attach a host path to a DOS drive" },
 	{ 'e', 1, "setenv", "string", "Add a string to the environment" },
@@ -51,6 +52,9 @@ const char *arg0 = NULL;
 
 static const char *par_drives[26];
 
+static unsigned    par_mem = 640;
+static char        par_log_int = 0;
+
 static unsigned      par_env_cnt = 0;
 static unsigned char *par_env = NULL;
 
@@ -158,25 +162,211 @@ int env_add (const char *str)
 	return (0);
 }
 
-int main (int argc, char **argv)
+/*
+ * Run a DOS program and return its exit code, or -1 if it could
+ * not be started.
+ */
+static
+int run_program (char **argv)
 {
 	int      r;
 	unsigned i;
-	char     **optarg;
 	char     *prog_dos, *prog_host;
-	char     log_int;
-	unsigned mem;
 	dos_t    sim;
 
+	if (sim_init (&sim, par_mem)) {
+		return (-1);
+	}
+
+	sim.log_int = par_log_int;
+
+	for (i = 0; i < 26; i++) {
+		if (par_drives[i] != NULL) {
+			if (sim_set_drive (&sim, i, par_drives[i])) {
+				sim_free (&sim);
+				return (-1);
+			}
+		}
+	}
+
+	if ((prog_dos = sim_get_dos_full_name (&sim, argv[0])) == NULL) {
+		sim_free (&sim);
+		return (-1);
+	}
+
+	if ((prog_host = sim_get_host_name (&sim, prog_dos)) == NULL) {
+		free (prog_dos);
+		sim_free (&sim);
+		return (-1);
+	}
+
+	r = -1;
+
+	if (sim_init_env (&sim, prog_dos, par_env, par_env_cnt)) {
+		;
+	}
+	else if (sim_exec (&sim, prog_host)) {
+		fprintf (stderr, "%s: loading exe file failed (%s)\n", arg0, argv[0]);
+	}
+	else if (sim_init_args (&sim, (const char **) argv + 1)) {
+		fprintf (stderr, "%s: argument list too long\n", arg0);
+	}
+	else {
+		r = sim_run (&sim);
+	}
+
+	free (prog_host);
+	free (prog_dos);
+
+	sim_free (&sim);
+
+	return (r);
+}
+
+/*
+ * Split a command line into words. Returns the number of words.
+ */
+static
+unsigned split_args (char *str, char **argv, unsigned max)
+{
+	unsigned n;
+
+	n = 0;
+
+	while (n < max) {
+		while ((*str == ' ') || (*str == '\t')) {
+			str += 1;
+		}
+
+		if ((*str == 0) || (*str == '\n') || (*str == '\r')) {
+			break;
+		}
+
+		argv[n++] = str;
+
+		while ((*str != 0) && (*str != ' ') && (*str != '\t')) {
+			if ((*str == '\n') || (*str == '\r')) {
+				*str = 0;
+				break;
+			}
+
+			str += 1;
+		}
+
+		if (*str == 0) {
+			break;
+		}
+
+		*(str++) = 0;
+	}
+
+	argv[n] = NULL;
+
+	return (n);
+}
+
+/*
+ * Run each line of a file as a DOS command line and report the
+ * exit code and run time of each command.
+ */
+static
+int run_batch (const char *fname)
+{
+	unsigned      line, jobs, failed;
+	int           r;
+	unsigned long clk, us, total;
+	FILE          *fp;
+	char          *argv[128];
+	char          str[1024], cmd[1024];
+
+	/* stdin is the standard input of the DOS programs */
+	if (strcmp (fname, "-") == 0) {
+		fprintf (stderr, "%s: can't read the batch file from stdin\n", arg0);
+		return (1);
+	}
+
+	if ((fp = fopen (fname, "r")) == NULL) {
+		fprintf (stderr, "%s: can't open batch file (%s)\n", arg0, fname);
+		return (1);
+	}
+
+	sim_exec_cache (1);
+
+	line = 0;
+	jobs = 0;
+	failed = 0;
+	total = 0;
+
+	while (fgets (str, sizeof (str), fp) != NULL) {
+		line += 1;
+
+		strcpy (cmd, str);
+		cmd[strcspn (cmd, "\r\n")] = 0;
+
+		if (split_args (str, argv, 127) == 0) {
+			continue;
+		}
+
+		if (argv[0][0] == '#') {
+			continue;
+		}
+
+		pce_get_interval_us (&clk);
+
+		r = run_program (argv);
+
+		us = pce_get_interval_us (&clk);
+
+		jobs += 1;
+		total += us;
+
+		if (r != 0) {
+			failed += 1;
+		}
+
+		if (r < 0) {
+			fprintf (stderr, "%s: %u: error %lu.%03lus: %s\n",
+				arg0, line, us / 1000000, (us / 1000) % 1000, cmd
+			);
+		}
+		else {
+			fprintf (stderr, "%s: %u: exit %d %lu.%03lus: %s\n",
+				arg0, line, r, us / 1000000, (us / 1000) % 1000, cmd
+			);
+		}
+
+		fflush (stderr);
+	}
+
+	sim_exec_cache (0);
+
+	fclose (fp);
+
+	fprintf (stderr, "%s: %u jobs, %u failed, %lu.%03lus\n",
+		arg0, jobs, failed, total / 1000000, (total / 1000) % 1000
+	);
+
+	return (failed > 0);
+}
+
+int main (int argc, char **argv)
+{
+	int        r;
+	char       **optarg;
+	const char *batch;
+
 	arg0 = argv[0];
 
-	mem = 640;
-	log_int = 0;
+	batch = NULL;
 
 	while (1) {
 		r = pce_getopt (argc, argv, &optarg, opts);
 
 		if (r == GETOPT_DONE) {
+			if (batch != NULL) {
+				break;
+			}
+
 			return (1);
 		}
 
@@ -193,6 +383,10 @@ int main (int argc, char **argv)
 			print_help();
 			return (0);
 
+		case 'b':
+			batch = optarg[0];
+			break;
+
 		case 'V':
 			print_version();
 			return (0);
@@ -210,11 +404,11 @@ int main (int argc, char **argv)
 			break;
 
 		case 'l':
-			log_int = 1;
+			par_log_int = 1;
 			break;
 
 		case 'm':
-			mem = strtoul (optarg[0], NULL, 0);
+			par_mem = strtoul (optarg[0], NULL, 0);
 			break;
 
 		default:
@@ -226,51 +420,17 @@ int main (int argc, char **argv)
 	signal (SIGTERM, sig_term);
 	signal (SIGSEGV, sig_segv);
 
-	if (sim_init (&sim, mem)) {
-		return (1);
-	}
-
-	sim.log_int = log_int || 0;
-
-	for (i = 0; i < 26; i++) {
-		if (par_drives[i] != NULL) {
-			if (sim_set_drive (&sim, i, par_drives[i])) {
-				return (1);
-			}
-		}
-	}
-
-	if ((prog_dos = sim_get_dos_full_name (&sim, optarg[0])) == NULL) {
-		return (1);
-	}
-
-	if ((prog_host = sim_get_host_name (&sim, prog_dos)) == NULL) {
-		return (1);
-	}
-
 	if (par_env_cnt == 0) {
 		if (env_add ("PATH=C:\\")) {
 			return (1);
 		}
 	}
 
-	if (sim_init_env (&sim, prog_dos, par_env, par_env_cnt)) {
-		return (1);
+	if (batch != NULL) {
+		return (run_batch (batch));
 	}
 
-	if (sim_exec (&sim, prog_host)) {
-		fprintf (stderr, "%s: loading exe file failed (%s)\n", arg0, optarg[0]);
-		return (1);
-	}
+	r = run_program (optarg);
 
-	if (sim_init_args (&sim, (const char **) optarg + 1)) {
-		fprintf (stderr, "%s: argument list too long\n", arg0);
-		return (1);
-	}
-
-	sim_run (&sim);
-
-	sim_free (&sim);
-
-	return (0);
+	return ((r < 0) ? 1 : r);
 }
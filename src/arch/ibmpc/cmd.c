@@ -29,15 +29,19 @@
 #include <lib/brkpt.h>
 #include <lib/cmd.h>
 #include <lib/console.h>
+#include <lib/cover.h>
 #include <lib/log.h>
 #include <lib/monitor.h>
 #include <lib/msgdsk.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
 static mon_cmd_t par_cmd[] = {
 	{ "boot", "[drive]", "set the boot drive" },
 	{ "c", "[cnt]", "clock [1]" },
+	{ "cover", "[on|off|clear|list|save fname]", "control guest code coverage" },
 	{ "gb", "[addr...]", "run with breakpoints" },
 	{ "g", "far", "run until CS changes" },
 	{ "g", "", "run" },
@@ -49,8 +53,12 @@ static mon_cmd_t par_cmd[] = {
 	{ "o", "[b|w] port val", "output a byte or word to a port" },
 	{ "pq", "[c|f|s]", "prefetch queue clear/fill/status" },
 	{ "p", "[cnt]", "execute cnt instructions, without trace in calls [1]" },
+	{ "prof", "[on|off|clear|stack on|off]", "control the profiler" },
+	{ "prof", "[flat [cnt]|folded|save fname]", "print or save the profile" },
 	{ "r", "[reg val]", "set a register" },
 	{ "s", "[what]", "print status (pc|cpu|disks|ems|mem|pic|pit|ports|ppi|time|uart|video|xms)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "trace", "on|off|expr", "turn trace on or off" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
 	{ "u", "[addr [cnt [mode]]]", "disassemble" }
@@ -547,7 +555,6 @@ void pc_run (ibmpc_t *pc)
 	pce_stop();
 }
 
-#if 0
 static
 void pce_op_stat (void *ext, unsigned char op1, unsigned char op2)
 {
@@ -555,8 +562,30 @@ void pce_op_stat (void *ext, unsigned char op1, unsigned char op2)
 
 	pc = (ibmpc_t *) ext;
 
+	if (pc->cover.enabled) {
+		cover_add (&pc->cover,
+			e86_get_linear (e86_get_cs (pc->cpu), e86_get_ip (pc->cpu))
+		);
+	}
+
+	if (pc->prof.enabled && pc->prof.stack) {
+		prof_op_e86 (&pc->prof,
+			e86_get_linear (e86_get_cs (pc->cpu), e86_get_ip (pc->cpu)),
+			op1, op2
+		);
+	}
+}
+
+void pc_prof_update (ibmpc_t *pc)
+{
+	if ((pc->prof.enabled && pc->prof.stack) || pc->cover.enabled) {
+		pc->cpu->op_stat = pce_op_stat;
+	}
+	else {
+		pc->cpu->op_stat = NULL;
+		pc->prof.call = 0;
+	}
 }
-#endif
 
 /*
  * Force floppy disk drive types to 40 tracks in the BIOS data area of
@@ -845,6 +874,8 @@ void pc_cmd_hm (cmd_t *cmd)
 		"emu.term.title       <title>\n"
 		"\n"
 		"emu.video.blink      <blink-rate>\n"
+		"emu.video.fps        <max-fps>\n"
+		"emu.video.frameskip  <max-skip>\n"
 		"emu.video.redraw     [\"now\"]\n"
 		"\n"
 	);
@@ -1412,6 +1443,10 @@ int pc_cmd (ibmpc_t *pc, cmd_t *cmd)
 	else if (cmd_match (cmd, "b")) {
 		cmd_do_b (cmd, &pc->bps);
 	}
+	else if (cmd_match (cmd, "cover")) {
+		cover_cmd (cmd, &pc->cover);
+		pc_prof_update (pc);
+	}
 	else if (cmd_match (cmd, "c")) {
 		pc_cmd_c (cmd, pc);
 	}
@@ -1433,6 +1468,10 @@ int pc_cmd (ibmpc_t *pc, cmd_t *cmd)
 	else if (cmd_match (cmd, "o")) {
 		pc_cmd_o (cmd, pc);
 	}
+	else if (cmd_match (cmd, "prof")) {
+		prof_cmd (cmd, &pc->prof);
+		pc_prof_update (pc);
+	}
 	else if (cmd_match (cmd, "pq")) {
 		pc_cmd_pq (cmd, pc);
 	}
@@ -1442,6 +1481,9 @@ int pc_cmd (ibmpc_t *pc, cmd_t *cmd)
 	else if (cmd_match (cmd, "r")) {
 		pc_cmd_r (cmd, pc);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		pc_cmd_s (cmd, pc);
 	}
@@ -1468,8 +1510,6 @@ void pc_cmd_init (ibmpc_t *pc, monitor_t *mon)
 
 	pc->cpu->op_int = &pce_op_int;
 	pc->cpu->op_undef = &pce_op_undef;
-#if 0
-	pc->cpu->op_stat = pce_op_stat;
-#endif
 
+	pc_prof_update (pc);
 }
@@ -38,6 +38,8 @@ void pc_run (ibmpc_t *pc);
 
 int pc_cmd (ibmpc_t *pc, cmd_t *cmd);
 
+void pc_prof_update (ibmpc_t *pc);
+
 void pc_cmd_init (ibmpc_t *pc, monitor_t *mon);
 
 
@@ -40,6 +40,7 @@
 #include <lib/initerm.h>
 #include <lib/load.h>
 #include <lib/log.h>
+#include <lib/stats.h>
 #include <lib/string.h>
 #include <lib/sysdep.h>
 
@@ -206,6 +207,18 @@ unsigned char pc_dma3_get_mem8 (ibmpc_t *pc, unsigned long addr)
 	return (mem_get_uint8 (pc->mem, pc->dma_page[3] + addr));
 }
 
+static
+void pc_dma3_set_mem_buf (ibmpc_t *pc, unsigned long addr, const void *buf, unsigned cnt)
+{
+	mem_write_buf (pc->mem, pc->dma_page[3] + addr, buf, cnt);
+}
+
+static
+void pc_dma3_get_mem_buf (ibmpc_t *pc, unsigned long addr, void *buf, unsigned cnt)
+{
+	mem_read_buf (pc->mem, pc->dma_page[3] + addr, buf, cnt);
+}
+
 
 static
 unsigned char pc_ppi_get_port_a (ibmpc_t *pc)
@@ -672,6 +685,11 @@ void pc_setup_cpu (ibmpc_t *pc, ini_sct_t *ini)
 		(e86_set_uint16_f) &mem_set_uint16_le
 	);
 
+	e86_set_mem_buf_fct (pc->cpu,
+		(e86_get_buf_f) &mem_read_buf,
+		(e86_set_buf_f) &mem_write_buf
+	);
+
 	e86_set_prt (pc->cpu, pc->prt,
 		(e86_get_uint8_f) &mem_get_uint8,
 		(e86_set_uint8_f) &mem_set_uint8,
@@ -1218,6 +1236,7 @@ int pc_setup_vga (ibmpc_t *pc, ini_sct_t *sct)
 static
 void pc_setup_video (ibmpc_t *pc, ini_sct_t *ini)
 {
+	unsigned   fps, skip, hz;
 	const char *dev;
 	ini_sct_t  *sct;
 
@@ -1272,6 +1291,25 @@ void pc_setup_video (ibmpc_t *pc, ini_sct_t *ini)
 	}
 
 	if (pc->video != NULL) {
+		if ((strcmp (dev, "mda") == 0) || (strcmp (dev, "hgc") == 0)) {
+			hz = 50;
+		}
+		else if (strcmp (dev, "vga") == 0) {
+			hz = 70;
+		}
+		else {
+			hz = 60;
+		}
+
+		ini_get_uint16 (sct, "max_fps", &fps, 0);
+		ini_get_uint16 (sct, "frame_skip", &skip, 0);
+
+		pce_log_tag (MSG_INF, "VIDEO:", "max_fps=%u frame_skip=%u\n",
+			fps, skip
+		);
+
+		pce_frame_set_params (&pc->video->frame, fps, skip, hz);
+
 		ini_get_ram (pc->mem, sct, &pc->ram);
 		ini_get_rom (pc->mem, sct);
 		pce_load_mem_ini (pc->mem, sct);
@@ -1449,6 +1487,11 @@ void pc_setup_hdc (ibmpc_t *pc, ini_sct_t *ini)
 
 	pc->dma.chn[3].memwr_ext = pc;
 	pc->dma.chn[3].memwr = (void *) pc_dma3_set_mem8;
+
+	pc->dma.chn[3].iord_buf = (void *) hdc_read_buf;
+	pc->dma.chn[3].iowr_buf = (void *) hdc_write_buf;
+	pc->dma.chn[3].memrd_buf = (void *) pc_dma3_get_mem_buf;
+	pc->dma.chn[3].memwr_buf = (void *) pc_dma3_set_mem_buf;
 }
 
 static
@@ -1651,6 +1694,37 @@ void pc_setup_xms (ibmpc_t *pc, ini_sct_t *ini)
 	}
 }
 
+static
+void pc_stats_update (void *ext)
+{
+	unsigned i;
+	char     name[16];
+	ibmpc_t  *pc;
+
+	pc = ext;
+
+	pce_stats_set_sim (e86_get_opcnt (pc->cpu), pc->clock2, PCE_IBMPC_CLK2);
+	pce_stats_set_disks (pc->dsk);
+	pce_stats_set_trm (pc->trm);
+	pce_stats_set_snd ("speaker", pc->spk.drv);
+
+	if (pc->cov != NULL) {
+		pce_stats_set_snd ("covox", pc->cov->drv);
+	}
+
+	for (i = 0; i < 4; i++) {
+		if (pc->serport[i] != NULL) {
+			sprintf (name, "ser%u", i);
+			pce_stats_set_chr (name, pc->serport[i]->cdrv);
+		}
+
+		if (pc->parport[i] != NULL) {
+			sprintf (name, "par%u", i);
+			pce_stats_set_chr (name, pc->parport[i]->cdrv);
+		}
+	}
+}
+
 ibmpc_t *pc_new (ini_sct_t *ini)
 {
 	ibmpc_t *pc;
@@ -1668,6 +1742,10 @@ ibmpc_t *pc_new (ini_sct_t *ini)
 
 	bps_init (&pc->bps);
 
+	prof_init (&pc->prof);
+
+	cover_init (&pc->cover);
+
 	pc_setup_system (pc, ini);
 	pc_setup_m24 (pc, ini);
 	pc_setup_atari_pc (pc, ini);
@@ -1709,6 +1787,8 @@ ibmpc_t *pc_new (ini_sct_t *ini)
 
 	pc_clock_reset (pc);
 
+	pce_stats_set_update_fct (pc_stats_update, pc);
+
 	return (pc);
 }
 
@@ -1752,7 +1832,11 @@ void pc_del (ibmpc_t *pc)
 		return;
 	}
 
+	pce_stats_set_update_fct (NULL, NULL);
+
 	bps_free (&pc->bps);
+	prof_free (&pc->prof);
+	cover_free (&pc->cover);
 
 	atari_pc_del (pc);
 
@@ -2021,6 +2105,7 @@ void pc_clock_delay (ibmpc_t *pc)
 	unsigned long vclk;
 	unsigned long rclk;
 	unsigned long us;
+	unsigned long snd_cur, snd_tgt;
 
 	vclk = pc->sync_clock2_sim;
 
@@ -2054,6 +2139,15 @@ void pc_clock_delay (ibmpc_t *pc)
 
 	us = (1000000 * (unsigned long long) vclk) / PCE_IBMPC_CLK2;
 
+	if (pc->spk.playing) {
+		if (snd_get_delay (pc->spk.drv, &snd_cur, &snd_tgt) == 0) {
+			if ((2 * snd_cur) < snd_tgt) {
+				/* the sound buffer is running low, sleep less */
+				us /= 2;
+			}
+		}
+	}
+
 	if (us > PCE_IBMPC_SLEEP) {
 		pce_usleep (us);
 	}
@@ -2070,14 +2164,23 @@ void pc_clock (ibmpc_t *pc, unsigned long cnt)
 	}
 
 	if (pc->speed_current == 0) {
-		e86_clock (pc->cpu, cnt + pc->speed_clock_extra);
+		clk = cnt + pc->speed_clock_extra;
 		spd = 4;
 	}
 	else {
-		e86_clock (pc->cpu, cnt);
+		clk = cnt;
 		spd = 4 * pc->speed_current;
 	}
 
+	if (pc->prof.enabled) {
+		prof_add (&pc->prof,
+			e86_get_linear (e86_get_cs (pc->cpu), e86_get_ip (pc->cpu)),
+			clk
+		);
+	}
+
+	e86_clock (pc->cpu, clk);
+
 	pc->clock1 += cnt;
 
 	if (pc->clock1 < spd) {
@@ -2152,6 +2255,7 @@ void pc_clock (ibmpc_t *pc, unsigned long cnt)
 
 			if (pc->clk_div[2] >= 16384) {
 				pc->clk_div[2] &= 16383;
+				pce_stats_check();
 				pc_clock_delay (pc);
 			}
 		}
@@ -55,6 +55,8 @@
 #include <drivers/video/terminal.h>
 
 #include <lib/brkpt.h>
+#include <lib/cover.h>
+#include <lib/prof.h>
 
 #include <libini/libini.h>
 
@@ -104,6 +106,10 @@ typedef struct ibmpc_t {
 
 	bp_set_t           bps;
 
+	prof_t             prof;
+
+	cover_t            cover;
+
 	unsigned           bootdrive;
 	unsigned           disk_id;
 
@@ -123,7 +123,7 @@ void dsk_int13_set_status (disks_t *dsks, e8086_t *cpu, unsigned val)
 static
 void dsk_int13_02 (disks_t *dsks, e8086_t *cpu)
 {
-	unsigned       i, n;
+	unsigned       n;
 	uint32_t       blk_i, blk_n;
 	unsigned       c, h, s;
 	unsigned long  addr;
@@ -161,16 +161,8 @@ void dsk_int13_02 (disks_t *dsks, e8086_t *cpu)
 
 		n *= 512;
 
-		if ((addr + n) <= cpu->ram_cnt) {
-			memcpy (cpu->ram + addr, buf, n);
-			addr += n;
-		}
-		else {
-			for (i = 0; i < n; i++) {
-				e86_set_mem8 (cpu, addr >> 4, addr & 0x0f, buf[i]);
-				addr += 1;
-			}
-		}
+		e86_set_mem_buf (cpu, addr, buf, n);
+		addr += n;
 	}
 
 	dsk_int13_set_status (dsks, cpu, 0x00);
@@ -179,7 +171,7 @@ void dsk_int13_02 (disks_t *dsks, e8086_t *cpu)
 static
 void dsk_int13_03 (disks_t *dsks, e8086_t *cpu)
 {
-	unsigned      i, k, n;
+	unsigned      k, n;
 	uint32_t      blk_i, blk_n;
 	unsigned      c, h, s;
 	unsigned long addr;
@@ -213,16 +205,8 @@ void dsk_int13_03 (disks_t *dsks, e8086_t *cpu)
 		n = (blk_n < INT13_MAX_BLOCKS) ? blk_n : INT13_MAX_BLOCKS;
 		k = 512 * n;
 
-		if ((addr + k) < cpu->ram_cnt) {
-			memcpy (buf, cpu->ram + addr, k);
-			addr += k;
-		}
-		else {
-			for (i = 0; i < k; i++) {
-				buf[i] = e86_get_mem8 (cpu, addr >> 4, addr & 0x0f);
-				addr += 1;
-			}
-		}
+		e86_get_mem_buf (cpu, addr, buf, k);
+		addr += k;
 
 		if (dsk_write_lba (dsk, buf, blk_i, n)) {
 			dsk_int13_set_status (dsks, cpu, 0x01);
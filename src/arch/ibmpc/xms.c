@@ -590,6 +590,50 @@ void inc_addr (unsigned short *seg, unsigned short *ofs, unsigned short val)
 	*ofs &= 0x000f;
 }
 
+/*
+ * Move conventional memory. The per-byte loop is kept for moves that
+ * wrap around at 1M or that would copy bytes that were already written.
+ */
+static
+void xms_move_conv (e8086_t *cpu, unsigned long src, unsigned long dst, unsigned long cnt)
+{
+	unsigned long  i, n;
+	unsigned short seg1, ofs1, seg2, ofs2;
+	unsigned char  buf[4096];
+
+	if (((src + cnt) > 0x100000) || ((dst + cnt) > 0x100000)) {
+		;
+	}
+	else if ((dst > src) && (dst < (src + cnt))) {
+		;
+	}
+	else {
+		while (cnt > 0) {
+			n = (cnt < sizeof (buf)) ? cnt : sizeof (buf);
+
+			e86_get_mem_buf (cpu, src, buf, n);
+			e86_set_mem_buf (cpu, dst, buf, n);
+
+			src += n;
+			dst += n;
+			cnt -= n;
+		}
+
+		return;
+	}
+
+	seg1 = (src >> 4) & 0xffff;
+	ofs1 = src & 0x0f;
+	seg2 = (dst >> 4) & 0xffff;
+	ofs2 = dst & 0x0f;
+
+	for (i = 0; i < cnt; i++) {
+		e86_set_mem8 (cpu, seg2, ofs2, e86_get_mem8 (cpu, seg1, ofs1));
+		inc_addr (&seg1, &ofs1, 1);
+		inc_addr (&seg2, &ofs2, 1);
+	}
+}
+
 /* 0B: move extended memory */
 void xms_0b (xms_t *xms, e8086_t *cpu)
 {
@@ -618,11 +662,9 @@ void xms_0b (xms_t *xms, e8086_t *cpu)
 		seg2 = (dsta >> 16) & 0xffff;
 		ofs2 = dsta & 0xffff;
 
-		for (i = 0; i < cnt; i++) {
-			e86_set_mem8 (cpu, seg2, ofs2, e86_get_mem8 (cpu, seg1, ofs1));
-			inc_addr (&seg1, &ofs1, 1);
-			inc_addr (&seg2, &ofs2, 1);
-		}
+		xms_move_conv (cpu, e86_get_linear (seg1, ofs1),
+			e86_get_linear (seg2, ofs2), cnt
+		);
 	}
 	else if ((srch != 0) && (dsth == 0)) {
 		src = xms_get_emb (xms, srch);
@@ -642,14 +684,22 @@ void xms_0b (xms_t *xms, e8086_t *cpu)
 		if ((srca + cnt) > src->size) {
 			e86_set_ax (cpu, 0x0000);
 			e86_set_bl (cpu, 0xa7);
+			return;
 		}
 
 		seg2 = (dsta >> 16) & 0xffff;
 		ofs2 = dsta & 0xffff;
 
-		for (i = 0; i < cnt; i++) {
-			e86_set_mem8 (cpu, seg2, ofs2, src->data[srca + i]);
-			inc_addr (&seg2, &ofs2, 1);
+		if ((e86_get_linear (seg2, ofs2) + cnt) <= 0x100000) {
+			e86_set_mem_buf (cpu, e86_get_linear (seg2, ofs2),
+				src->data + srca, cnt
+			);
+		}
+		else {
+			for (i = 0; i < cnt; i++) {
+				e86_set_mem8 (cpu, seg2, ofs2, src->data[srca + i]);
+				inc_addr (&seg2, &ofs2, 1);
+			}
 		}
 	}
 	else if ((srch == 0) && (dsth != 0)) {
@@ -676,9 +726,16 @@ void xms_0b (xms_t *xms, e8086_t *cpu)
 		seg1 = (srca >> 16) & 0xffff;
 		ofs1 = srca & 0xffff;
 
-		for (i = 0; i < cnt; i++) {
-			dst->data[dsta + i] = e86_get_mem8 (cpu, seg1, ofs1);
-			inc_addr (&seg1, &ofs1, 1);
+		if ((e86_get_linear (seg1, ofs1) + cnt) <= 0x100000) {
+			e86_get_mem_buf (cpu, e86_get_linear (seg1, ofs1),
+				dst->data + dsta, cnt
+			);
+		}
+		else {
+			for (i = 0; i < cnt; i++) {
+				dst->data[dsta + i] = e86_get_mem8 (cpu, seg1, ofs1);
+				inc_addr (&seg1, &ofs1, 1);
+			}
 		}
 	}
 	else {
@@ -699,6 +756,7 @@ void xms_0b (xms_t *xms, e8086_t *cpu)
 		if ((srca + cnt) > src->size) {
 			e86_set_ax (cpu, 0x0000);
 			e86_set_bl (cpu, 0xa7);
+			return;
 		}
 
 		dst = xms_get_emb (xms, dsth);
@@ -718,9 +776,10 @@ void xms_0b (xms_t *xms, e8086_t *cpu)
 		if ((dsta + cnt) > dst->size) {
 			e86_set_ax (cpu, 0x0000);
 			e86_set_bl (cpu, 0xa7);
+			return;
 		}
 
-		memcpy (dst->data, src->data, cnt);
+		memmove (dst->data + dsta, src->data + srca, cnt);
 	}
 
 	e86_set_ax (cpu, 0x001);
@@ -32,23 +32,31 @@
 #include <lib/brkpt.h>
 #include <lib/cmd.h>
 #include <lib/console.h>
+#include <lib/cover.h>
 #include <lib/log.h>
 #include <lib/msgdsk.h>
 #include <lib/monitor.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
 mon_cmd_t par_cmd[] = {
 	{ "c", "[cnt]", "clock" },
+	{ "cover", "[on|off|clear|list|save fname]", "control guest code coverage" },
 	{ "gb", "[addr..]", "run with breakpoints at addr" },
 	{ "ge", "[exception]", "run until exception" },
 	{ "g", "", "run" },
 	{ "halt", "[val]", "set halt state [2]" },
 	{ "p", "[cnt]", "execute cnt instructions, skip calls [1]" },
+	{ "prof", "[on|off|clear|stack on|off]", "control the profiler" },
+	{ "prof", "[flat [cnt]|folded|save fname]", "print or save the profile" },
 	{ "reset", "", "reset" },
 	{ "rte", "", "execute to next rte" },
 	{ "r", "reg [val]", "get or set a register" },
-	{ "s", "[what]", "print status (cpu|disks|iwm|mem|scc|via)" },
+	{ "s", "[what]", "print status (cpu|disks|iwm|mem|scc|via|video)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
 	{ "u", "[gas] [[-]addr [cnt]]", "disassemble" }
 };
@@ -312,6 +320,21 @@ void mac_print_state_iwm (macplus_t *sim)
 	}
 }
 
+static
+void mac_prt_state_video (macplus_t *sim)
+{
+	pce_prt_sep ("VIDEO");
+
+	if (sim->video == NULL) {
+		return;
+	}
+
+	pce_printf ("RENDERED=%lu  DROPPED=%lu  MAXFPS=%u  SKIP=%u\n",
+		sim->video->frame.rendered, sim->video->frame.dropped,
+		sim->video->frame.max_fps, sim->video->frame.skip_max
+	);
+}
+
 static
 void mac_prt_state_mem (macplus_t *sim)
 {
@@ -348,6 +371,9 @@ void mac_prt_state (macplus_t *sim, const char *str)
 		else if (cmd_match (&cmd, "via")) {
 			mac_prt_state_via (sim);
 		}
+		else if (cmd_match (&cmd, "video")) {
+			mac_prt_state_video (sim);
+		}
 		else {
 			pce_printf ("unknown component (%s)\n", cmd_get_str (&cmd));
 			return;
@@ -441,13 +467,30 @@ void mac_run (macplus_t *sim)
 }
 
 
-#if 0
 static
 void mac_log_opcode (void *ext, unsigned long ir)
 {
 	macplus_t *sim = ext;
+
+	if (sim->cover.enabled) {
+		cover_add (&sim->cover, e68_get_pc (sim->cpu));
+	}
+
+	if (sim->prof.enabled && sim->prof.stack) {
+		prof_op_e68 (&sim->prof, e68_get_pc (sim->cpu), ir);
+	}
+}
+
+void mac_prof_update (macplus_t *sim)
+{
+	if ((sim->prof.enabled && sim->prof.stack) || sim->cover.enabled) {
+		sim->cpu->log_opcode = mac_log_opcode;
+	}
+	else {
+		sim->cpu->log_opcode = NULL;
+		sim->prof.call = 0;
+	}
 }
-#endif
 
 static
 void mac_log_undef (void *ext, unsigned long ir)
@@ -1107,6 +1150,10 @@ int mac_cmd (macplus_t *sim, cmd_t *cmd)
 	if (cmd_match (cmd, "b")) {
 		cmd_do_b (cmd, &sim->bps);
 	}
+	else if (cmd_match (cmd, "cover")) {
+		cover_cmd (cmd, &sim->cover);
+		mac_prof_update (sim);
+	}
 	else if (cmd_match (cmd, "c")) {
 		mac_cmd_c (cmd, sim);
 	}
@@ -1119,6 +1166,10 @@ int mac_cmd (macplus_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "hm")) {
 		mac_cmd_hm (cmd);
 	}
+	else if (cmd_match (cmd, "prof")) {
+		prof_cmd (cmd, &sim->prof);
+		mac_prof_update (sim);
+	}
 	else if (cmd_match (cmd, "p")) {
 		mac_cmd_p (cmd, sim);
 	}
@@ -1131,6 +1182,9 @@ int mac_cmd (macplus_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "r")) {
 		mac_cmd_r (cmd, sim);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		mac_cmd_s (cmd, sim);
 	}
@@ -1161,4 +1215,6 @@ void mac_cmd_init (macplus_t *sim, monitor_t *mon)
 	sim->cpu->log_undef = mac_log_undef;
 	sim->cpu->log_exception = mac_log_exception;
 	sim->cpu->log_mem = mac_log_mem;
+
+	mac_prof_update (sim);
 }
@@ -36,6 +36,8 @@ void mac_run (macplus_t *sim);
 
 int mac_cmd (macplus_t *sim, cmd_t *cmd);
 
+void mac_prof_update (macplus_t *sim);
+
 void mac_cmd_init (macplus_t *sim, monitor_t *mon);
 
 
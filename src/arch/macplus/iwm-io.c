@@ -276,7 +276,15 @@ int iwm_drv_save_disk_psi (mac_iwm_drive_t *drv, disk_t *dsk)
 		return (1);
 	}
 
+	pri_img_clear_dirty (drv->img);
+
 	psi = dsk->ext;
+
+	/* keep the tracks modified since the last commit */
+	if (psi_img_copy_dirty (img, psi->img)) {
+		psi->compact = 1;
+	}
+
 	psi_img_del (psi->img);
 	psi->img = img;
 	psi->dirty = 1;
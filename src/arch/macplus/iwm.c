@@ -1296,6 +1296,7 @@ void mac_iwm_write (mac_iwm_t *iwm, mac_iwm_drive_t *drv)
 
 		drv->track_dirty |= 3;
 		drv->dirty = 1;
+		drv->cur_track->dirty = 1;
 
 		iwm->shift = (iwm->shift << 1) & 0xff;
 		iwm->shift_cnt -= 1;
@@ -55,6 +55,7 @@
 #include <lib/initerm.h>
 #include <lib/load.h>
 #include <lib/log.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 #include <libini/libini.h>
@@ -1097,8 +1098,11 @@ void mac_setup_scsi (macplus_t *sim, ini_sct_t *ini)
 	mem_blk_t     *blk;
 	unsigned long addr, size;
 	unsigned      id, drive, ethernet;
+	int           fast_dma;
 	const char    *vendor, *product, *mac_addr, *tap_dev, *tap_cmd, *bridge_if;
 
+	mac_scsi_init (&sim->scsi);
+
 	sct = ini_next_sct (ini, NULL, "scsi");
 
 	if (sct == NULL) {
@@ -1107,10 +1111,13 @@ void mac_setup_scsi (macplus_t *sim, ini_sct_t *ini)
 
 	ini_get_uint32 (sct, "address", &addr, 0x580000);
 	ini_get_uint32 (sct, "size", &size, 0x80000);
+	ini_get_bool (sct, "fast_dma", &fast_dma, 0);
 
-	pce_log_tag (MSG_INF, "SCSI:", "addr=0x%06lx size=0x%lx\n", addr, size);
+	pce_log_tag (MSG_INF, "SCSI:", "addr=0x%06lx size=0x%lx fast_dma=%d\n",
+		addr, size, fast_dma
+	);
 
-	mac_scsi_init (&sim->scsi);
+	sim->scsi.fast_dma = (fast_dma != 0);
 
 	if (sim->model & PCE_MAC_SE) {
 		mac_scsi_set_int_fct (&sim->scsi, sim, mac_interrupt_scsi);
@@ -1280,7 +1287,7 @@ void mac_setup_video (macplus_t *sim, ini_sct_t *ini)
 {
 	unsigned long addr1, addr2;
 	unsigned      w, h, i;
-	unsigned      bright;
+	unsigned      bright, max_fps, skip;
 	unsigned long col0, col1;
 	ini_sct_t     *sct;
 
@@ -1300,11 +1307,17 @@ void mac_setup_video (macplus_t *sim, ini_sct_t *ini)
 	ini_get_uint32 (sct, "color0", &col0, 0);
 	ini_get_uint32 (sct, "color1", &col1, 0xffffff);
 	ini_get_uint16 (sct, "brightness", &bright, 1000);
+	ini_get_uint16 (sct, "max_fps", &max_fps, 0);
+	ini_get_uint16 (sct, "frame_skip", &skip, 0);
 
 	pce_log_tag (MSG_INF, "VIDEO:", "addr=0x%06lX w=%u h=%u bright=%u%%\n",
 		addr2, w, h, bright / 10
 	);
 
+	pce_log_tag (MSG_INF, "VIDEO:", "max_fps=%u frame_skip=%u\n",
+		max_fps, skip
+	);
+
 	sim->vbuf1 = addr2;
 
 	if ((addr1 == addr2) && (addr2 >= 0x8000)) {
@@ -1333,6 +1346,8 @@ void mac_setup_video (macplus_t *sim, ini_sct_t *ini)
 	mac_video_set_color (sim->video, col0, col1);
 	mac_video_set_brightness (sim->video, (255UL * bright + 500) / 1000);
 
+	pce_frame_set_params (&sim->video->frame, max_fps, skip, 60);
+
 	for (i = 0; i < (w / 8) * h; i++) {
 		mem_set_uint8 (sim->mem, sim->vbuf1 + i, 0xff);
 	}
@@ -1378,6 +1393,10 @@ void mac_init (macplus_t *sim, ini_sct_t *ini)
 
 	bps_init (&sim->bps);
 
+	prof_init (&sim->prof);
+
+	cover_init (&sim->cover);
+
 	mac_setup_system (sim, ini);
 	mac_setup_mem (sim, ini);
 	mac_setup_cpu (sim, ini);
@@ -1402,6 +1421,21 @@ void mac_init (macplus_t *sim, ini_sct_t *ini)
 	mac_clock_discontinuity (sim);
 }
 
+static
+void mac_stats_update (void *ext)
+{
+	macplus_t *sim;
+
+	sim = ext;
+
+	pce_stats_set_sim (e68_get_opcnt (sim->cpu), sim->clk_cnt, MAC_CPU_CLOCK);
+	pce_stats_set_disks (sim->dsks);
+	pce_stats_set_trm (sim->trm);
+	pce_stats_set_snd ("sound", sim->sound.drv);
+	pce_stats_set_chr ("ser0", sim->ser[0].cdrv);
+	pce_stats_set_chr ("ser1", sim->ser[1].cdrv);
+}
+
 macplus_t *mac_new (ini_sct_t *ini)
 {
 	macplus_t *sim;
@@ -1413,6 +1447,8 @@ macplus_t *mac_new (ini_sct_t *ini)
 
 	mac_init (sim, ini);
 
+	pce_stats_set_update_fct (mac_stats_update, sim);
+
 	return (sim);
 }
 
@@ -1451,6 +1487,10 @@ void mac_free (macplus_t *sim)
 	mem_blk_del (sim->rom_ovl);
 
 	bps_free (&sim->bps);
+	prof_free (&sim->prof);
+	cover_free (&sim->cover);
+
+	pce_stats_set_update_fct (NULL, NULL);
 }
 
 void mac_del (macplus_t *sim)
@@ -1658,6 +1698,123 @@ void mac_clock_scc (macplus_t *sim, unsigned n)
 	}
 }
 
+/*
+ * Speed up pseudo DMA transfer loops of the form
+ *
+ *   loop: move.b (Ax), (Ay)+     or     move.b (Ay)+, (Ax)
+ *         dbra   Dn, loop
+ *
+ * by doing all remaining iterations at once, after the first one.
+ */
+static
+void mac_scsi_fast_dma (macplus_t *sim)
+{
+	unsigned      acc, op, dn, ax, ay;
+	unsigned long pc, addr, cnt, n, i;
+	unsigned char buf[512];
+	e68000_t      *cpu;
+	mem_blk_t     *blk;
+
+	acc = sim->scsi.dma_acc;
+	sim->scsi.dma_acc = 0;
+
+	cpu = sim->cpu;
+	pc = e68_get_pc (cpu) & 0x00ffffff;
+
+	if ((e68_get_last_pc (cpu, 0) & 0x00ffffff) != ((pc - 2) & 0x00ffffff)) {
+		return;
+	}
+
+	op = e68_get_mem16 (cpu, pc);
+
+	if (((op & 0xfff8) != 0x51c8) || (e68_get_mem16 (cpu, pc + 2) != 0xfffc)) {
+		return;
+	}
+
+	dn = op & 7;
+
+	op = e68_get_mem16 (cpu, pc - 2);
+
+	if (acc == 1) {
+		if ((op & 0xf1f8) != 0x10d0) {
+			return;
+		}
+
+		ax = op & 7;
+		ay = (op >> 9) & 7;
+	}
+	else if (acc == 2) {
+		if ((op & 0xf1f8) != 0x1098) {
+			return;
+		}
+
+		ax = (op >> 9) & 7;
+		ay = op & 7;
+	}
+	else {
+		return;
+	}
+
+	if (ax == ay) {
+		return;
+	}
+
+	/* Ax must point to the pseudo DMA register */
+	addr = e68_get_areg32 (cpu, ax) & 0x00ffffff;
+	blk = mem_get_blk (sim->mem, addr);
+
+	if ((blk == NULL) || (blk->ext != &sim->scsi)) {
+		return;
+	}
+
+	if (mac_scsi_is_dma_addr (&sim->scsi, addr - blk->addr1, acc == 2) == 0) {
+		return;
+	}
+
+	cnt = e68_get_dreg16 (cpu, dn);
+	addr = e68_get_areg32 (cpu, ay) & 0x00ffffff;
+
+	if (cnt > (0x01000000 - addr)) {
+		cnt = 0x01000000 - addr;
+	}
+
+	i = 0;
+
+	while (i < cnt) {
+		n = cnt - i;
+
+		if (n > sizeof (buf)) {
+			n = sizeof (buf);
+		}
+
+		if (acc == 1) {
+			n = mac_scsi_get_buf_dma (&sim->scsi, buf, n);
+			mem_write_buf (sim->mem, addr + i, buf, n);
+		}
+		else {
+			mem_read_buf (sim->mem, addr + i, buf, n);
+			n = mac_scsi_set_buf_dma (&sim->scsi, buf, n);
+		}
+
+		i += n;
+
+		if (n < sizeof (buf)) {
+			break;
+		}
+	}
+
+	if (i == 0) {
+		return;
+	}
+
+	e68_set_areg32 (cpu, ay, e68_get_areg32 (cpu, ay) + i);
+	e68_set_dreg16 (cpu, dn, e68_get_dreg16 (cpu, dn) - i);
+
+	/* move.b (12 cycles) and a taken dbra (10 cycles) per byte */
+	cpu->delay += 22 * i;
+	cpu->oprcnt += 2 * i;
+}
+
 void mac_clock (macplus_t *sim, unsigned n)
 {
 	unsigned long viaclk, clkdiv, cpuclk;
@@ -1678,8 +1835,16 @@ void mac_clock (macplus_t *sim, unsigned n)
 		clkdiv = sim->speed_factor;
 	}
 
+	if (sim->prof.enabled) {
+		prof_add (&sim->prof, e68_get_pc (sim->cpu), cpuclk);
+	}
+
 	e68_clock (sim->cpu, cpuclk);
 
+	if (sim->scsi.dma_acc) {
+		mac_scsi_fast_dma (sim);
+	}
+
 	mac_sound_clock (&sim->sound, cpuclk);
 
 	sim->clk_cnt += n;
@@ -1738,6 +1903,8 @@ void mac_clock (macplus_t *sim, unsigned n)
 
 	mac_rtc_clock (&sim->rtc, sim->clk_div[3]);
 
+	pce_stats_check();
+
 	mac_realtime_sync (sim, sim->clk_div[3]);
 
 	sim->clk_div[3] = 0;
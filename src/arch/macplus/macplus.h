@@ -49,6 +49,8 @@
 #include <drivers/video/terminal.h>
 
 #include <lib/brkpt.h>
+#include <lib/cover.h>
+#include <lib/prof.h>
 
 
 #define PCE_MAC_PLUS    1
@@ -78,6 +80,10 @@ struct macplus_s {
 
 	bp_set_t           bps;
 
+	prof_t             prof;
+
+	cover_t            cover;
+
 	e6522_t            via;
 	e8530_t            scc;
 	mac_rtc_t          rtc;
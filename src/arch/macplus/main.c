@@ -35,10 +35,13 @@
 #include <lib/cfg.h>
 #include <lib/cmd.h>
 #include <lib/console.h>
+#include <lib/cover.h>
 #include <lib/getopt.h>
 #include <lib/log.h>
 #include <lib/monitor.h>
 #include <lib/path.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 #include <libini/libini.h>
@@ -62,16 +65,22 @@ ini_sct_t  *par_cfg = NULL;
 
 static ini_strings_t par_ini_str;
 
+static const char    *par_prof = NULL;
+static const char    *par_cover = NULL;
+
 
 static pce_option_t opts[] = {
 	{ '?', 0, "help", NULL, "Print usage information" },
 	{ 'b', 1, "boot-disk", "int", "Set the boot disk [none]" },
+	{ 'C', 1, "coverage", "string", "Collect guest code coverage and save it [none]" },
 	{ 'c', 1, "config", "string", "Set the config file name [none]" },
 	{ 'd', 1, "path", "string", "Add a directory to the search path" },
 	{ 'i', 1, "ini-prefix", "string", "Add an ini string before the config file" },
 	{ 'I', 1, "ini-append", "string", "Add an ini string after the config file" },
+	{ 'k', 1, "config-cache", "string", "Set the config cache file name [none]" },
 	{ 'l', 1, "log", "string", "Set the log file name [none]" },
 	{ 'p', 1, "cpu", "string", "Set the CPU model" },
+	{ 'P', 1, "profile", "string", "Profile guest code and save the profile [none]" },
 	{ 'q', 0, "quiet", NULL, "Set the log level to error [no]" },
 	{ 'r', 0, "run", NULL, "Start running immediately [no]" },
 	{ 'R', 0, "no-monitor", NULL, "Never stop running [no]" },
@@ -226,6 +235,8 @@ int main (int argc, char *argv[])
 	pce_log_init();
 	pce_log_add_fp (stderr, 0, MSG_INF);
 
+	pce_stats_init();
+
 	par_cfg = ini_sct_new (NULL);
 
 	if (par_cfg == NULL) {
@@ -284,6 +295,10 @@ int main (int argc, char *argv[])
 			ini_str_add (&par_ini_str, optarg[0], "\n", NULL);
 			break;
 
+		case 'k':
+			pce_set_config_cache (optarg[0]);
+			break;
+
 		case 'l':
 			pce_log_add_fname (optarg[0], MSG_DEB);
 			break;
@@ -294,6 +309,14 @@ int main (int argc, char *argv[])
 			);
 			break;
 
+		case 'C':
+			par_cover = optarg[0];
+			break;
+
+		case 'P':
+			par_prof = optarg[0];
+			break;
+
 		case 'q':
 			pce_log_set_level (stderr, MSG_ERR);
 			break;
@@ -374,6 +397,17 @@ int main (int argc, char *argv[])
 	cmd_init (par_sim, cmd_get_sym, cmd_set_sym);
 	mac_cmd_init (par_sim, &par_mon);
 
+	if (par_prof != NULL) {
+		par_sim->prof.enabled = 1;
+		par_sim->prof.stack = prof_fname_folded (par_prof);
+		mac_prof_update (par_sim);
+	}
+
+	if (par_cover != NULL) {
+		par_sim->cover.enabled = 1;
+		mac_prof_update (par_sim);
+	}
+
 	mac_reset (par_sim);
 
 	if (nomon) {
@@ -395,6 +429,22 @@ int main (int argc, char *argv[])
 		mon_run (&par_mon);
 	}
 
+	if (par_prof != NULL) {
+		if (prof_save (&par_sim->prof, par_prof)) {
+			fprintf (stderr, "%s: writing profile failed (%s)\n",
+				argv[0], par_prof
+			);
+		}
+	}
+
+	if (par_cover != NULL) {
+		if (cover_save (&par_sim->cover, par_cover)) {
+			fprintf (stderr, "%s: writing coverage failed (%s)\n",
+				argv[0], par_cover
+			);
+		}
+	}
+
 	mac_del (par_sim);
 
 #ifdef PCE_ENABLE_SDL
@@ -402,6 +452,7 @@ int main (int argc, char *argv[])
 #endif
 
 	mon_free (&par_mon);
+	pce_stats_done();
 	pce_console_done();
 	pce_log_done();
 
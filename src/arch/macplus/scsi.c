@@ -115,6 +115,9 @@ void mac_scsi_init (mac_scsi_t *scsi)
 	scsi->addr_mask = 0xff0;
 	scsi->addr_shift = 4;
 
+	scsi->fast_dma = 0;
+	scsi->dma_acc = 0;
+
 	scsi->cmd_start = NULL;
 	scsi->cmd_finish = NULL;
 
@@ -1269,9 +1272,38 @@ unsigned char mac_scsi_get_csd_dma (mac_scsi_t *scsi)
 		mac_scsi_set_phase_status (scsi, 0x00);
 	}
 
+	if (scsi->fast_dma) {
+		scsi->dma_acc |= 1;
+	}
+
 	return (val);
 }
 
+unsigned long mac_scsi_get_buf_dma (mac_scsi_t *scsi, void *buf, unsigned long cnt)
+{
+	if (scsi->phase != E5380_PHASE_DATA_IN) {
+		return (0);
+	}
+
+	if (scsi->buf_i >= scsi->buf_n) {
+		return (0);
+	}
+
+	if (cnt > (scsi->buf_n - scsi->buf_i)) {
+		cnt = scsi->buf_n - scsi->buf_i;
+	}
+
+	memcpy (buf, scsi->buf + scsi->buf_i, cnt);
+
+	scsi->buf_i += cnt;
+
+	if (scsi->buf_i >= scsi->buf_n) {
+		mac_scsi_set_phase_status (scsi, 0x00);
+	}
+
+	return (cnt);
+}
+
 static
 unsigned char mac_scsi_get_icr (mac_scsi_t *scsi)
 {
@@ -1400,6 +1432,51 @@ void mac_scsi_set_odr_dma (mac_scsi_t *scsi, unsigned char val)
 			mac_scsi_set_phase_status (scsi, 0x02);
 		}
 	}
+
+	if (scsi->fast_dma) {
+		scsi->dma_acc |= 2;
+	}
+}
+
+unsigned long mac_scsi_set_buf_dma (mac_scsi_t *scsi, const void *buf, unsigned long cnt)
+{
+	if (scsi->phase != E5380_PHASE_DATA_OUT) {
+		return (0);
+	}
+
+	if (scsi->buf_i >= scsi->buf_n) {
+		return (0);
+	}
+
+	if (cnt > (scsi->buf_n - scsi->buf_i)) {
+		cnt = scsi->buf_n - scsi->buf_i;
+	}
+
+	memcpy (scsi->buf + scsi->buf_i, buf, cnt);
+
+	scsi->buf_i += cnt;
+
+	if (scsi->buf_i >= scsi->buf_n) {
+		if (scsi->cmd_finish != NULL) {
+			scsi->cmd_finish (scsi);
+		}
+		else {
+			mac_scsi_set_phase_status (scsi, 0x02);
+		}
+	}
+
+	return (cnt);
+}
+
+int mac_scsi_is_dma_addr (mac_scsi_t *scsi, unsigned long addr, int wr)
+{
+	addr = (addr & scsi->addr_mask) >> scsi->addr_shift;
+
+	if (wr) {
+		return (addr == 0x20);
+	}
+
+	return ((addr == 0x06) || (addr == 0x20) || (addr == 0x26));
 }
 
 static
@@ -1724,6 +1801,8 @@ void mac_scsi_reset (mac_scsi_t *scsi)
 	scsi->buf_i = 0;
 	scsi->buf_n = 0;
 
+	scsi->dma_acc = 0;
+
 	scsi->cmd_start = NULL;
 	scsi->cmd_finish = NULL;
 }
@@ -91,6 +91,12 @@ typedef struct mac_scsi_s {
 	unsigned long addr_mask;
 	unsigned      addr_shift;
 
+	/* speed up pseudo DMA transfer loops */
+	char          fast_dma;
+
+	/* pseudo DMA accesses since the last check (1 = read, 2 = write) */
+	unsigned char dma_acc;
+
 	void          (*cmd_start) (struct mac_scsi_s *scsi);
 	void          (*cmd_finish) (struct mac_scsi_s *scsi);
 
@@ -121,6 +127,25 @@ unsigned short mac_scsi_get_uint16 (void *ext, unsigned long addr);
 void mac_scsi_set_uint8 (void *ext, unsigned long addr, unsigned char val);
 void mac_scsi_set_uint16 (void *ext, unsigned long addr, unsigned short val);
 
+/*****************************************************************************
+ * @short  Read up to cnt bytes through the pseudo DMA register
+ * @return The number of bytes read
+ *****************************************************************************/
+unsigned long mac_scsi_get_buf_dma (mac_scsi_t *scsi, void *buf, unsigned long cnt);
+
+/*****************************************************************************
+ * @short  Write up to cnt bytes through the pseudo DMA register
+ * @return The number of bytes written
+ *****************************************************************************/
+unsigned long mac_scsi_set_buf_dma (mac_scsi_t *scsi, const void *buf, unsigned long cnt);
+
+/*****************************************************************************
+ * @short  Check if an address accesses the pseudo DMA register
+ * @param  addr The address, relative to the start of the SCSI block
+ * @param  wr   Check for a write access if true, for a read access otherwise
+ *****************************************************************************/
+int mac_scsi_is_dma_addr (mac_scsi_t *scsi, unsigned long addr, int wr);
+
 void mac_scsi_reset (mac_scsi_t *scsi);
 
 int mac_scsi_ethernet_open (mac_scsi_t *scsi, mac_scsi_dev_t *dev);
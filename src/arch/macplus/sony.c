@@ -683,7 +683,6 @@ void mac_sony_prime_read (mac_sony_t *sony, unsigned drive)
 	unsigned long addr, vars;
 	unsigned long ofs, cnt;
 	unsigned long i, n;
-	unsigned      j;
 	disk_t        *dsk;
 	unsigned char buf[512];
 	unsigned char tag[12];
@@ -730,18 +729,11 @@ void mac_sony_prime_read (mac_sony_t *sony, unsigned drive)
 			return;
 		}
 
-		for (j = 0; j < 512; j++) {
-			mem_set_uint8 (sony->mem, addr + 512 * i + j, buf[j]);
-		}
-
-		for (j = 0; j < 12; j++) {
-			mem_set_uint8 (sony->mem, 0x2fc + j, tag[j]);
-		}
+		mem_write_buf (sony->mem, addr + 512 * i, buf, 512);
+		mem_write_buf (sony->mem, 0x2fc, tag, 12);
 
 		if (sony->tag_buf != 0) {
-			for (j = 0; j < 12; j++) {
-				mem_set_uint8 (sony->mem, sony->tag_buf + 12 * i + j, tag[j]);
-			}
+			mem_write_buf (sony->mem, sony->tag_buf + 12 * i, tag, 12);
 		}
 	}
 
@@ -763,7 +755,6 @@ void mac_sony_prime_write (mac_sony_t *sony, unsigned drive)
 	unsigned long ofs, cnt;
 	unsigned      relblk;
 	unsigned long i, n;
-	unsigned      j;
 	disk_t        *dsk;
 	unsigned char buf[512];
 	unsigned char tag[12];
@@ -803,22 +794,15 @@ void mac_sony_prime_write (mac_sony_t *sony, unsigned drive)
 	n = cnt / 512;
 
 	for (i = 0; i < n; i++) {
-		for (j = 0; j < 512; j++) {
-			buf[j] = mem_get_uint8 (sony->mem, addr + 512 * i + j);
-		}
+		mem_read_buf (sony->mem, addr + 512 * i, buf, 512);
 
 		if (sony->tag_buf != 0) {
-			for (j = 0; j < 12; j++) {
-				tag[j] = mem_get_uint8 (sony->mem, sony->tag_buf + 12 * i + j);
-				mem_set_uint8 (sony->mem, 0x2fc + j, tag[j]);
-			}
+			mem_read_buf (sony->mem, sony->tag_buf + 12 * i, tag, 12);
+			mem_write_buf (sony->mem, 0x2fc, tag, 12);
 		}
 		else {
 			mem_set_uint16_be (sony->mem, 0x302, relblk + i);
-
-			for (j = 0; j < 12; j++) {
-				tag[j] = mem_get_uint8 (sony->mem, 0x2fc + j);
-			}
+			mem_read_buf (sony->mem, 0x2fc, tag, 12);
 		}
 
 		if (mac_sony_write_block (dsk, buf, tag, (ofs / 512) + i)) {
@@ -1166,7 +1150,6 @@ void mac_sony_ctl_get_drive_info (mac_sony_t *sony)
 static
 void mac_sony_ctl_format_copy (mac_sony_t *sony)
 {
-	unsigned      i;
 	unsigned      vref, format, type;
 	unsigned long data, tags;
 	unsigned long idx, blk;
@@ -1224,14 +1207,10 @@ void mac_sony_ctl_format_copy (mac_sony_t *sony)
 	memset (tag, 0, 12);
 
 	for (idx = 0; idx < blk; idx++) {
-		for (i = 0; i < 512; i++) {
-			buf[i] = mem_get_uint8 (sony->mem, data + i);
-		}
+		mem_read_buf (sony->mem, data, buf, 512);
 
 		if ((type != 2) && (type != 3)) {
-			for (i = 0; i < 12; i++) {
-				tag[i] = mem_get_uint8 (sony->mem, tags + i);
-			}
+			mem_read_buf (sony->mem, tags, tag, 12);
 		}
 
 		if (mac_sony_write_block (dsk, buf, tag, idx)) {
@@ -45,7 +45,9 @@ int mac_video_init (mac_video_t *mv, unsigned w, unsigned h)
 	mv->vb2 = ((unsigned long)(h + 28) * (unsigned long)(w + 192) *
 	    7833600) / MAC_VIDEO_PFREQ;
 
-	mv->force = 0;
+	mv->force = 1;
+
+	pce_frame_init (&mv->frame);
 
 	mv->cmp_cnt = 8;
 
@@ -55,12 +57,6 @@ int mac_video_init (mac_video_t *mv, unsigned w, unsigned h)
 		return (1);
 	}
 
-	mv->rgb = malloc (3UL * (unsigned long) w * mv->cmp_cnt);
-
-	if (mv->rgb == NULL) {
-		return (1);
-	}
-
 	mv->brightness = 255;
 
 	mv->col0[0] = 0;
@@ -174,7 +170,7 @@ void mac_video_update (mac_video_t *mv)
 	unsigned            y;
 	unsigned            i, j;
 	unsigned            k, n;
-	const unsigned char *src;
+	const unsigned char *src, *line;
 	unsigned char       *dst, *rgb;
 	unsigned char       col0[3], col1[3];
 
@@ -191,11 +187,13 @@ void mac_video_update (mac_video_t *mv)
 		col1[i] = (mv->brightness * mv->col1[i]) / 255;
 	}
 
-	trm_set_size (mv->trm, mv->w, mv->h);
+	if ((mv->trm->w != mv->w) || (mv->trm->h != mv->h)) {
+		trm_set_size (mv->trm, mv->w, mv->h);
+		mv->force = 1;
+	}
 
 	src = mv->vbuf;
 	dst = mv->vcmp;
-	rgb = mv->rgb;
 
 	y = 0;
 	while (y < mv->h) {
@@ -208,25 +206,33 @@ void mac_video_update (mac_video_t *mv)
 		k = n * ((mv->w + 7) / 8);
 
 		if (mv->force || (memcmp (dst, src, k) != 0)) {
+			/* render directly into the terminal buffer */
+			if ((rgb = trm_get_lines (mv->trm, y, n)) == NULL) {
+				break;
+			}
+
 			memcpy (dst, src, k);
 
-			j = 0;
-			for (i = 0; i < (8 * k); i++) {
-				if (dst[i >> 3] & (0x80 >> (i & 7))) {
-					rgb[j + 0] = col0[0];
-					rgb[j + 1] = col0[1];
-					rgb[j + 2] = col0[2];
-				}
-				else {
-					rgb[j + 0] = col1[0];
-					rgb[j + 1] = col1[1];
-					rgb[j + 2] = col1[2];
+			for (j = 0; j < n; j++) {
+				line = dst + j * ((mv->w + 7) / 8);
+
+				for (i = 0; i < mv->w; i++) {
+					if (line[i >> 3] & (0x80 >> (i & 7))) {
+						rgb[0] = col0[0];
+						rgb[1] = col0[1];
+						rgb[2] = col0[2];
+					}
+					else {
+						rgb[0] = col1[0];
+						rgb[1] = col1[1];
+						rgb[2] = col1[2];
+					}
+
+					rgb += 3;
 				}
-
-				j += 3;
 			}
 
-			trm_set_lines (mv->trm, rgb, y, n);
+			trm_set_lines_dirty (mv->trm, y, n);
 		}
 
 		src += k;
@@ -259,7 +265,10 @@ void mac_video_clock (mac_video_t *mv, unsigned long n)
 
 	if (old < mv->vb1) {
 		/* vbl start */
-		mac_video_update (mv);
+		if (pce_frame_next (&mv->frame, 1)) {
+			mac_video_update (mv);
+		}
+
 		mac_video_set_vbi (mv, 1);
 	}
 
@@ -24,6 +24,7 @@
 #define PCE_MACPLUS_VIDEO_H 1
 
 
+#include <devices/video/video.h>
 #include <drivers/video/terminal.h>
 
 
@@ -44,8 +45,6 @@ typedef struct {
 
 	unsigned char       *vcmp;
 
-	unsigned char       *rgb;
-
 	unsigned            brightness;
 	unsigned char       col0[3];
 	unsigned char       col1[3];
@@ -54,6 +53,8 @@ typedef struct {
 
 	terminal_t          *trm;
 
+	pce_frame_t         frame;
+
 	unsigned char       vbi_val;
 	void                *vbi_ext;
 	void                (*set_vbi) (void *ext, unsigned char val);
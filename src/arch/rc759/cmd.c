@@ -29,14 +29,18 @@
 #include <lib/brkpt.h>
 #include <lib/cmd.h>
 #include <lib/console.h>
+#include <lib/cover.h>
 #include <lib/log.h>
 #include <lib/monitor.h>
 #include <lib/msgdsk.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
 static mon_cmd_t par_cmd[] = {
 	{ "c", "[cnt]", "clock the simulation [1]" },
+	{ "cover", "[on|off|clear|list|save fname]", "control guest code coverage" },
 	{ "gb", "[addr...]", "run with breakpoints" },
 	{ "g", "far", "run until CS changes" },
 	{ "g", "", "run" },
@@ -51,8 +55,12 @@ static mon_cmd_t par_cmd[] = {
 	{ "o", "[b|w] port val", "output a byte or word to a port" },
 	{ "pq", "[c|f|s]", "prefetch queue clear/fill/status" },
 	{ "p", "[cnt]", "execute cnt instructions, without trace in calls [1]" },
+	{ "prof", "[on|off|clear|stack on|off]", "control the profiler" },
+	{ "prof", "[flat [cnt]|folded|save fname]", "print or save the profile" },
 	{ "r", "[reg val]", "set a register" },
 	{ "s", "[what]", "print status (cpu|disks|icu|mem||ppi|pic|rc759|tcu|time)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
 	{ "u", "[addr [cnt [mode]]]", "disassemble" }
 };
@@ -368,6 +376,8 @@ void print_state_video (e82730_t *crt)
 	pce_printf ("\tv field stop:    %u\n", crt->mode_vfldstp);
 	pce_printf ("\tlines per row:   %u\n", crt->mode_lines_per_row);
 	pce_printf ("\tframe int count: %u\n", crt->frame_int_count[0]);
+	pce_printf ("\tframes rendered: %lu\n", crt->frame.rendered);
+	pce_printf ("\tframes dropped:  %lu\n", crt->frame.dropped);
 
 	for (i = 0; i < 2; i++) {
 		pce_printf ("CURSOR %u: X=%02X Y=%02X OE=%d RVV=%d BE=%d FREQ=%u DUTY=%u START=%02X STOP=%02X\n",
@@ -554,6 +564,38 @@ void pce_op_undef (void *ext, unsigned char op1, unsigned char op2)
 	trm_check (sim->trm);
 }
 
+static
+void pce_op_stat (void *ext, unsigned char op1, unsigned char op2)
+{
+	rc759_t *sim;
+
+	sim = ext;
+
+	if (sim->cover.enabled) {
+		cover_add (&sim->cover,
+			e86_get_linear (e86_get_cs (sim->cpu), e86_get_ip (sim->cpu))
+		);
+	}
+
+	if (sim->prof.enabled && sim->prof.stack) {
+		prof_op_e86 (&sim->prof,
+			e86_get_linear (e86_get_cs (sim->cpu), e86_get_ip (sim->cpu)),
+			op1, op2
+		);
+	}
+}
+
+void rc759_prof_update (rc759_t *sim)
+{
+	if ((sim->prof.enabled && sim->prof.stack) || sim->cover.enabled) {
+		sim->cpu->op_stat = pce_op_stat;
+	}
+	else {
+		sim->cpu->op_stat = NULL;
+		sim->prof.call = 0;
+	}
+}
+
 
 static
 void rc759_cmd_c (cmd_t *cmd, rc759_t *sim)
@@ -1342,6 +1384,10 @@ int rc759_cmd (rc759_t *sim, cmd_t *cmd)
 	if (cmd_match (cmd, "b")) {
 		cmd_do_b (cmd, &sim->bps);
 	}
+	else if (cmd_match (cmd, "cover")) {
+		cover_cmd (cmd, &sim->cover);
+		rc759_prof_update (sim);
+	}
 	else if (cmd_match (cmd, "c")) {
 		rc759_cmd_c (cmd, sim);
 	}
@@ -1366,6 +1412,10 @@ int rc759_cmd (rc759_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "o")) {
 		rc759_cmd_o (cmd, sim);
 	}
+	else if (cmd_match (cmd, "prof")) {
+		prof_cmd (cmd, &sim->prof);
+		rc759_prof_update (sim);
+	}
 	else if (cmd_match (cmd, "pq")) {
 		rc759_cmd_pq (cmd, sim);
 	}
@@ -1378,6 +1428,9 @@ int rc759_cmd (rc759_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "set")) {
 		rc759_cmd_set (cmd, sim);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		rc759_cmd_s (cmd, sim);
 	}
@@ -1403,4 +1456,6 @@ void rc759_cmd_init (rc759_t *sim, monitor_t *mon)
 
 	sim->cpu->op_int = pce_op_int;
 	sim->cpu->op_undef = pce_op_undef;
+
+	rc759_prof_update (sim);
 }
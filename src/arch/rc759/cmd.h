@@ -38,6 +38,8 @@ void rc759_run (rc759_t *sim);
 
 int rc759_cmd (rc759_t *sim, cmd_t *cmd);
 
+void rc759_prof_update (rc759_t *sim);
+
 void rc759_cmd_init (rc759_t *sim, monitor_t *mon);
 
 
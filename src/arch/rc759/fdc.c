@@ -83,6 +83,8 @@ int rc759_write_track (void *ext, unsigned d, unsigned c, unsigned h, pri_trk_t
 
 	fdc->modified[d & 1] = 1;
 
+	trk->dirty = 1;
+
 	return (0);
 }
 
@@ -465,7 +467,15 @@ int rc759_fdc_save_disk_psi (rc759_fdc_t *fdc, disk_t *dsk, unsigned drive)
 		return (1);
 	}
 
+	pri_img_clear_dirty (fdc->img[drive]);
+
 	psi = dsk->ext;
+
+	/* keep the tracks modified since the last commit */
+	if (psi_img_copy_dirty (img, psi->img)) {
+		psi->compact = 1;
+	}
+
 	psi_img_del (psi->img);
 	psi->img = img;
 	psi->dirty = 1;
@@ -43,6 +43,7 @@
 #include <lib/initerm.h>
 #include <lib/load.h>
 #include <lib/log.h>
+#include <lib/stats.h>
 #include <lib/string.h>
 #include <lib/sysdep.h>
 
@@ -264,6 +265,11 @@ void rc759_setup_cpu (rc759_t *sim, ini_sct_t *ini)
 		(e86_set_uint16_f) mem_set_uint16_le
 	);
 
+	e86_set_mem_buf_fct (sim->cpu,
+		(e86_get_buf_f) mem_read_buf,
+		(e86_set_buf_f) mem_write_buf
+	);
+
 	e86_set_prt (sim->cpu, sim->iop,
 		(e86_get_uint8_f) mem_get_uint8,
 		(e86_set_uint8_f) mem_set_uint8,
@@ -541,7 +547,7 @@ void rc759_setup_terminal (rc759_t *sim, ini_sct_t *ini)
 static
 void rc759_setup_video (rc759_t *sim, ini_sct_t *ini)
 {
-	unsigned  min_h;
+	unsigned  min_h, max_fps, skip;
 	int       mono, hires;
 	ini_sct_t *sct;
 
@@ -554,6 +560,8 @@ void rc759_setup_video (rc759_t *sim, ini_sct_t *ini)
 	ini_get_uint16 (sct, "min_h", &min_h, 0);
 	ini_get_bool (sct, "mono", &mono, 0);
 	ini_get_bool (sct, "hires", &hires, 0);
+	ini_get_uint16 (sct, "max_fps", &max_fps, 0);
+	ini_get_uint16 (sct, "frame_skip", &skip, 0);
 
 	if (par_video != NULL) {
 		if (strcmp (par_video, "mono") == 0) {
@@ -579,9 +587,11 @@ void rc759_setup_video (rc759_t *sim, ini_sct_t *ini)
 	e82730_set_monochrome (&sim->crt, mono);
 	e82730_set_min_h (&sim->crt, min_h);
 
+	pce_frame_set_params (&sim->crt.frame, max_fps, skip, 50);
+
 	pce_log_tag (MSG_INF, "VIDEO:",
-		"monochrome=%d 22KHz=%d min_h=%u\n",
-		mono, hires, min_h
+		"monochrome=%d 22KHz=%d min_h=%u max_fps=%u frame_skip=%u\n",
+		mono, hires, min_h, max_fps, skip
 	);
 
 	if (hires) {
@@ -682,6 +692,21 @@ void rc759_setup_parport (rc759_t *sim, ini_sct_t *ini)
 	}
 }
 
+static
+void rc759_stats_update (void *ext)
+{
+	rc759_t *sim;
+
+	sim = ext;
+
+	pce_stats_set_sim (e86_get_opcnt (sim->cpu), sim->clock_cnt, sim->clock_freq);
+	pce_stats_set_disks (sim->dsks);
+	pce_stats_set_trm (sim->trm);
+	pce_stats_set_snd ("speaker", sim->spk.drv);
+	pce_stats_set_chr ("par0", sim->par[0].cdrv);
+	pce_stats_set_chr ("par1", sim->par[1].cdrv);
+}
+
 rc759_t *rc759_new (ini_sct_t *ini)
 {
 	rc759_t *sim;
@@ -699,6 +724,9 @@ rc759_t *rc759_new (ini_sct_t *ini)
 	sim->disk_id = 0;
 
 	bps_init (&sim->bps);
+	prof_init (&sim->prof);
+	cover_init (&sim->cover);
+
 	rc759_setup_system (sim, ini);
 	rc759_setup_mem (sim, ini);
 	rc759_setup_ports (sim, ini);
@@ -726,6 +754,8 @@ rc759_t *rc759_new (ini_sct_t *ini)
 
 	rc759_clock_reset (sim);
 
+	pce_stats_set_update_fct (rc759_stats_update, sim);
+
 	return (sim);
 }
 
@@ -735,7 +765,11 @@ void rc759_del (rc759_t *sim)
 		return;
 	}
 
+	pce_stats_set_update_fct (NULL, NULL);
+
 	bps_free (&sim->bps);
+	prof_free (&sim->prof);
+	cover_free (&sim->cover);
 	rc759_par_free (&sim->par[1]);
 	rc759_par_free (&sim->par[0]);
 	rc759_fdc_free (&sim->fdc);
@@ -967,6 +1001,13 @@ void rc759_clock (rc759_t *sim, unsigned cnt)
 		cpuclk = cnt;
 	}
 
+	if (sim->prof.enabled) {
+		prof_add (&sim->prof,
+			e86_get_linear (e86_get_cs (sim->cpu), e86_get_ip (sim->cpu)),
+			cpuclk
+		);
+	}
+
 	e86_clock (sim->cpu, cpuclk);
 
 	e80186_tcu_clock (&sim->tcu, sysclk);
@@ -1017,5 +1058,7 @@ void rc759_clock (rc759_t *sim, unsigned cnt)
 	sim->clock_rem65536 &= 65535;
 	sysclk -= sim->clock_rem65536;
 
+	pce_stats_check();
+
 	rc759_clock_delay (sim);
 }
@@ -49,6 +49,8 @@
 #include <drivers/video/terminal.h>
 
 #include <lib/brkpt.h>
+#include <lib/cover.h>
+#include <lib/prof.h>
 
 #include <libini/libini.h>
 
@@ -80,6 +82,10 @@ typedef struct rc759_t {
 
 	bp_set_t           bps;
 
+	prof_t             prof;
+
+	cover_t            cover;
+
 	unsigned char      ppi_port_a;
 	unsigned char      ppi_port_b;
 	unsigned char      ppi_port_c;
@@ -112,6 +112,8 @@ void e82730_init (e82730_t *crt)
 
 	crt->trm = NULL;
 
+	pce_frame_init (&crt->frame);
+
 	crt->set_mem_ext = NULL;
 	crt->set_mem8 = NULL;
 	crt->set_mem16 = NULL;
@@ -1184,7 +1186,7 @@ void e82730_clock_line (e82730_t *crt)
 			crt->buf_y += 1;
 		}
 
-		if (crt->trm != NULL) {
+		if ((crt->trm != NULL) && pce_frame_next (&crt->frame, 1)) {
 			trm_set_size (crt->trm, crt->buf_w, crt->buf_y);
 			trm_set_lines (crt->trm, crt->buf, 0, crt->buf_y);
 			trm_update (crt->trm);
@@ -24,6 +24,7 @@
 #define PCE_RC759_VIDEO_H 1
 
 
+#include <devices/video/video.h>
 #include <drivers/video/terminal.h>
 
 
@@ -111,6 +112,8 @@ typedef struct {
 
 	terminal_t      *trm;
 
+	pce_frame_t     frame;
+
 	e82730_rowbuf_t *rbp[2];
 	e82730_rowbuf_t rowbuf[2];
 
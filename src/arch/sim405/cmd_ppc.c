@@ -40,6 +40,8 @@
 #include <lib/cmd.h>
 #include <lib/console.h>
 #include <lib/monitor.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
@@ -49,9 +51,13 @@ static mon_cmd_t par_cmd[] = {
 	{ "g", "", "run" },
 	{ "key", "[val...]", "send keycodes to the serial console" },
 	{ "p", "[cnt]", "execute cnt instructions, skip calls [1]" },
+	{ "prof", "[on|off|clear]", "control the profiler" },
+	{ "prof", "[flat [cnt]|folded|save fname]", "print or save the profile" },
 	{ "rfi", "", "execute to next rfi or rfci" },
 	{ "r", "reg [val]", "get or set a register" },
 	{ "s", "[what]", "print status (mem|ppc|spr|time|uart0|uart1|uic)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "tlb", "l [first [count]]", "list TLB entries" },
 	{ "tlb", "s addr", "search the TLB" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
@@ -1151,6 +1157,9 @@ int ppc_do_cmd (sim405_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "key")) {
 		do_key (cmd, sim);
 	}
+	else if (cmd_match (cmd, "prof")) {
+		prof_cmd (cmd, &sim->prof);
+	}
 	else if (cmd_match (cmd, "p")) {
 		do_p (cmd, sim);
 	}
@@ -1160,6 +1169,9 @@ int ppc_do_cmd (sim405_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "r")) {
 		do_r (cmd, sim);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		do_s (cmd, sim);
 	}
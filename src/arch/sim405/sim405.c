@@ -49,6 +49,7 @@
 
 #include <lib/brkpt.h>
 #include <lib/log.h>
+#include <lib/stats.h>
 #include <lib/iniata.h>
 #include <lib/inidsk.h>
 #include <lib/iniram.h>
@@ -382,6 +383,25 @@ void s405_setup_devices (sim405_t *sim, ini_sct_t *ini)
 	}
 }
 
+static
+void s405_stats_update (void *ext)
+{
+	sim405_t *sim;
+
+	sim = ext;
+
+	pce_stats_set_sim (p405_get_opcnt (sim->ppc), sim->clk_cnt, S405_CLOCK);
+	pce_stats_set_disks (sim->dsks);
+
+	if (sim->serport[0] != NULL) {
+		pce_stats_set_chr ("ser0", sim->serport[0]->cdrv);
+	}
+
+	if (sim->serport[1] != NULL) {
+		pce_stats_set_chr ("ser1", sim->serport[1]->cdrv);
+	}
+}
+
 sim405_t *s405_new (ini_sct_t *ini)
 {
 	unsigned i;
@@ -412,6 +432,7 @@ sim405_t *s405_new (ini_sct_t *ini)
 	s405_hook_init (sim);
 
 	bps_init (&sim->bps);
+	prof_init (&sim->prof);
 
 	dev_lst_init (&sim->devlst);
 
@@ -439,6 +460,8 @@ sim405_t *s405_new (ini_sct_t *ini)
 
 	pce_load_mem_ini (sim->mem, ini);
 
+	pce_stats_set_update_fct (s405_stats_update, sim);
+
 	return (sim);
 }
 
@@ -448,6 +471,8 @@ void s405_del (sim405_t *sim)
 		return;
 	}
 
+	pce_stats_set_update_fct (NULL, NULL);
+
 	dev_lst_free (&sim->devlst);
 
 	pci_ata_free (&sim->pciata);
@@ -466,6 +491,7 @@ void s405_del (sim405_t *sim)
 	mem_del (sim->mem);
 
 	bps_free (&sim->bps);
+	prof_free (&sim->prof);
 
 	s405_hook_free (sim);
 
@@ -698,6 +724,8 @@ void s405_clock (sim405_t *sim, unsigned n)
 			if (sim->clk_div[2] >= 65536) {
 				scon_check (sim);
 
+				pce_stats_check();
+
 				if (sim->sync_time_base) {
 					s405_sync (sim);
 				}
@@ -721,6 +749,10 @@ void s405_clock (sim405_t *sim, unsigned n)
 		sim->serial_clock_count -= (ser << 4);
 	}
 
+	if (sim->prof.enabled) {
+		prof_add (&sim->prof, p405_get_pc (sim->ppc), n);
+	}
+
 	p405_clock (sim->ppc, n);
 
 	sim->clk_cnt += n;
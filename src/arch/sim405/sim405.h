@@ -56,6 +56,7 @@
 #include <devices/slip.h>
 
 #include <lib/brkpt.h>
+#include <lib/prof.h>
 #include <lib/log.h>
 #include <lib/inidsk.h>
 #include <lib/load.h>
@@ -122,6 +123,7 @@ typedef struct sim405_s {
 	slip_t             *slip;
 
 	bp_set_t           bps;
+	prof_t             prof;
 
 	/* OCM DCRs */
 	uint32_t           ocm0_iscntl;
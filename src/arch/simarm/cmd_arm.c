@@ -35,6 +35,8 @@
 #include <lib/console.h>
 #include <lib/log.h>
 #include <lib/monitor.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
@@ -44,8 +46,12 @@ static mon_cmd_t par_cmd[] = {
 	{ "g", "", "run" },
 	{ "key", "[val...]", "send keycodes to the serial console" },
 	{ "p", "[cnt]", "execute cnt instructions, skip calls [1]" },
+	{ "prof", "[on|off|clear]", "control the profiler" },
+	{ "prof", "[flat [cnt]|folded|save fname]", "print or save the profile" },
 	{ "r", "reg [val]", "get or set a register" },
 	{ "s", "[what]", "print status (cpu|intc|mem|mmu|timer)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
 	{ "u", "[addr [cnt]]", "disassemble" },
 	{ "x", "[c|r|v]", "set the translation mode (cpu, real, virtual)" },
@@ -767,12 +773,18 @@ int sarm_do_cmd (simarm_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "key")) {
 		do_key (cmd, sim);
 	}
+	else if (cmd_match (cmd, "prof")) {
+		prof_cmd (cmd, &sim->prof);
+	}
 	else if (cmd_match (cmd, "p")) {
 		do_p (cmd, sim);
 	}
 	else if (cmd_match (cmd, "r")) {
 		do_r (cmd, sim);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		do_s (cmd, sim);
 	}
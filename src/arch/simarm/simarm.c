@@ -41,6 +41,7 @@
 #include <lib/iniram.h>
 #include <lib/load.h>
 #include <lib/log.h>
+#include <lib/stats.h>
 #include <lib/msg.h>
 #include <lib/sysdep.h>
 
@@ -338,6 +339,25 @@ void sarm_setup_ata (simarm_t *sim, ini_sct_t *ini)
 	ini_get_pci_ata (&sim->pciata, sim->dsks, sct);
 }
 
+static
+void sarm_stats_update (void *ext)
+{
+	simarm_t *sim;
+
+	sim = ext;
+
+	pce_stats_set_sim (arm_get_opcnt (sim->cpu), sim->clk_cnt, 0);
+	pce_stats_set_disks (sim->dsks);
+
+	if (sim->serport[0] != NULL) {
+		pce_stats_set_chr ("ser0", sim->serport[0]->cdrv);
+	}
+
+	if (sim->serport[1] != NULL) {
+		pce_stats_set_chr ("ser1", sim->serport[1]->cdrv);
+	}
+}
+
 simarm_t *sarm_new (ini_sct_t *ini)
 {
 	unsigned i;
@@ -361,6 +381,7 @@ simarm_t *sarm_new (ini_sct_t *ini)
 	sim->cfg = ini;
 
 	bps_init (&sim->bps);
+	prof_init (&sim->prof);
 
 	sim->mem = mem_new();
 
@@ -378,6 +399,8 @@ simarm_t *sarm_new (ini_sct_t *ini)
 
 	pce_load_mem_ini (sim->mem, ini);
 
+	pce_stats_set_update_fct (sarm_stats_update, sim);
+
 	return (sim);
 }
 
@@ -387,6 +410,8 @@ void sarm_del (simarm_t *sim)
 		return;
 	}
 
+	pce_stats_set_update_fct (NULL, NULL);
+
 	pci_ata_free (&sim->pciata);
 	pci_ixp_del (sim->pci);
 
@@ -403,6 +428,7 @@ void sarm_del (simarm_t *sim)
 	mem_del (sim->mem);
 
 	bps_free (&sim->bps);
+	prof_free (&sim->prof);
 
 	free (sim);
 }
@@ -440,6 +466,10 @@ void sarm_clock (simarm_t *sim, unsigned n)
 {
 	unsigned long clk, rclk;
 
+	if (sim->prof.enabled) {
+		prof_add (&sim->prof, arm_get_pc (sim->cpu), n);
+	}
+
 	arm_clock (sim->cpu, n);
 
 	sim->clk_cnt += n;
@@ -488,6 +518,8 @@ void sarm_clock (simarm_t *sim, unsigned n)
 	sim->clk_div[2] &= 16383;
 
 	scon_check (sim);
+
+	pce_stats_check();
 }
 
 int sarm_set_msg (simarm_t *sim, const char *msg, const char *val)
@@ -47,6 +47,7 @@
 #include <libini/libini.h>
 
 #include <lib/brkpt.h>
+#include <lib/prof.h>
 
 
 /*****************************************************************************
@@ -73,6 +74,7 @@ typedef struct simarm_s {
 	ini_sct_t          *cfg;
 
 	bp_set_t           bps;
+	prof_t             prof;
 
 	int                bigendian;
 
@@ -29,9 +29,13 @@ static mon_cmd_t par_cmd[] = {
 	{ "g", "", "run" },
 	{ "key", "[val...]", "send keycodes to the serial console" },
 	{ "p", "[cnt]", "execute cnt instructions, skip calls [1]" },
+	{ "prof", "[on|off|clear]", "control the profiler" },
+	{ "prof", "[flat [cnt]|folded|save fname]", "print or save the profile" },
 	{ "rett", "", "execute to next rett" },
 	{ "r", "reg [val]", "get or set a register" },
 	{ "s", "[what]", "print status (cpu|mem)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
 	{ "u", "[addr [cnt]]", "disassemble" }
 };
@@ -566,6 +570,9 @@ int ss32_do_cmd (sims32_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "key")) {
 		do_key (cmd, sim);
 	}
+	else if (cmd_match (cmd, "prof")) {
+		prof_cmd (cmd, &sim->prof);
+	}
 	else if (cmd_match (cmd, "p")) {
 		do_p (cmd, sim);
 	}
@@ -575,6 +582,9 @@ int ss32_do_cmd (sims32_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "r")) {
 		do_r (cmd, sim);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		do_s (cmd, sim);
 	}
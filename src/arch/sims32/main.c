@@ -43,6 +43,8 @@ unsigned  par_sig_int = 0;
 
 ini_sct_t *par_cfg = NULL;
 
+static const char *par_prof = NULL;
+
 static monitor_t par_mon;
 
 
@@ -54,8 +56,11 @@ void prt_help (void)
 		"  --help                 Print usage information\n"
 		"  --version              Print version information\n"
 		"  -c, --config string    Set the config file\n"
+		"  -k, --config-cache string\n"
+		"                         Set the config cache file\n"
 		"  -l, --log string       Set the log file\n"
 		"  -p, --cpu string       Set the cpu model\n"
+		"  -P, --profile string   Profile guest code and save the profile\n"
 		"  -q, --quiet            Quiet operation [no]\n"
 		"  -r, --run              Start running immediately\n"
 		"  -v, --verbose          Verbose operation [no]\n",
@@ -210,6 +215,8 @@ int main (int argc, char *argv[])
 	pce_log_init();
 	pce_log_add_fp (stderr, 0, MSG_INF);
 
+	pce_stats_init();
+
 	par_cfg = ini_sct_new (NULL);
 
 	if (par_cfg == NULL) {
@@ -231,6 +238,13 @@ int main (int argc, char *argv[])
 			}
 			cfg = argv[i];
 		}
+		else if (str_isarg2 (argv[i], "-k", "--config-cache")) {
+			i += 1;
+			if (i >= argc) {
+				return (1);
+			}
+			pce_set_config_cache (argv[i]);
+		}
 		else if (str_isarg2 (argv[i], "-l", "--log")) {
 			i += 1;
 			if (i >= argc) {
@@ -246,6 +260,14 @@ int main (int argc, char *argv[])
 
 			par_cpu = argv[i];
 		}
+		else if (str_isarg2 (argv[i], "-P", "--profile")) {
+			i += 1;
+			if (i >= argc) {
+				return (1);
+			}
+
+			par_prof = argv[i];
+		}
 		else if (str_isarg2 (argv[i], "-r", "--run")) {
 			run = 1;
 		}
@@ -293,6 +315,10 @@ int main (int argc, char *argv[])
 	cmd_init (par_sim, cmd_get_sym, cmd_set_sym);
 	ss32_cmd_init (par_sim, &par_mon);
 
+	if (par_prof != NULL) {
+		par_sim->prof.enabled = 1;
+	}
+
 	ss32_reset (par_sim);
 
 	if (run) {
@@ -309,9 +335,18 @@ int main (int argc, char *argv[])
 		mon_run (&par_mon);
 	}
 
+	if (par_prof != NULL) {
+		if (prof_save (&par_sim->prof, par_prof)) {
+			fprintf (stderr, "%s: writing profile failed (%s)\n",
+				argv[0], par_prof
+			);
+		}
+	}
+
 	ss32_del (par_sim);
 
 	mon_free (&par_mon);
+	pce_stats_done();
 	pce_console_done();
 	pce_log_done();
 
@@ -123,6 +123,24 @@ void ss32_setup_serport (sims32_t *sim, ini_sct_t *ini)
 	}
 }
 
+static
+void ss32_stats_update (void *ext)
+{
+	sims32_t *sim;
+
+	sim = ext;
+
+	pce_stats_set_sim (s32_get_opcnt (sim->cpu), sim->clk_cnt, 0);
+
+	if (sim->serport[0] != NULL) {
+		pce_stats_set_chr ("ser0", sim->serport[0]->cdrv);
+	}
+
+	if (sim->serport[1] != NULL) {
+		pce_stats_set_chr ("ser1", sim->serport[1]->cdrv);
+	}
+}
+
 sims32_t *ss32_new (ini_sct_t *ini)
 {
 	unsigned i;
@@ -141,6 +159,7 @@ sims32_t *ss32_new (ini_sct_t *ini)
 	}
 
 	bps_init (&sim->bps);
+	prof_init (&sim->prof);
 
 	sim->mem = mem_new();
 
@@ -152,6 +171,8 @@ sims32_t *ss32_new (ini_sct_t *ini)
 
 	pce_load_mem_ini (sim->mem, ini);
 
+	pce_stats_set_update_fct (ss32_stats_update, sim);
+
 	return (sim);
 }
 
@@ -161,6 +182,8 @@ void ss32_del (sims32_t *sim)
 		return;
 	}
 
+	pce_stats_set_update_fct (NULL, NULL);
+
 	ser_del (sim->serport[1]);
 	ser_del (sim->serport[0]);
 
@@ -169,6 +192,7 @@ void ss32_del (sims32_t *sim)
 	mem_del (sim->mem);
 
 	bps_free (&sim->bps);
+	prof_free (&sim->prof);
 
 	free (sim);
 }
@@ -199,10 +223,15 @@ void ss32_clock (sims32_t *sim, unsigned n)
 {
 	if (sim->clk_div[0] >= 1024) {
 		scon_check (sim);
+		pce_stats_check();
 
 		sim->clk_div[0] &= 1023;
 	}
 
+	if (sim->prof.enabled) {
+		prof_add (&sim->prof, s32_get_pc (sim->cpu), n);
+	}
+
 	s32_clock (sim->cpu, n);
 
 	sim->clk_cnt += n;
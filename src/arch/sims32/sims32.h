@@ -74,6 +74,8 @@ void pce_dump_hex (FILE *fp, void *buf, unsigned long n,
 
 #include <lib/log.h>
 #include <lib/brkpt.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/load.h>
 
 
@@ -91,6 +93,7 @@ typedef struct sims32_s {
 	serport_t          *serport[2];
 
 	bp_set_t           bps;
+	prof_t             prof;
 
 	unsigned long long clk_cnt;
 	unsigned long      clk_div[4];
@@ -33,6 +33,7 @@
 #include <lib/console.h>
 #include <lib/log.h>
 #include <lib/monitor.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
@@ -48,7 +49,9 @@ static mon_cmd_t par_cmd[] = {
 	{ "o", "port val", "output a byte to a port" },
 	{ "p", "[cnt]", "execute cnt instructions, skip calls [1]" },
 	{ "r", "reg [val]", "set a register" },
-	{ "s", "[what]", "print status (cpu|mem)" },
+	{ "s", "[what]", "print status (cpu|mem|sys|video)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
 	{ "u", "[addr [cnt]]", "disassemble" },
 	{ "xl", "fname", "load a snapshot" },
@@ -318,6 +321,10 @@ void print_state_video (spectrum_t *sim)
 	pce_printf ("FRAME=%lu+%lu  ROW=%u+%u  COL=%u  DE=%d\n",
 		vid->frame_counter, vid->frame_clock, vid->row, vid->row_clock, 2 * vid->row_clock, vid->de
 	);
+
+	pce_printf ("RENDERED=%lu  DROPPED=%lu\n",
+		vid->frame.rendered, vid->frame.dropped
+	);
 }
 
 static
@@ -1067,6 +1074,9 @@ int spec_cmd (spectrum_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "r")) {
 		spec_cmd_r (cmd, sim);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		spec_cmd_s (cmd, sim);
 	}
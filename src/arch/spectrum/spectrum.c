@@ -52,6 +52,7 @@
 #include <lib/initerm.h>
 #include <lib/load.h>
 #include <lib/log.h>
+#include <lib/stats.h>
 #include <lib/msg.h>
 #include <lib/path.h>
 #include <lib/string.h>
@@ -363,10 +364,17 @@ void spec_setup_terminal (spectrum_t *sim, ini_sct_t *ini)
 static
 void spec_setup_video (spectrum_t *sim, ini_sct_t *ini)
 {
+	unsigned            max_fps, skip;
 	const unsigned char *vram;
+	ini_sct_t           *sct;
 
-	pce_log_tag (MSG_INF, "VIDEO:", "w=%u h=%u\n",
-		sim->video_w, sim->video_h
+	sct = ini_next_sct (ini, NULL, "system");
+
+	ini_get_uint16 (sct, "max_fps", &max_fps, 0);
+	ini_get_uint16 (sct, "frame_skip", &skip, 0);
+
+	pce_log_tag (MSG_INF, "VIDEO:", "w=%u h=%u max_fps=%u frame_skip=%u\n",
+		sim->video_w, sim->video_h, max_fps, skip
 	);
 
 	spec_video_init (&sim->video);
@@ -377,6 +385,8 @@ void spec_setup_video (spectrum_t *sim, ini_sct_t *ini)
 	spec_video_set_size (&sim->video, sim->video_w, sim->video_h);
 	spec_video_set_irq_fct (&sim->video, sim->cpu, e8080_set_int);
 
+	pce_frame_set_params (&sim->video.frame, max_fps, skip, 50);
+
 	if (sim->term != NULL) {
 		spec_video_set_terminal (&sim->video, sim->term, 1);
 	}
@@ -491,6 +501,18 @@ void spec_setup_snap (spectrum_t *sim, ini_sct_t *ini)
 	}
 }
 
+static
+void spec_stats_update (void *ext)
+{
+	spectrum_t *sim;
+
+	sim = ext;
+
+	pce_stats_set_sim (e8080_get_opcnt (sim->cpu), sim->clk_cnt, sim->clock_base);
+	pce_stats_set_trm (sim->term);
+	pce_stats_set_snd ("speaker", sim->spk.drv);
+}
+
 spectrum_t *spec_new (ini_sct_t *ini)
 {
 	spectrum_t *sim;
@@ -516,6 +538,8 @@ spectrum_t *spec_new (ini_sct_t *ini)
 	spec_reset (sim);
 	spec_setup_snap (sim, ini);
 
+	pce_stats_set_update_fct (spec_stats_update, sim);
+
 	return (sim);
 }
 
@@ -525,6 +549,8 @@ void spec_del (spectrum_t *sim)
 		return;
 	}
 
+	pce_stats_set_update_fct (NULL, NULL);
+
 	spk_free (&sim->spk);
 	cas_free (&sim->cas);
 	spec_video_free (&sim->video);
@@ -661,6 +687,8 @@ void spec_clock (spectrum_t *sim)
 
 		spk_check (&sim->spk);
 
+		pce_stats_check();
+
 		spec_realtime_sync (sim, 16384);
 
 		if (sim->term != NULL) {
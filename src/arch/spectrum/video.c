@@ -69,6 +69,8 @@ void spec_video_init (spec_video_t *vid)
 	vid->drop[0] = 0;
 	vid->drop[1] = 0;
 
+	pce_frame_init (&vid->frame);
+
 	vid->display_w = 256;
 	vid->display_h = 192;
 
@@ -214,12 +216,19 @@ void video_update (spec_video_t *vid)
 	const unsigned char *s, *p;
 	unsigned char       *d;
 	unsigned char       *rgb;
+	int                 render;
+
+	render = pce_frame_next (&vid->frame, vid->drop[0] == 0);
 
 	if (vid->drop[0] > 0) {
 		vid->drop[0] -= 1;
 		return;
 	}
 
+	if (render == 0) {
+		return;
+	}
+
 	vid->drop[0] = vid->drop[1];
 
 	w = vid->display_w;
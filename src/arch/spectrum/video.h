@@ -24,6 +24,7 @@
 #define PCE_SPECTRUM_VIDEO_H 1
 
 
+#include <devices/video/video.h>
 #include <drivers/video/terminal.h>
 
 
@@ -39,6 +40,8 @@ typedef struct {
 	unsigned            flash;
 	unsigned            drop[2];
 
+	pce_frame_t         frame;
+
 	unsigned            display_w;
 	unsigned            display_h;
 
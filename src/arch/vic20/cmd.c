@@ -29,6 +29,8 @@
 #include <lib/console.h>
 #include <lib/log.h>
 #include <lib/monitor.h>
+#include <lib/prof.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
@@ -38,8 +40,12 @@ static mon_cmd_t par_cmd[] = {
 	{ "g", "", "run" },
 	{ "hm", "", "print help on messages" },
 	{ "p", "[cnt]", "execute cnt instructions, skip calls [1]" },
+	{ "prof", "[on|off|clear]", "control the profiler" },
+	{ "prof", "[flat [cnt]|folded|save fname]", "print or save the profile" },
 	{ "r", "reg [val]", "get or set a register" },
 	{ "s", "[what]", "print status (cpu|mem)" },
+	{ "stats", "[prefix]", "print performance counters" },
+	{ "stats", "clear|dump fname [ms]|dump off", "clear or periodically dump performance counters" },
 	{ "trace", "[on|off|expr]", "turn trace on or off" },
 	{ "t", "[cnt]", "execute cnt instructions [1]" },
 	{ "u", "[addr [cnt]]", "disassemble" },
@@ -314,7 +320,7 @@ void v20_run (vic20_t *sim)
 	v20_clock_resync (sim);
 
 	while (1) {
-		v20_clock (sim);
+		v20_clock_insn (sim);
 
 		if (sim->brk) {
 			break;
@@ -776,12 +782,18 @@ int v20_cmd (vic20_t *sim, cmd_t *cmd)
 	else if (cmd_match (cmd, "n")) {
 		v20_cmd_n (cmd, sim);
 	}
+	else if (cmd_match (cmd, "prof")) {
+		prof_cmd (cmd, &sim->prof);
+	}
 	else if (cmd_match (cmd, "p")) {
 		v20_cmd_p (cmd, sim);
 	}
 	else if (cmd_match (cmd, "r")) {
 		v20_cmd_r (cmd, sim);
 	}
+	else if (cmd_match (cmd, "stats")) {
+		pce_stats_cmd (cmd);
+	}
 	else if (cmd_match (cmd, "s")) {
 		v20_cmd_s (cmd, sim);
 	}
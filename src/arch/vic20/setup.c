@@ -45,6 +45,7 @@
 #include <lib/initerm.h>
 #include <lib/load.h>
 #include <lib/log.h>
+#include <lib/stats.h>
 
 #include <libini/libini.h>
 
@@ -297,6 +298,18 @@ void v20_set_memmap (vic20_t *sim)
 	}
 }
 
+static
+void v20_stats_update (void *ext)
+{
+	vic20_t *sim;
+
+	sim = ext;
+
+	pce_stats_set_sim (e6502_get_opcnt (sim->cpu), e6502_get_clock (sim->cpu), sim->clock);
+	pce_stats_set_trm (sim->trm);
+	pce_stats_set_snd ("sound", sim->video.snd);
+}
+
 vic20_t *v20_new (ini_sct_t *ini)
 {
 	vic20_t *sim;
@@ -315,6 +328,7 @@ vic20_t *v20_new (ini_sct_t *ini)
 	sim->clk_div = 0;
 
 	bps_init (&sim->bps);
+	prof_init (&sim->prof);
 
 	v20_setup_vic20 (sim, ini);
 	v20_setup_mem (sim, ini);
@@ -332,6 +346,8 @@ vic20_t *v20_new (ini_sct_t *ini)
 
 	/* v20_debug_mem (sim); */
 
+	pce_stats_set_update_fct (v20_stats_update, sim);
+
 	return (sim);
 }
 
@@ -341,6 +357,8 @@ void v20_del (vic20_t *sim)
 		return;
 	}
 
+	pce_stats_set_update_fct (NULL, NULL);
+
 	cas_free (&sim->cas);
 
 	v20_video_free (&sim->video);
@@ -355,6 +373,7 @@ void v20_del (vic20_t *sim)
 	mem_del (sim->mem);
 
 	bps_free (&sim->bps);
+	prof_free (&sim->prof);
 
 	free (sim);
 }
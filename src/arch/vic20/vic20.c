@@ -38,6 +38,7 @@
 #include <devices/cassette.h>
 
 #include <lib/log.h>
+#include <lib/stats.h>
 #include <lib/sysdep.h>
 
 
@@ -363,15 +364,21 @@ void v20_clock_sync (vic20_t *sim, unsigned long n)
 	}
 }
 
-void v20_clock (vic20_t *sim)
+static
+void v20_clock_devices (vic20_t *sim, unsigned n)
 {
-	e6502_clock (sim->cpu, 1);
-	e6560_clock (&sim->video.vic);
-	e6522_clock (&sim->via1, 1);
-	e6522_clock (&sim->via2, 1);
-	cas_clock (&sim->cas);
+	unsigned i;
+
+	e6560_clock (&sim->video.vic, n);
 
-	sim->clk_div += 1;
+	e6522_clock (&sim->via1, n);
+	e6522_clock (&sim->via2, n);
+
+	for (i = 0; i < n; i++) {
+		cas_clock (&sim->cas);
+	}
+
+	sim->clk_div += n;
 
 	if (sim->clk_div < 4096) {
 		return;
@@ -383,5 +390,43 @@ void v20_clock (vic20_t *sim)
 		trm_check (sim->trm);
 	}
 
+	pce_stats_check();
+
 	v20_clock_sync (sim, 4096);
 }
+
+void v20_clock (vic20_t *sim)
+{
+	if (sim->prof.enabled) {
+		prof_add (&sim->prof, e6502_get_pc (sim->cpu), 1);
+	}
+
+	e6502_clock (sim->cpu, 1);
+
+	v20_clock_devices (sim, 1);
+}
+
+void v20_clock_insn (vic20_t *sim)
+{
+	unsigned long n;
+
+	if (sim->prof.enabled) {
+		prof_add (&sim->prof, e6502_get_pc (sim->cpu), 1);
+	}
+
+	e6502_clock (sim->cpu, 1);
+
+	/* the cycles until the cpu executes its next instruction */
+	n = e6502_get_delay (sim->cpu);
+	n = (n > 1) ? (n - 1) : 0;
+
+	if (n > 0) {
+		if (sim->prof.enabled) {
+			prof_add (&sim->prof, e6502_get_pc (sim->cpu), n);
+		}
+
+		e6502_clock (sim->cpu, n);
+	}
+
+	v20_clock_devices (sim, n + 1);
+}
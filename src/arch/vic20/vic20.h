@@ -39,6 +39,7 @@
 #include <drivers/video/terminal.h>
 
 #include <lib/brkpt.h>
+#include <lib/prof.h>
 
 #include <libini/libini.h>
 
@@ -52,6 +53,7 @@ typedef struct vic20_s {
 	memory_t      *mem;
 	terminal_t    *trm;
 	bp_set_t      bps;
+	prof_t        prof;
 	vic20_video_t video;
 	e6522_t       via1;
 	e6522_t       via2;
@@ -129,5 +131,14 @@ void v20_clock_resync (vic20_t *sim);
 
 void v20_clock (vic20_t *sim);
 
+/*****************************************************************************
+ * @short Clock the machine up to the start of the next CPU instruction
+ *
+ * The CPU only interacts with the other devices when it executes an
+ * instruction, so the devices are clocked in one go for all cycles in
+ * between. The result is the same as calling v20_clock() once per cycle.
+ *****************************************************************************/
+void v20_clock_insn (vic20_t *sim);
+
 
 #endif
@@ -26,6 +26,9 @@
 #include "e8237.h"
 
 
+#define E8237_BLOCK_MAX 256
+
+
 static void e8237_chn_set_dack (e8237_chn_t *chn, unsigned char val);
 static void e8237_chn_set_tc (e8237_chn_t *chn, unsigned char val);
 static void e8237_set_hreq (e8237_t *dma, unsigned char val);
@@ -64,6 +67,11 @@ void e8237_chn_init (e8237_chn_t *chn, e8237_t *dma)
 
 	chn->iord_ext = NULL;
 	chn->iord = NULL;
+
+	chn->memwr_buf = NULL;
+	chn->memrd_buf = NULL;
+	chn->iowr_buf = NULL;
+	chn->iord_buf = NULL;
 }
 
 static
@@ -293,6 +301,97 @@ int e8237_chn_transfer (e8237_chn_t *chn)
 	return (1);
 }
 
+/*
+ * Transfer up to *cnt bytes using the block transfer functions. On
+ * return, *cnt is the number of bytes transferred, or 0 if the block
+ * transfer functions can't be used.
+ */
+static
+int e8237_chn_transfer_block (e8237_chn_t *chn, unsigned *cnt)
+{
+	unsigned      n;
+	unsigned char buf[E8237_BLOCK_MAX];
+
+	n = *cnt;
+	*cnt = 0;
+
+	if ((chn->mode & E8237_MODE_MODE) == E8237_MODE_CASCADE) {
+		return (0);
+	}
+
+	if (chn->mode & E8237_MODE_ADDRDEC) {
+		return (0);
+	}
+
+	switch (chn->mode & E8237_MODE_TYPE) {
+	case E8237_MODE_READ:
+		if ((chn->memrd_buf == NULL) || (chn->iowr_buf == NULL)) {
+			return (0);
+		}
+		break;
+
+	case E8237_MODE_WRITE:
+		if ((chn->iord_buf == NULL) || (chn->memwr_buf == NULL)) {
+			return (0);
+		}
+		break;
+
+	default:
+		return (0);
+	}
+
+	if (n > E8237_BLOCK_MAX) {
+		n = E8237_BLOCK_MAX;
+	}
+
+	if (n > (chn->cur_cnt + 1UL)) {
+		n = chn->cur_cnt + 1UL;
+	}
+
+	/* the address must not wrap around */
+	if (n > (0x10000UL - chn->cur_addr)) {
+		n = 0x10000UL - chn->cur_addr;
+	}
+
+	if (n < 2) {
+		return (0);
+	}
+
+	e8237_chn_set_dack (chn, 1);
+
+	if ((chn->mode & E8237_MODE_TYPE) == E8237_MODE_READ) {
+		chn->memrd_buf (chn->memrd_ext, chn->cur_addr, buf, n);
+		n = chn->iowr_buf (chn->iowr_ext, buf, n);
+	}
+	else {
+		n = chn->iord_buf (chn->iord_ext, buf, n);
+
+		if (n > 0) {
+			chn->memwr_buf (chn->memwr_ext, chn->cur_addr, buf, n);
+		}
+	}
+
+	if (n == 0) {
+		return (0);
+	}
+
+	*cnt = n;
+
+	chn->cur_addr = (chn->cur_addr + n) & 0xffff;
+	chn->cur_cnt = (chn->cur_cnt - n) & 0xffff;
+
+	if (chn->cur_cnt == 0xffff) {
+		e8237_chn_tc (chn);
+		return (1);
+	}
+
+	if ((chn->mode & E8237_MODE_MODE) == E8237_MODE_BLOCK) {
+		return (0);
+	}
+
+	return (1);
+}
+
 static
 void e8237_chn_set_dreq (e8237_chn_t *chn, unsigned char val)
 {
@@ -678,16 +777,50 @@ void e8237_reset (e8237_t *dma)
 	e8237_set_hreq (dma, 0);
 }
 
+/*
+ * Check if channel idx is the only channel requesting service
+ */
+static
+int e8237_single_request (e8237_t *dma, unsigned idx)
+{
+	unsigned    i;
+	e8237_chn_t *chn;
+
+	for (i = 0; i < 4; i++) {
+		if (i == idx) {
+			continue;
+		}
+
+		chn = &dma->chn[i];
+
+		if ((chn->state & E8237_STATE_MASK) == 0) {
+			if (chn->state & (E8237_STATE_DREQ | E8237_STATE_SREQ)) {
+				return (0);
+			}
+		}
+	}
+
+	return (1);
+}
+
+/*
+ * Service the pending requests for up to max clock cycles and return
+ * the number of clock cycles used
+ */
 static
-void e8237_check (e8237_t *dma)
+unsigned e8237_check (e8237_t *dma, unsigned max)
 {
 	unsigned    i, j;
+	unsigned    cnt;
+	int         r;
 	e8237_chn_t *chn;
 
 	dma->check = 0;
 
 	j = dma->priority;
 
+	cnt = 1;
+
 	for (i = 0; i < 4; i++) {
 		chn = &dma->chn[j];
 
@@ -698,10 +831,27 @@ void e8237_check (e8237_t *dma)
 				e8237_set_hreq (dma, 1);
 
 				if (dma->hlda_val == 0) {
-					return;
+					return (1);
+				}
+
+				/*
+				 * If no other channel is requesting service, one
+				 * byte per clock cycle is transferred. This can be
+				 * done in a single block.
+				 */
+				cnt = 0;
+
+				if ((max > 1) && e8237_single_request (dma, j)) {
+					cnt = max;
+					r = e8237_chn_transfer_block (chn, &cnt);
+				}
+
+				if (cnt == 0) {
+					cnt = 1;
+					r = e8237_chn_transfer (chn);
 				}
 
-				if (e8237_chn_transfer (chn)) {
+				if (r) {
 					e8237_set_hreq (dma, 0);
 
 					if (dma->cmd & E8237_CMD_ROTPRI) {
@@ -721,6 +871,8 @@ void e8237_check (e8237_t *dma)
 	}
 
 	e8237_set_hreq (dma, 0);
+
+	return (cnt);
 }
 
 void e8237_clock (e8237_t *dma, unsigned n)
@@ -734,8 +886,6 @@ void e8237_clock (e8237_t *dma, unsigned n)
 			return;
 		}
 
-		e8237_check (dma);
-
-		n -= 1;
+		n -= e8237_check (dma, n);
 	}
 }
@@ -89,6 +89,17 @@ typedef struct {
 
 	void           *iord_ext;
 	unsigned char  (*iord) (void *ext);
+
+	/*
+	 * Optional block transfer functions. They use the same ext
+	 * pointers as the single byte functions above. iord_buf and
+	 * iowr_buf return the number of bytes transferred and must stop
+	 * after a byte that changes the device state (e.g. drops DREQ).
+	 */
+	void           (*memwr_buf) (void *ext, unsigned long addr, const void *buf, unsigned cnt);
+	void           (*memrd_buf) (void *ext, unsigned long addr, void *buf, unsigned cnt);
+	unsigned       (*iowr_buf) (void *ext, const unsigned char *buf, unsigned cnt);
+	unsigned       (*iord_buf) (void *ext, unsigned char *buf, unsigned cnt);
 } e8237_chn_t;
 
 
@@ -965,8 +965,31 @@ void e6522_clock_t2 (e6522_t *via)
 
 void e6522_clock (e6522_t *via, unsigned n)
 {
-	while (n-- > 0) {
-		e6522_clock_t1 (via);
-		e6522_clock_t2 (via);
+	unsigned m;
+
+	while (n > 0) {
+		if (via->t1_reload || via->t1_timeout || via->t2_timeout) {
+			e6522_clock_t1 (via);
+			e6522_clock_t2 (via);
+			n -= 1;
+			continue;
+		}
+
+		/* skip ahead to one clock before the next timer reaches 0 */
+		m = (via->t1_val < via->t2_val) ? via->t1_val : via->t2_val;
+
+		if (m < 2) {
+			e6522_clock_t1 (via);
+			e6522_clock_t2 (via);
+			n -= 1;
+			continue;
+		}
+
+		m = (n < (m - 1)) ? n : (m - 1);
+
+		via->t1_val -= m;
+		via->t2_val -= m;
+
+		n -= m;
 	}
 }
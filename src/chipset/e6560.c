@@ -22,10 +22,24 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "e6560.h"
 
 
+static
+void vic_init_tables (e6560_t *vic)
+{
+	unsigned i, j;
+
+	for (i = 0; i < 256; i++) {
+		for (j = 0; j < 8; j++) {
+			vic->hires[i][j] = (i >> (7 - j)) & 1;
+			vic->multi[i][j] = (i >> (6 - (j & 6))) & 3;
+		}
+	}
+}
+
 void e6560_init (e6560_t *vic)
 {
 	unsigned i;
@@ -45,6 +59,8 @@ void e6560_init (e6560_t *vic)
 
 	vic->colram = NULL;
 
+	vic->wr_cnt = 0;
+
 	vic->w = 260;
 	vic->h = 261;
 
@@ -52,6 +68,8 @@ void e6560_init (e6560_t *vic)
 
 	vic->ptr = vic->buf;
 
+	vic_init_tables (vic);
+
 	vic->snd_enable = 0;
 	vic->snd_rem = 0;
 
@@ -278,45 +296,32 @@ void vic_update_line (e6560_t *vic)
 static
 void vic_update_colmap (e6560_t *vic)
 {
-	vic->reverse = (vic->reg[15] >> 3) & 1;
+	vic->reverse = (vic->vreg[15] >> 3) & 1;
 
 	vic->colmap1[vic->reverse] = 0;
-	vic->colmap1[vic->reverse ^ 1] = (vic->reg[15] >> 4) & 0x0f;
+	vic->colmap1[vic->reverse ^ 1] = (vic->vreg[15] >> 4) & 0x0f;
 
-	vic->colmap2[0] = (vic->reg[15] >> 4) & 0x0f;
-	vic->colmap2[1] = vic->reg[15] & 0x07;
+	vic->colmap2[0] = (vic->vreg[15] >> 4) & 0x0f;
+	vic->colmap2[1] = vic->vreg[15] & 0x07;
 	vic->colmap2[2] = 0;
-	vic->colmap2[3] = (vic->reg[14] >> 4) & 0x0f;
+	vic->colmap2[3] = (vic->vreg[14] >> 4) & 0x0f;
 }
 
 static
 void vic_update_vaddr (e6560_t *vic)
 {
-	vic->vbase = (vic->reg[5] << 6) & 0x3c00;
-	vic->vbase |= (vic->reg[2] << 2) & 0x200;
-	vic->cbase = (vic->reg[5] << 10) & 0x3c00;
-}
-
-unsigned char e6560_get_reg (e6560_t *vic, unsigned long addr)
-{
-	if ((addr == 3) || (addr == 4)) {
-		vic_update_line (vic);
-	}
-
-	if (addr < 16) {
-		return (vic->reg[addr]);
-	}
-
-	return (0xaa);
+	vic->vbase = (vic->vreg[5] << 6) & 0x3c00;
+	vic->vbase |= (vic->vreg[2] << 2) & 0x200;
+	vic->cbase = (vic->vreg[5] << 10) & 0x3c00;
 }
 
-void e6560_set_reg (e6560_t *vic, unsigned long addr, unsigned char val)
+/*
+ * Apply a register write to the renderer state
+ */
+static
+void vic_apply_reg (e6560_t *vic, unsigned addr, unsigned char val)
 {
-	if (addr >= 16) {
-		return;
-	}
-
-	vic->reg[addr] = val;
+	vic->vreg[addr] = val;
 
 	if (addr == 0) {
 		vic->start_x = (val & 0x7f) << 2;
@@ -338,10 +343,186 @@ void e6560_set_reg (e6560_t *vic, unsigned long addr, unsigned char val)
 	if ((addr == 14) || (addr == 15)) {
 		vic_update_colmap (vic);
 	}
+}
+
+static
+unsigned char vic_fetch_data (e6560_t *vic, unsigned addr)
+{
+	const unsigned char *ptr;
+
+	ptr = vic->memmap[(addr & 16383) >> 8];
+
+	if (ptr != NULL) {
+		return (ptr[addr & 0xff]);
+	}
+
+	return (0);
+}
+
+static
+unsigned char vic_fetch_color (e6560_t *vic, unsigned addr)
+{
+	if (vic->colram == NULL) {
+		return (0);
+	}
+
+	return (vic->colram[addr & 0x3ff]);
+}
+
+static
+void vic_fetch_char (e6560_t *vic)
+{
+	vic->chr = vic_fetch_data (vic, vic->vbase + vic->addr2);
+	vic->color = vic_fetch_color (vic, vic->vbase + vic->addr2);
+
+	vic->next = 1;
+	vic->addr2 += 1;
+}
+
+/*
+ * Draw one line of one character
+ */
+static
+void vic_render_char (e6560_t *vic)
+{
+	unsigned            addr;
+	unsigned char       val;
+	unsigned char       *map, *p;
+	const unsigned char *tab;
+
+	addr = vic->cbase + (vic->chr << vic->line_shift) + vic->line;
+	val = vic_fetch_data (vic, addr);
+
+	if (vic->color & 0x08) {
+		map = vic->colmap2;
+		map[2] = vic->color & 7;
+		tab = vic->multi[val];
+	}
+	else {
+		map = vic->colmap1;
+		map[vic->reverse] = vic->color & 7;
+		tab = vic->hires[val];
+	}
+
+	p = vic->ptr;
+
+	p[0] = map[tab[0]];
+	p[1] = map[tab[1]];
+	p[2] = map[tab[2]];
+	p[3] = map[tab[3]];
+	p[4] = map[tab[4]];
+	p[5] = map[tab[5]];
+	p[6] = map[tab[6]];
+	p[7] = map[tab[7]];
+
+	vic->ptr += 8;
+
+	vic->next = 0;
+	vic->col += 1;
+	vic->col_cnt -= 1;
+}
+
+/*
+ * Draw the current line up to pixel x
+ */
+static
+void vic_render (e6560_t *vic, unsigned x)
+{
+	unsigned end;
+
+	while (vic->rx < x) {
+		if (vic->rx == vic->start_x) {
+			vic->col_cnt = vic->vreg[2] & 0x7f;
+		}
+
+		if ((vic->col_cnt == 0) || (vic->row_cnt == 0)) {
+			/* in border */
+
+			end = x;
+
+			if ((vic->start_x > vic->rx) && (vic->start_x < end)) {
+				end = vic->start_x;
+			}
+
+			memset (vic->ptr, vic->vreg[15] & 7, end - vic->rx);
+
+			vic->ptr += end - vic->rx;
+			vic->rx = end;
+
+			continue;
+		}
+
+		if (vic->next == 0) {
+			vic_fetch_char (vic);
+
+			vic->rx += 4;
+
+			if ((vic->rx >= x) || (vic->rx == vic->start_x)) {
+				continue;
+			}
+		}
+
+		vic_render_char (vic);
+
+		vic->rx += 4;
+	}
+}
+
+/*
+ * Draw the current line up to the last buffered register write
+ */
+static
+void vic_render_wr (e6560_t *vic)
+{
+	unsigned   i;
+	e6560_wr_t *wr;
+
+	for (i = 0; i < vic->wr_cnt; i++) {
+		wr = vic->wr + i;
+
+		vic_render (vic, wr->x);
+		vic_apply_reg (vic, wr->reg, wr->val);
+	}
+
+	vic->wr_cnt = 0;
+}
+
+unsigned char e6560_get_reg (e6560_t *vic, unsigned long addr)
+{
+	if ((addr == 3) || (addr == 4)) {
+		vic_update_line (vic);
+	}
+
+	if (addr < 16) {
+		return (vic->reg[addr]);
+	}
+
+	return (0xaa);
+}
+
+void e6560_set_reg (e6560_t *vic, unsigned long addr, unsigned char val)
+{
+	if (addr >= 16) {
+		return;
+	}
+
+	vic->reg[addr] = val;
 
 	if ((addr >= 10) && (addr <= 13)) {
 		vic_sound_enable (vic, addr - 10, vic->reg[addr]);
+		return;
 	}
+
+	/* the line is drawn when it ends, remember when the write happened */
+
+	if (vic->wr_cnt >= E6560_WR_MAX) {
+		vic_render_wr (vic);
+	}
+
+	vic->wr[vic->wr_cnt].x = vic->x;
+	vic->wr[vic->wr_cnt].reg = addr;
+	vic->wr[vic->wr_cnt].val = val;
+	vic->wr_cnt += 1;
 }
 
 void e6560_reset (e6560_t *vic)
@@ -350,10 +531,14 @@ void e6560_reset (e6560_t *vic)
 
 	for (i = 0; i < 16; i++) {
 		vic->reg[i] = 0;
+		vic->vreg[i] = 0;
 	}
 
+	vic->wr_cnt = 0;
+
 	vic->x = 0;
 	vic->y = 0;
+	vic->rx = 0;
 
 	vic->start_x = 0;
 	vic->start_y = 0;
@@ -395,117 +580,19 @@ void e6560_reset (e6560_t *vic)
 	}
 }
 
-static
-unsigned char vic_fetch_data (e6560_t *vic, unsigned addr)
-{
-	const unsigned char *ptr;
-
-	ptr = vic->memmap[(addr & 16383) >> 8];
-
-	if (ptr != NULL) {
-		return (ptr[addr & 0xff]);
-	}
-
-	return (0);
-}
 
 static
-unsigned char vic_fetch_color (e6560_t *vic, unsigned addr)
-{
-	if (vic->colram == NULL) {
-		return (0);
-	}
-
-	return (vic->colram[addr & 0x3ff]);
-}
-
-static
-void e6560_clock_char (e6560_t *vic)
-{
-	unsigned      i;
-	unsigned      addr;
-	unsigned char val, col;
-	unsigned char *map;
-
-	if ((vic->col_cnt == 0) || (vic->row_cnt == 0)) {
-		/* in border */
-
-		val = vic->reg[15] & 7;
-
-		for (i = 0; i < 4; i++) {
-			*(vic->ptr++) = val;
-		}
-
-		return;
-	}
-
-	if (vic->next == 0) {
-		/* fetch character code */
-
-		vic->chr = vic_fetch_data (vic, vic->vbase + vic->addr2);
-		vic->color = vic_fetch_color (vic, vic->vbase + vic->addr2);
-
-		vic->next = 1;
-		vic->addr2 += 1;
-
-		return;
-	}
-
-	/* update one line of one character */
-
-	addr = vic->cbase + (vic->chr << vic->line_shift) + vic->line;
-	val = vic_fetch_data (vic, addr);
-
-	vic->next = 0;
-	vic->col += 1;
-	vic->col_cnt -= 1;
-
-	if (vic->color & 0x08) {
-		map = vic->colmap2;
-		map[2] = vic->color & 7;
-
-		for (i = 0; i < 4; i++) {
-			col = map[(val >> 6) & 3];
-			*(vic->ptr++) = col;
-			*(vic->ptr++) = col;
-			val <<= 2;
-		}
-	}
-	else {
-		map = vic->colmap1;
-		map[vic->reverse] = vic->color & 7;
-
-		for (i = 0; i < 8; i++) {
-			*(vic->ptr++) = map[(val >> 7) & 1];
-			val <<= 1;
-		}
-	}
-}
-
-void e6560_clock (e6560_t *vic)
+void vic_line_end (e6560_t *vic)
 {
-	if (vic->snd_rem > 0) {
-		vic_sound_clock (vic);
-		vic_sound_out (vic);
-	}
-
-	if (vic->x == vic->start_x) {
-		vic->col_cnt = vic->reg[2] & 0x7f;
-	}
-
-	e6560_clock_char (vic);
-
-	vic->x += 4;
-
-	if (vic->x < vic->w) {
-		return;
-	}
+	vic_render_wr (vic);
+	vic_render (vic, vic->w);
 
 	if (vic->hsync != NULL) {
 		vic->hsync (vic->hsync_ext, vic->y, vic->w, vic->buf);
 	}
 
 	vic->x = 0;
+	vic->rx = 0;
 	vic->next = 0;
 	vic->ptr = vic->buf;
 	vic->col = 0;
@@ -532,7 +619,7 @@ void e6560_clock (e6560_t *vic)
 	if (vic->y == vic->start_y) {
 		vic->row = 0;
 		vic->line = 0;
-		vic->row_cnt = (vic->reg[3] >> 1) & 0x3f;
+		vic->row_cnt = (vic->vreg[3] >> 1) & 0x3f;
 		vic->addr1 = 0;
 		vic->addr2 = 0;
 	}
@@ -553,3 +640,33 @@ void e6560_clock (e6560_t *vic)
 	vic->addr2 = 0;
 	vic->frame += 1;
 }
+
+void e6560_clock (e6560_t *vic, unsigned cnt)
+{
+	unsigned n;
+
+	while (cnt > 0) {
+		/* the number of clocks until the end of the line */
+		n = (vic->x < vic->w) ? ((vic->w - vic->x) / 4) : 1;
+
+		if (n > cnt) {
+			n = cnt;
+		}
+
+		while ((vic->snd_rem > 0) && (n > 0)) {
+			vic_sound_clock (vic);
+			vic_sound_out (vic);
+
+			vic->x += 4;
+			cnt -= 1;
+			n -= 1;
+		}
+
+		vic->x += 4 * n;
+		cnt -= n;
+
+		if (vic->x >= vic->w) {
+			vic_line_end (vic);
+		}
+	}
+}
@@ -30,6 +30,10 @@
 #include <stdint.h>
 
 
+/* the maximum number of register writes buffered per line */
+#define E6560_WR_MAX 64
+
+
 typedef struct {
 	unsigned long cnt;
 	unsigned long div;
@@ -37,6 +41,14 @@ typedef struct {
 } e6560_chn_t;
 
 
+/* a register write, to be applied when the line is drawn */
+typedef struct {
+	unsigned short x;
+	unsigned char  reg;
+	unsigned char  val;
+} e6560_wr_t;
+
+
 typedef struct {
 	void *hsync_ext;
 	void (*hsync) (void *ext, unsigned y, unsigned w, const unsigned char *buf);
@@ -52,11 +64,18 @@ typedef struct {
 
 	unsigned char reg[16];
 
+	/* the registers as seen by the renderer */
+	unsigned char vreg[16];
+
+	unsigned      wr_cnt;
+	e6560_wr_t    wr[E6560_WR_MAX];
+
 	unsigned      w;
 	unsigned      h;
 
 	unsigned      x;
 	unsigned      y;
+	unsigned      rx;
 	unsigned      start_x;
 	unsigned      start_y;
 
@@ -85,6 +104,10 @@ typedef struct {
 	unsigned char colmap1[2];
 	unsigned char colmap2[4];
 
+	/* glyph to color index expansion tables */
+	unsigned char hires[256][8];
+	unsigned char multi[256][8];
+
 	unsigned char *ptr;
 	unsigned char buf[284];
 
@@ -125,7 +148,7 @@ void e6560_set_reg (e6560_t *vic, unsigned long addr, unsigned char val);
 
 void e6560_reset (e6560_t *vic);
 
-void e6560_clock (e6560_t *vic);
+void e6560_clock (e6560_t *vic, unsigned cnt);
 
 
 #endif
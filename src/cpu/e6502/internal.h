@@ -49,11 +49,11 @@
 
 
 #define e6502_get_idx_ind_x(c) e6502_get_mem8 (c, e6502_get_ea_idx_ind_x (c))
-#define e6502_get_zpg(c) e6502_get_mem8 (c, e6502_get_ea_zpg (c))
+#define e6502_get_zpg(c) e6502_get_zpg8 (c, e6502_get_ea_zpg (c))
 #define e6502_get_abs(c) e6502_get_mem8 (c, e6502_get_ea_abs (c))
 #define e6502_get_ind_idx_y(c) e6502_get_mem8 (c, e6502_get_ea_ind_idx_y (c))
-#define e6502_get_zpg_x(c) e6502_get_mem8 (c, e6502_get_ea_zpg_x (c))
-#define e6502_get_zpg_y(c) e6502_get_mem8 (c, e6502_get_ea_zpg_y (c))
+#define e6502_get_zpg_x(c) e6502_get_zpg8 (c, e6502_get_ea_zpg_x (c))
+#define e6502_get_zpg_y(c) e6502_get_zpg8 (c, e6502_get_ea_zpg_y (c))
 #define e6502_get_abs_y(c) e6502_get_mem8 (c, e6502_get_ea_abs_y (c))
 #define e6502_get_abs_x(c) e6502_get_mem8 (c, e6502_get_ea_abs_x (c))
 #define e6502_set_ea(c, v) e6502_set_mem8 ((c), (c)->ea, (v))
@@ -64,15 +64,178 @@ int e6502_hook_undefined (e6502_t *c);
 int e6502_hook_brk (e6502_t *c);
 
 
-unsigned char e6502_get_imm (e6502_t *c);
-unsigned short e6502_get_ea_idx_ind_x (e6502_t *c);
-unsigned short e6502_get_ea_zpg (e6502_t *c);
-unsigned short e6502_get_ea_abs (e6502_t *c);
-unsigned short e6502_get_ea_ind_idx_y (e6502_t *c);
-unsigned short e6502_get_ea_zpg_x (e6502_t *c);
-unsigned short e6502_get_ea_zpg_y (e6502_t *c);
-unsigned short e6502_get_ea_abs_y (e6502_t *c);
-unsigned short e6502_get_ea_abs_x (e6502_t *c);
+/*
+ * Zero page and stack accesses go straight to the first two pages of the
+ * memory map. Only the I/O port at addresses 0 and 1 needs special care.
+ */
+static inline
+unsigned char e6502_get_zpg8 (e6502_t *c, unsigned char addr)
+{
+	const unsigned char *p;
+
+	if ((p = c->mem_map_rd[0]) != NULL) {
+		if ((addr >= 2) || ((c->flags & E6502_FLAG_IOPORT) == 0)) {
+			return (p[addr]);
+		}
+	}
+
+	return (e6502_get_mem8 (c, addr));
+}
+
+static inline
+unsigned char e6502_get_stk8 (e6502_t *c, unsigned char addr)
+{
+	const unsigned char *p;
+
+	if ((p = c->mem_map_rd[0x100 >> E6502_MAP_BITS]) != NULL) {
+		return (p[(0x100 + addr) & E6502_MAP_MASK]);
+	}
+
+	return (e6502_get_mem8 (c, 0x100 + addr));
+}
+
+static inline
+void e6502_set_stk8 (e6502_t *c, unsigned char addr, unsigned char val)
+{
+	unsigned char *p;
+
+	if ((p = c->mem_map_wr[0x100 >> E6502_MAP_BITS]) != NULL) {
+		p[(0x100 + addr) & E6502_MAP_MASK] = val;
+	}
+	else {
+		e6502_set_mem8 (c, 0x100 + addr, val);
+	}
+}
+
+
+static inline
+unsigned char e6502_get_imm (e6502_t *c)
+{
+	e6502_get_inst1 (c);
+
+	c->ea_page = 0;
+
+	return (c->inst[1]);
+}
+
+static inline
+unsigned short e6502_get_ea_idx_ind_x (e6502_t *c)
+{
+	unsigned ial, adl, adh;
+
+	e6502_get_inst1 (c);
+
+	ial = c->inst[1];
+	ial = (ial + e6502_get_x (c)) & 0xff;
+
+	adl = e6502_get_zpg8 (c, ial);
+	adh = e6502_get_zpg8 (c, (ial + 1) & 0xff);
+
+	c->ea = (adh << 8) | adl;
+	c->ea_page = 0;
+
+	return (c->ea);
+}
+
+static inline
+unsigned short e6502_get_ea_zpg (e6502_t *c)
+{
+	e6502_get_inst1 (c);
+
+	c->ea = c->inst[1];
+	c->ea_page = 0;
+
+	return (c->ea);
+}
+
+static inline
+unsigned short e6502_get_ea_abs (e6502_t *c)
+{
+	e6502_get_inst2 (c);
+
+	c->ea = ((unsigned short) c->inst[2] << 8) + c->inst[1];
+	c->ea_page = 0;
+
+	return (c->ea);
+}
+
+static inline
+unsigned short e6502_get_ea_ind_idx_y (e6502_t *c)
+{
+	unsigned ial, adl, adh;
+
+	e6502_get_inst1 (c);
+
+	ial = c->inst[1];
+
+	adl = e6502_get_zpg8 (c, ial);
+	adh = e6502_get_zpg8 (c, (ial + 1) & 0xff);
+
+	adl += e6502_get_y (c);
+
+	if (adl < 0x100) {
+		c->ea_page = 0;
+	}
+	else {
+		c->ea_page = 1;
+		adl = adl & 0xff;
+		adh = (adh + 1) & 0xff;
+	}
+
+	c->ea = (adh << 8) | adl;
+
+	return (c->ea);
+}
+
+static inline
+unsigned short e6502_get_ea_zpg_x (e6502_t *c)
+{
+	e6502_get_inst1 (c);
+
+	c->ea = (c->inst[1] + e6502_get_x (c)) & 0xff;
+	c->ea_page = 0;
+
+	return (c->ea);
+}
+
+static inline
+unsigned short e6502_get_ea_zpg_y (e6502_t *c)
+{
+	e6502_get_inst1 (c);
+
+	c->ea = (c->inst[1] + e6502_get_y (c)) & 0xff;
+	c->ea_page = 0;
+
+	return (c->ea);
+}
+
+static inline
+unsigned short e6502_get_ea_abs_y (e6502_t *c)
+{
+	unsigned short tmp;
+
+	e6502_get_inst2 (c);
+
+	tmp = e6502_mk_uint16 (c->inst[1], c->inst[2]);
+	c->ea = (tmp + e6502_get_y (c)) & 0xffff;
+	c->ea_page = ((tmp ^ c->ea) & 0xff00) != 0;
+
+	return (c->ea);
+}
+
+static inline
+unsigned short e6502_get_ea_abs_x (e6502_t *c)
+{
+	unsigned short tmp;
+
+	e6502_get_inst2 (c);
+
+	tmp = e6502_mk_uint16 (c->inst[1], c->inst[2]);
+	c->ea = (tmp + e6502_get_x (c)) & 0xffff;
+	c->ea_page = ((tmp ^ c->ea) & 0xff00) != 0;
+
+	return (c->ea);
+}
 
 
 extern e6502_opcode_f e6502_opcodes[256];
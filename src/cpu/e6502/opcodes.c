@@ -42,7 +42,7 @@ unsigned char e6502_pull (e6502_t *c)
 	unsigned char val;
 
 	e6502_set_s (c, e6502_get_s (c) + 1);
-	val = e6502_get_mem8 (c, 0x0100 + e6502_get_s (c));
+	val = e6502_get_stk8 (c, e6502_get_s (c));
 
 	return (val);
 }
@@ -51,8 +51,8 @@ unsigned short e6502_pull16 (e6502_t *c)
 {
 	unsigned char val1, val2;
 
-	val1 = e6502_get_mem8 (c, 0x0100 + ((e6502_get_s (c) + 1) & 0xff));
-	val2 = e6502_get_mem8 (c, 0x0100 + ((e6502_get_s (c) + 2) & 0xff));
+	val1 = e6502_get_stk8 (c, e6502_get_s (c) + 1);
+	val2 = e6502_get_stk8 (c, e6502_get_s (c) + 2);
 	e6502_set_s (c, e6502_get_s (c) + 2);
 
 	return (e6502_mk_uint16 (val1, val2));
@@ -60,14 +60,14 @@ unsigned short e6502_pull16 (e6502_t *c)
 
 void e6502_push (e6502_t *c, unsigned char val)
 {
-	e6502_set_mem8 (c, 0x0100 + e6502_get_s (c), val);
+	e6502_set_stk8 (c, e6502_get_s (c), val);
 	e6502_set_s (c, e6502_get_s (c) - 1);
 }
 
 void e6502_push16 (e6502_t *c, unsigned short val)
 {
-	e6502_set_mem8 (c, 0x0100 + e6502_get_s (c), val >> 8);
-	e6502_set_mem8 (c, 0x0100 + ((e6502_get_s (c) - 1) & 0xff), val & 0xff);
+	e6502_set_stk8 (c, e6502_get_s (c), val >> 8);
+	e6502_set_stk8 (c, e6502_get_s (c) - 1, val & 0xff);
 	e6502_set_s (c, e6502_get_s (c) - 2);
 }
 
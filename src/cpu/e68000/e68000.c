@@ -832,6 +832,10 @@ void e68_execute (e68000_t *c)
 
 		c->ir[0] = c->ir[1];
 
+		if (c->log_opcode != NULL) {
+			c->log_opcode (c->log_ext, c->ir[0]);
+		}
+
 		c->opcodes[(c->ir[0] >> 6) & 0x3ff] (c);
 
 		c->oprcnt += 1;
@@ -0,0 +1,341 @@
+/*****************************************************************************
+ * pce                                                                       *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * File name:   src/cpu/e8080/bench.c                                        *
+ * Created:     2026-10-19 by agent <agent@local>                            *
+ * Copyright:   (C) 2026 agent <agent@local>                                 *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * This program is free software. You can redistribute it and / or modify it *
+ * under the terms of the GNU General Public License version 2 as  published *
+ * by the Free Software Foundation.                                          *
+ *                                                                           *
+ * This program is distributed in the hope  that  it  will  be  useful,  but *
+ * WITHOUT  ANY   WARRANTY,   without   even   the   implied   warranty   of *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General *
+ * Public License for more details.                                          *
+ *****************************************************************************/
+
+
+/*
+ * e8080-bench: Measure the throughput of the 8080 / Z80 core.
+ *
+ * The benchmark runs a fixed loop of ALU, memory, stack and (in Z80 mode)
+ * indexed and bit instructions for a fixed number of instructions. It
+ * prints the instruction rate and a hash of the final CPU and memory
+ * state, which must be the same for every version of the core.
+ *
+ * Build and run it from the build directory:
+ *
+ *   make src/cpu/e8080/e8080-bench
+ *   src/cpu/e8080/e8080-bench -r 9
+ *   src/cpu/e8080/e8080-bench -z -r 9
+ *
+ * It only uses the public e8080 interface, so it can also be built
+ * against the sources of an older core (in old/src/cpu/e8080) to
+ * compare the two:
+ *
+ *   cc -O2 -Iold/src -Isrc -I$(srcdir)/src -o e8080-bench-old \
+ *     $(srcdir)/src/cpu/e8080/bench.c old/src/cpu/e8080/[a-z]*.c \
+ *     src/lib/getopt.o src/lib/sysdep.o
+ */
+
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cpu/e8080/e8080.h>
+
+#include <lib/getopt.h>
+#include <lib/sysdep.h>
+
+
+static pce_option_t opts[] = {
+	{ '?', 0, "help", NULL, "Print usage information" },
+	{ 'n', 1, "count", "int", "Set the number of instructions in millions [100]" },
+	{ 'r', 1, "runs", "int", "Set the number of runs [3]" },
+	{ 'z', 0, "z80", NULL, "Run the Z80 loop instead of the 8080 loop" },
+	{  -1, 0, NULL, NULL, NULL }
+};
+
+
+/* runs in 8080 mode */
+static unsigned char prog_8080[] = {
+	0x31, 0x00, 0xff,		/* 0000: LXI  SP, FF00 */
+	0x21, 0x00, 0x80,		/* 0003: LXI  H, 8000 */
+	0x01, 0x34, 0x12,		/* 0006: LXI  B, 1234 */
+	0x11, 0x78, 0x56,		/* 0009: LXI  D, 5678 */
+	0x7e,				/* 000C: MOV  A, M */
+	0x80,				/* 000D: ADD  B */
+	0xa9,				/* 000E: XRA  C */
+	0xa2,				/* 000F: ANA  D */
+	0xb3,				/* 0010: ORA  E */
+	0x90,				/* 0011: SUB  B */
+	0x99,				/* 0012: SBB  C */
+	0x8a,				/* 0013: ADC  D */
+	0xbb,				/* 0014: CMP  E */
+	0x0c,				/* 0015: INR  C */
+	0x15,				/* 0016: DCR  D */
+	0x07,				/* 0017: RLC */
+	0x1f,				/* 0018: RAR */
+	0x27,				/* 0019: DAA */
+	0x77,				/* 001A: MOV  M, A */
+	0x23,				/* 001B: INX  H */
+	0x7c,				/* 001C: MOV  A, H */
+	0xe6, 0x8f,			/* 001D: ANI  8F */
+	0xf6, 0x80,			/* 001F: ORI  80 */
+	0x67,				/* 0021: MOV  H, A */
+	0xc5,				/* 0022: PUSH B */
+	0xcd, 0x30, 0x00,		/* 0023: CALL 0030 */
+	0xc1,				/* 0026: POP  B */
+	0x05,				/* 0027: DCR  B */
+	0xc2, 0x0c, 0x00,		/* 0028: JNZ  000C */
+	0x1c,				/* 002B: INR  E */
+	0xc3, 0x0c, 0x00,		/* 002C: JMP  000C */
+	0x00,				/* 002F: NOP */
+	0x78,				/* 0030: MOV  A, B */
+	0x81,				/* 0031: ADD  C */
+	0x47,				/* 0032: MOV  B, A */
+	0xeb,				/* 0033: XCHG */
+	0xeb,				/* 0034: XCHG */
+	0xc9				/* 0035: RET */
+};
+
+/* uses the DD, FD, ED, CB, DD CB and FD CB prefixes */
+static unsigned char prog_z80[] = {
+	0x31, 0x00, 0xff,		/* 0000: LD   SP, FF00 */
+	0xdd, 0x21, 0x00, 0x80,		/* 0003: LD   IX, 8000 */
+	0xfd, 0x21, 0x00, 0x90,		/* 0007: LD   IY, 9000 */
+	0x21, 0x00, 0xa0,		/* 000B: LD   HL, A000 */
+	0x01, 0x34, 0x12,		/* 000E: LD   BC, 1234 */
+	0x11, 0x78, 0x56,		/* 0011: LD   DE, 5678 */
+	0xdd, 0x7e, 0x05,		/* 0014: LD   A, (IX+5) */
+	0xfd, 0x86, 0x03,		/* 0017: ADD  A, (IY+3) */
+	0xdd, 0xae, 0x01,		/* 001A: XOR  (IX+1) */
+	0xcb, 0x27,			/* 001D: SLA  A */
+	0xcb, 0x11,			/* 001F: RL   C */
+	0xcb, 0x4a,			/* 0021: BIT  1, D */
+	0xdd, 0xcb, 0x02, 0xc6,		/* 0023: SET  0, (IX+2) */
+	0xfd, 0xcb, 0x04, 0x1e,		/* 0027: RR   (IY+4) */
+	0x80,				/* 002B: ADD  A, B */
+	0x9a,				/* 002C: SBC  A, D */
+	0xed, 0x52,			/* 002D: SBC  HL, DE */
+	0xed, 0x4a,			/* 002F: ADC  HL, BC */
+	0xdd, 0x77, 0x07,		/* 0031: LD   (IX+7), A */
+	0xdd, 0x23,			/* 0034: INC  IX */
+	0xfd, 0x23,			/* 0036: INC  IY */
+	0x10, 0xda,			/* 0038: DJNZ 0014 */
+	0x1c,				/* 003A: INC  E */
+	0xc3, 0x03, 0x00		/* 003B: JP   0003 */
+};
+
+
+const char *arg0 = NULL;
+
+static unsigned char ram[65536];
+
+
+static
+void print_help (void)
+{
+	pce_getopt_help (
+		"e8080-bench: Measure the throughput of the 8080 / Z80 core",
+		"usage: e8080-bench [options]",
+		opts
+	);
+
+	fflush (stdout);
+}
+
+static
+unsigned char bench_get_mem8 (void *ext, unsigned long addr)
+{
+	return (ram[addr & 0xffff]);
+}
+
+static
+void bench_set_mem8 (void *ext, unsigned long addr, unsigned char val)
+{
+	ram[addr & 0xffff] = val;
+}
+
+static
+unsigned char bench_get_port8 (void *ext, unsigned long addr)
+{
+	return (0xff);
+}
+
+static
+void bench_set_port8 (void *ext, unsigned long addr, unsigned char val)
+{
+}
+
+static
+unsigned long bench_hash (unsigned long h, unsigned val)
+{
+	h = (h ^ (val & 0xff)) * 16777619UL;
+	h = (h ^ ((val >> 8) & 0xff)) * 16777619UL;
+
+	return (h & 0xffffffff);
+}
+
+/*
+ * Hash the CPU registers and the memory.
+ */
+static
+unsigned long bench_state (e8080_t *c)
+{
+	unsigned      i;
+	unsigned long h;
+
+	h = 2166136261UL;
+
+	for (i = 0; i < 8; i++) {
+		h = bench_hash (h, e8080_get_reg8 (c, i));
+	}
+
+	h = bench_hash (h, e8080_get_psw (c));
+	h = bench_hash (h, e8080_get_pc (c));
+	h = bench_hash (h, e8080_get_sp (c));
+	h = bench_hash (h, e8080_get_ix (c));
+	h = bench_hash (h, e8080_get_iy (c));
+
+	for (i = 0; i < 65536; i++) {
+		h = bench_hash (h, ram[i]);
+	}
+
+	return (h);
+}
+
+static
+int bench_run (int z80, unsigned long cnt, unsigned long *us, unsigned long *state)
+{
+	unsigned long clk;
+	e8080_t       *c;
+
+	memset (ram, 0, sizeof (ram));
+
+	if (z80) {
+		memcpy (ram, prog_z80, sizeof (prog_z80));
+	}
+	else {
+		memcpy (ram, prog_8080, sizeof (prog_8080));
+	}
+
+	if ((c = e8080_new()) == NULL) {
+		return (1);
+	}
+
+	if (z80) {
+		e8080_set_z80 (c);
+	}
+	else {
+		e8080_set_8080 (c);
+	}
+
+	e8080_set_mem_fct (c, NULL, bench_get_mem8, bench_set_mem8);
+	e8080_set_port_fct (c, NULL, bench_get_port8, bench_set_port8);
+	e8080_set_mem_map_rd (c, 0, 65535, ram);
+	e8080_set_mem_map_wr (c, 0, 65535, ram);
+
+	e8080_reset (c);
+
+	pce_get_interval_us (&clk);
+
+	while (e8080_get_opcnt (c) < cnt) {
+		e8080_clock (c, 4096);
+	}
+
+	*us = pce_get_interval_us (&clk);
+	*state = bench_state (c);
+
+	e8080_del (c);
+
+	return (0);
+}
+
+int main (int argc, char **argv)
+{
+	int           r, z80;
+	unsigned      i, runs;
+	unsigned long cnt, us, best, state;
+	char          **optarg;
+
+	arg0 = argv[0];
+
+	z80 = 0;
+	cnt = 100;
+	runs = 3;
+
+	while (1) {
+		r = pce_getopt (argc, argv, &optarg, opts);
+
+		if (r == GETOPT_DONE) {
+			break;
+		}
+
+		if (r < 0) {
+			return (1);
+		}
+
+		switch (r) {
+		case '?':
+			print_help();
+			return (0);
+
+		case 'n':
+			cnt = strtoul (optarg[0], NULL, 0);
+			break;
+
+		case 'r':
+			runs = strtoul (optarg[0], NULL, 0);
+			break;
+
+		case 'z':
+			z80 = 1;
+			break;
+
+		case 0:
+			fprintf (stderr, "%s: unknown option (%s)\n", arg0, optarg[0]);
+			return (1);
+
+		default:
+			return (1);
+		}
+	}
+
+	cnt *= 1000000;
+	best = 0;
+
+	for (i = 0; i < runs; i++) {
+		if (bench_run (z80, cnt, &us, &state)) {
+			fprintf (stderr, "%s: can't create the CPU\n", arg0);
+			return (1);
+		}
+
+		if ((i == 0) || (us < best)) {
+			best = us;
+		}
+
+		printf ("%s run %u: %lu.%03lus state %08lX\n",
+			z80 ? "z80" : "8080", i + 1,
+			us / 1000000, (us / 1000) % 1000, state
+		);
+	}
+
+	if (best > 0) {
+		printf ("%s: %lu instructions, best %lu.%03lus, %.1f Minsn/s\n",
+			z80 ? "z80" : "8080", cnt,
+			best / 1000000, (best / 1000) % 1000,
+			(double) cnt / best
+		);
+	}
+
+	return (0);
+}
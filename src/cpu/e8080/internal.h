@@ -95,23 +95,226 @@ int e8080_hook_undefined (e8080_t *c);
 int e8080_hook_rst (e8080_t *c);
 
 
-void e8080_set_psw_szp (e8080_t *c, unsigned char val, unsigned set, unsigned reset);
-void e8080_set_psw_log (e8080_t *c, unsigned char val);
-void e8080_set_psw_inc (e8080_t *c, unsigned char val);
-void e8080_set_psw_dec (e8080_t *c, unsigned char val);
-void e8080_set_psw_add (e8080_t *c, unsigned char s1, unsigned char s2);
-void e8080_set_psw_sub (e8080_t *c, unsigned char s1, unsigned char s2);
-void e8080_set_psw_adc (e8080_t *c, unsigned char s1, unsigned char s2, unsigned char s3);
-void e8080_set_psw_sbb (e8080_t *c, unsigned char s1, unsigned char s2, unsigned char s3);
-
-void z80_set_psw_rot (e8080_t *c, unsigned char val, int cf);
-void z80_set_psw_inc (e8080_t *c, unsigned char val);
-void z80_set_psw_dec (e8080_t *c, unsigned char val);
-void z80_set_psw_add (e8080_t *c, unsigned d, unsigned char s1, unsigned char s2);
-void z80_set_psw_add16 (e8080_t *c, unsigned long d, unsigned s1, unsigned s2);
-void z80_set_psw_add16_2 (e8080_t *c, unsigned long d, unsigned s1, unsigned s2);
-void z80_set_psw_sub (e8080_t *c, unsigned d, unsigned char s1, unsigned char s2);
-void z80_set_psw_sub16_2 (e8080_t *c, unsigned long d, unsigned s1, unsigned s2);
+#define E8080_FLG_SZ  (E8080_FLG_S | E8080_FLG_Z)
+#define E8080_FLG_SZP (E8080_FLG_S | E8080_FLG_Z | E8080_FLG_P)
+
+
+extern const unsigned char e8080_szp[256];
+
+
+static inline
+void e8080_set_psw_szp (e8080_t *c, unsigned char val, unsigned set, unsigned reset)
+{
+	c->psw &= ~(E8080_FLG_SZP | reset);
+	c->psw |= e8080_szp[val] | set;
+}
+
+static inline
+void e8080_set_psw_log (e8080_t *c, unsigned char val)
+{
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A | E8080_FLG_C);
+	c->psw |= e8080_szp[val];
+}
+
+static inline
+void e8080_set_psw_inc (e8080_t *c, unsigned char val)
+{
+	unsigned char d;
+
+	d = val + 1;
+
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A);
+	c->psw |= e8080_szp[d] | ((val ^ d) & E8080_FLG_A);
+}
+
+static inline
+void e8080_set_psw_dec (e8080_t *c, unsigned char val)
+{
+	unsigned char d;
+
+	d = val - 1;
+
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A);
+	c->psw |= e8080_szp[d] | ((val ^ d) & E8080_FLG_A);
+}
+
+static inline
+void e8080_set_psw_adc (e8080_t *c, unsigned char s1, unsigned char s2, unsigned char s3)
+{
+	unsigned d;
+
+	d = (unsigned) s1 + (unsigned) s2 + (unsigned) s3;
+
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A | E8080_FLG_C);
+	c->psw |= e8080_szp[d & 0xff] | ((s1 ^ s2 ^ d) & E8080_FLG_A);
+
+	if (d > 255) {
+		c->psw |= E8080_FLG_C;
+	}
+}
+
+static inline
+void e8080_set_psw_sbb (e8080_t *c, unsigned char s1, unsigned char s2, unsigned char s3)
+{
+	unsigned d;
+
+	d = (unsigned) s1 - (unsigned) s2 - (unsigned) s3;
+
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A | E8080_FLG_C);
+	c->psw |= e8080_szp[d & 0xff] | ((s1 ^ s2 ^ d) & E8080_FLG_A);
+
+	if (d > 255) {
+		c->psw |= E8080_FLG_C;
+	}
+}
+
+static inline
+void e8080_set_psw_add (e8080_t *c, unsigned char s1, unsigned char s2)
+{
+	e8080_set_psw_adc (c, s1, s2, 0);
+}
+
+static inline
+void e8080_set_psw_sub (e8080_t *c, unsigned char s1, unsigned char s2)
+{
+	e8080_set_psw_sbb (c, s1, s2, 0);
+}
+
+static inline
+void z80_set_psw_rot (e8080_t *c, unsigned char val, int cf)
+{
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A | E8080_FLG_N | E8080_FLG_C);
+	c->psw |= e8080_szp[val] | (cf ? E8080_FLG_C : 0);
+}
+
+static inline
+void z80_set_psw_inc (e8080_t *c, unsigned char val)
+{
+	unsigned char d;
+
+	d = val + 1;
+
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A | E8080_FLG_N);
+	c->psw |= (e8080_szp[d] & E8080_FLG_SZ) | ((val ^ d) & E8080_FLG_A);
+
+	if (val == 0x7f) {
+		c->psw |= E8080_FLG_P;
+	}
+}
+
+static inline
+void z80_set_psw_dec (e8080_t *c, unsigned char val)
+{
+	unsigned char d;
+
+	d = val - 1;
+
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A);
+	c->psw |= (e8080_szp[d] & E8080_FLG_SZ) | ((val ^ d) & E8080_FLG_A);
+	c->psw |= E8080_FLG_N;
+
+	if (val == 0x80) {
+		c->psw |= E8080_FLG_P;
+	}
+}
+
+static inline
+void z80_set_psw_add (e8080_t *c, unsigned d, unsigned char s1, unsigned char s2)
+{
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A | E8080_FLG_N | E8080_FLG_C);
+	c->psw |= (e8080_szp[d & 0xff] & E8080_FLG_SZ) | ((s1 ^ s2 ^ d) & E8080_FLG_A);
+
+	if (d > 255) {
+		c->psw |= E8080_FLG_C;
+	}
+
+	if ((d ^ s1) & (d ^ s2) & 0x80) {
+		c->psw |= E8080_FLG_P;
+	}
+}
+
+static inline
+void z80_set_psw_sub (e8080_t *c, unsigned d, unsigned char s1, unsigned char s2)
+{
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A | E8080_FLG_C);
+	c->psw |= (e8080_szp[d & 0xff] & E8080_FLG_SZ) | ((s1 ^ s2 ^ d) & E8080_FLG_A);
+	c->psw |= E8080_FLG_N;
+
+	if (d > 255) {
+		c->psw |= E8080_FLG_C;
+	}
+
+	if ((s1 ^ d) & (s1 ^ s2) & 0x80) {
+		c->psw |= E8080_FLG_P;
+	}
+}
+
+static inline
+void z80_set_psw_add16 (e8080_t *c, unsigned long d, unsigned s1, unsigned s2)
+{
+	c->psw &= ~(E8080_FLG_A | E8080_FLG_N | E8080_FLG_C);
+
+	if (d > 65535) {
+		c->psw |= E8080_FLG_C;
+	}
+
+	if ((s1 ^ s2 ^ d) & 0x1000) {
+		c->psw |= E8080_FLG_A;
+	}
+}
+
+static inline
+void z80_set_psw_add16_2 (e8080_t *c, unsigned long d, unsigned s1, unsigned s2)
+{
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A | E8080_FLG_N | E8080_FLG_C);
+
+	if (d & 0x8000) {
+		c->psw |= E8080_FLG_S;
+	}
+
+	if ((d & 0xffff) == 0) {
+		c->psw |= E8080_FLG_Z;
+	}
+
+	if (d > 65535) {
+		c->psw |= E8080_FLG_C;
+	}
+
+	if ((s1 ^ d) & (s1 ^ s2) & 0x8000) {
+		c->psw |= E8080_FLG_P;
+	}
+
+	if ((s1 ^ s2 ^ d) & 0x1000) {
+		c->psw |= E8080_FLG_A;
+	}
+}
+
+static inline
+void z80_set_psw_sub16_2 (e8080_t *c, unsigned long d, unsigned s1, unsigned s2)
+{
+	c->psw &= ~(E8080_FLG_SZP | E8080_FLG_A | E8080_FLG_C);
+	c->psw |= E8080_FLG_N;
+
+	if (d & 0x8000) {
+		c->psw |= E8080_FLG_S;
+	}
+
+	if ((d & 0xffff) == 0) {
+		c->psw |= E8080_FLG_Z;
+	}
+
+	if (d > 65535) {
+		c->psw |= E8080_FLG_C;
+	}
+
+	if ((s1 ^ d) & (s1 ^ s2) & 0x8000) {
+		c->psw |= E8080_FLG_P;
+	}
+
+	if ((s1 ^ s2 ^ d) & 0x1000) {
+		c->psw |= E8080_FLG_A;
+	}
+}
 
 
 void z80_op_cb (e8080_t *c);
@@ -51,6 +51,8 @@ void e86_init (e8086_t *c)
 	c->mem_get_uint16 = e86_get_mem_uint16;
 	c->mem_set_uint8 = e86_set_mem_uint8;
 	c->mem_set_uint16 = e86_set_mem_uint16;
+	c->mem_get_buf = NULL;
+	c->mem_set_buf = NULL;
 
 	c->prt = NULL;
 	c->prt_get_uint8 = e86_get_mem_uint8;
@@ -97,6 +99,8 @@ void e86_init (e8086_t *c)
 	c->clock = 0;
 	c->opcnt = 0;
 	c->delay = 0;
+
+	c->rep_clk = 0;
 }
 
 void e86_free (e8086_t *c)
@@ -216,6 +220,89 @@ void e86_set_ram (e8086_t *c, unsigned char *ram, unsigned long cnt)
 	c->ram_cnt = cnt;
 }
 
+/*
+ * Get the number of bytes at the (masked) address addr that can be
+ * accessed without wrapping around the address mask or crossing the
+ * end of RAM, but at most cnt.
+ */
+static
+unsigned long e86_get_mem_span (const e8086_t *c, unsigned long addr, unsigned long cnt)
+{
+	unsigned long n;
+
+	n = cnt;
+
+	if ((n - 1) > (c->addr_mask - addr)) {
+		n = c->addr_mask - addr + 1;
+	}
+
+	if ((addr < c->ram_cnt) && (n > (c->ram_cnt - addr))) {
+		n = c->ram_cnt - addr;
+	}
+
+	return (n);
+}
+
+void e86_get_mem_buf (e8086_t *c, unsigned long addr, void *buf, unsigned long cnt)
+{
+	unsigned long i, n;
+	unsigned char *dst;
+
+	dst = buf;
+
+	while (cnt > 0) {
+		addr &= c->addr_mask;
+
+		n = e86_get_mem_span (c, addr, cnt);
+
+		if (addr < c->ram_cnt) {
+			memcpy (dst, c->ram + addr, n);
+		}
+		else if (c->mem_get_buf != NULL) {
+			c->mem_get_buf (c->mem, addr, dst, n);
+		}
+		else {
+			for (i = 0; i < n; i++) {
+				dst[i] = c->mem_get_uint8 (c->mem, addr + i);
+			}
+		}
+
+		dst += n;
+		addr += n;
+		cnt -= n;
+	}
+}
+
+void e86_set_mem_buf (e8086_t *c, unsigned long addr, const void *buf, unsigned long cnt)
+{
+	unsigned long       i, n;
+	const unsigned char *src;
+
+	src = buf;
+
+	while (cnt > 0) {
+		addr &= c->addr_mask;
+
+		n = e86_get_mem_span (c, addr, cnt);
+
+		if (addr < c->ram_cnt) {
+			memcpy (c->ram + addr, src, n);
+		}
+		else if (c->mem_set_buf != NULL) {
+			c->mem_set_buf (c->mem, addr, src, n);
+		}
+		else {
+			for (i = 0; i < n; i++) {
+				c->mem_set_uint8 (c->mem, addr + i, src[i]);
+			}
+		}
+
+		src += n;
+		addr += n;
+		cnt -= n;
+	}
+}
+
 void e86_set_mem (e8086_t *c, void *mem,
 	e86_get_uint8_f get8, e86_set_uint8_f set8,
 	e86_get_uint16_f get16, e86_set_uint16_f set16)
@@ -227,6 +314,12 @@ void e86_set_mem (e8086_t *c, void *mem,
 	c->mem_set_uint16 = set16;
 }
 
+void e86_set_mem_buf_fct (e8086_t *c, e86_get_buf_f get, e86_set_buf_f set)
+{
+	c->mem_get_buf = get;
+	c->mem_set_buf = set;
+}
+
 void e86_set_prt (e8086_t *c, void *prt,
 	e86_get_uint8_f get8, e86_set_uint8_f set8,
 	e86_get_uint16_f get16, e86_set_uint16_f set16)
@@ -549,7 +642,11 @@ void e86_clock (e8086_t *c, unsigned n)
 		n -= c->delay;
 		c->clock += c->delay;
 		c->delay = 0;
+
+		c->rep_clk = n;
 		e86_execute (c);
+		n = c->rep_clk;
+		c->rep_clk = 0;
 	}
 
 	c->delay -= n;
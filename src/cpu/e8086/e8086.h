@@ -94,6 +94,9 @@ typedef unsigned short (*e86_get_uint16_f) (void *ext, unsigned long addr);
 typedef void (*e86_set_uint8_f) (void *ext, unsigned long addr, unsigned char val);
 typedef void (*e86_set_uint16_f) (void *ext, unsigned long addr, unsigned short val);
 
+typedef void (*e86_get_buf_f) (void *ext, unsigned long addr, void *buf, unsigned long cnt);
+typedef void (*e86_set_buf_f) (void *ext, unsigned long addr, const void *buf, unsigned long cnt);
+
 typedef unsigned (*e86_opcode_f) (struct e8086_t *c);
 
 
@@ -113,6 +116,10 @@ typedef struct e8086_t {
 	e86_get_uint16_f mem_get_uint16;
 	e86_set_uint16_f mem_set_uint16;
 
+	/* optional bulk access functions, used by e86_get_mem_buf() */
+	e86_get_buf_f    mem_get_buf;
+	e86_set_buf_f    mem_set_buf;
+
 	void             *prt;
 	e86_get_uint8_f  prt_get_uint8;
 	e86_set_uint8_f  prt_set_uint8;
@@ -172,6 +179,9 @@ typedef struct e8086_t {
 	unsigned long    delay;
 	unsigned long    clock;
 	unsigned         opcnt;
+
+	/* the clock cycles left in e86_clock(), for string instructions */
+	unsigned long    rep_clk;
 } e8086_t;
 
 
@@ -396,11 +406,33 @@ void e86_set_trap_fct (e8086_t *c, void *ext, void *fct);
 
 void e86_set_ram (e8086_t *c, unsigned char *ram, unsigned long cnt);
 
+/*!***************************************************************************
+ * @short Copy memory at a linear address to a buffer
+ *
+ * The address is wrapped with the address mask just like with
+ * e86_get_mem8().
+ *****************************************************************************/
+void e86_get_mem_buf (e8086_t *c, unsigned long addr, void *buf, unsigned long cnt);
+
+/*!***************************************************************************
+ * @short Copy a buffer to memory at a linear address
+ *****************************************************************************/
+void e86_set_mem_buf (e8086_t *c, unsigned long addr, const void *buf, unsigned long cnt);
+
 void e86_set_mem (e8086_t *c, void *mem,
 	e86_get_uint8_f get8, e86_set_uint8_f set8,
 	e86_get_uint16_f get16, e86_set_uint16_f set16
 );
 
+/*!***************************************************************************
+ * @short Set the optional bulk memory access functions
+ *
+ * These functions are used by e86_get_mem_buf() and e86_set_mem_buf()
+ * for memory outside of the RAM area. They get the same ext parameter
+ * as the functions set with e86_set_mem().
+ *****************************************************************************/
+void e86_set_mem_buf_fct (e8086_t *c, e86_get_buf_f get, e86_set_buf_f set);
+
 void e86_set_prt (e8086_t *c, void *prt,
 	e86_get_uint8_f get8, e86_set_uint8_f set8,
 	e86_get_uint16_f get16, e86_set_uint16_f set16
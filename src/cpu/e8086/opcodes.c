@@ -23,6 +23,8 @@
 #include "e8086.h"
 #include "internal.h"
 
+#include <string.h>
+
 
 void e86_push (e8086_t *c, unsigned short val)
 {
@@ -2541,6 +2543,309 @@ unsigned op_a3 (e8086_t *c)
 	return (3);
 }
 
+/*
+ * Get the number of further iterations of a REP string instruction that
+ * the per-iteration path would execute before e86_clock() runs out of
+ * clock cycles. clk is the cost of one iteration.
+ *
+ * The iterations are limited to the clock budget so that interrupts and
+ * the devices clocked between e86_clock() calls see the same state as
+ * with the per-iteration path. The ibmpc emulator only passes large
+ * budgets when it runs at full speed. At a fixed speed it clocks the
+ * CPU in batches of 4 * speed cycles, which rarely cover more than one
+ * iteration, so the fast path has almost no effect there.
+ */
+static
+unsigned op_rep_get_cnt (e8086_t *c, unsigned clk)
+{
+	unsigned long cnt;
+
+	if ((c->rep_clk == 0) || (c->op_stat != NULL)) {
+		return (0);
+	}
+
+	if (e86_get_tf (c) || (c->irq && e86_get_if (c))) {
+		return (0);
+	}
+
+	if (c->rep_clk < (c->delay + 10)) {
+		return (0);
+	}
+
+	cnt = 1 + (c->rep_clk - c->delay - 10) / (clk + 10);
+
+	if (cnt > e86_get_cx (c)) {
+		cnt = e86_get_cx (c);
+	}
+
+	return (cnt);
+}
+
+/*
+ * Account for cnt further iterations of a REP string instruction, exactly
+ * as if they had been executed one by one.
+ */
+static
+void op_rep_set_cnt (e8086_t *c, unsigned clk, unsigned cnt)
+{
+	unsigned long n;
+
+	n = c->delay + 10 + (unsigned long) (cnt - 1) * (clk + 10);
+
+	c->rep_clk -= n;
+	c->clock += n;
+	c->delay = clk;
+	c->opcnt += cnt;
+
+	e86_set_cx (c, e86_get_cx (c) - cnt);
+}
+
+/*
+ * Get a pointer to the lowest byte of cnt string elements of size
+ * bytes starting at seg:ofs. Returns NULL if the elements are not all
+ * in RAM or if the offset wraps around.
+ */
+static
+unsigned char *op_rep_get_ram (e8086_t *c, unsigned short seg, unsigned short ofs, unsigned cnt, unsigned size)
+{
+	unsigned long lo, len, addr;
+
+	len = (unsigned long) cnt * size;
+
+	if (e86_get_df (c)) {
+		if (ofs < (len - size)) {
+			return (NULL);
+		}
+
+		lo = ofs - (len - size);
+	}
+	else {
+		lo = ofs;
+	}
+
+	if ((lo + len) > 0x10000) {
+		return (NULL);
+	}
+
+	addr = e86_get_linear (seg, lo);
+
+	if (((addr + len - 1) & c->addr_mask) != ((addr & c->addr_mask) + len - 1)) {
+		return (NULL);
+	}
+
+	addr &= c->addr_mask;
+
+	if ((addr + len) > c->ram_cnt) {
+		return (NULL);
+	}
+
+	return (c->ram + addr);
+}
+
+static
+void op_rep_adjust (e8086_t *c, unsigned reg, unsigned cnt, unsigned size)
+{
+	unsigned short inc;
+
+	inc = (cnt * size) & 0xffff;
+
+	if (e86_get_df (c)) {
+		c->dreg[reg] = (c->dreg[reg] - inc) & 0xffff;
+	}
+	else {
+		c->dreg[reg] = (c->dreg[reg] + inc) & 0xffff;
+	}
+}
+
+/* REP MOVS fast path */
+static
+void op_rep_movs (e8086_t *c, unsigned short seg1, unsigned short seg2, unsigned size)
+{
+	unsigned      cnt;
+	unsigned long len;
+	unsigned char *src, *dst;
+
+	if ((cnt = op_rep_get_cnt (c, 18)) == 0) {
+		return;
+	}
+
+	src = op_rep_get_ram (c, seg1, e86_get_si (c), cnt, size);
+	dst = op_rep_get_ram (c, seg2, e86_get_di (c), cnt, size);
+
+	if ((src == NULL) || (dst == NULL)) {
+		return;
+	}
+
+	len = (unsigned long) cnt * size;
+
+	/* overlapping copies that read bytes already written */
+	if (e86_get_df (c)) {
+		if ((dst < src) && ((dst + len) > src)) {
+			return;
+		}
+	}
+	else {
+		if ((dst > src) && (dst < (src + len))) {
+			return;
+		}
+	}
+
+	memmove (dst, src, len);
+
+	op_rep_adjust (c, E86_REG_SI, cnt, size);
+	op_rep_adjust (c, E86_REG_DI, cnt, size);
+	op_rep_set_cnt (c, 18, cnt);
+}
+
+/* REP STOS fast path */
+static
+void op_rep_stos (e8086_t *c, unsigned short seg, unsigned size)
+{
+	unsigned      i, cnt;
+	unsigned char lo, hi;
+	unsigned char *dst;
+
+	if ((cnt = op_rep_get_cnt (c, 11)) == 0) {
+		return;
+	}
+
+	if ((dst = op_rep_get_ram (c, seg, e86_get_di (c), cnt, size)) == NULL) {
+		return;
+	}
+
+	lo = e86_get_al (c);
+	hi = e86_get_ah (c);
+
+	if ((size == 1) || (lo == hi)) {
+		memset (dst, lo, (unsigned long) cnt * size);
+	}
+	else {
+		for (i = 0; i < cnt; i++) {
+			dst[2 * i] = lo;
+			dst[2 * i + 1] = hi;
+		}
+	}
+
+	op_rep_adjust (c, E86_REG_DI, cnt, size);
+	op_rep_set_cnt (c, 11, cnt);
+}
+
+/* REP LODS fast path */
+static
+void op_rep_lods (e8086_t *c, unsigned short seg, unsigned size)
+{
+	unsigned      cnt;
+	unsigned char *src;
+
+	if ((cnt = op_rep_get_cnt (c, 12)) == 0) {
+		return;
+	}
+
+	if ((src = op_rep_get_ram (c, seg, e86_get_si (c), cnt, size)) == NULL) {
+		return;
+	}
+
+	/* only the last element is visible */
+	if (e86_get_df (c) == 0) {
+		src += (unsigned long) (cnt - 1) * size;
+	}
+
+	if (size == 1) {
+		e86_set_al (c, src[0]);
+	}
+	else {
+		e86_set_ax (c, e86_mk_uint16 (src[0], src[1]));
+	}
+
+	op_rep_adjust (c, E86_REG_SI, cnt, size);
+	op_rep_set_cnt (c, 12, cnt);
+}
+
+/*
+ * REP CMPS / REP SCAS fast path. For SCAS, the elements at seg2:DI are
+ * compared against AL / AX.
+ */
+static
+void op_rep_cmps (e8086_t *c, unsigned short seg1, unsigned short seg2, unsigned size, int scas)
+{
+	unsigned       i, cnt, clk;
+	long           step;
+	unsigned short s1, s2;
+	unsigned char  *p1, *p2;
+	int            z;
+
+	z = (c->prefix & E86_PREFIX_REP) ? 1 : 0;
+
+	if (e86_get_zf (c) != z) {
+		return;
+	}
+
+	clk = scas ? 15 : 22;
+
+	if ((cnt = op_rep_get_cnt (c, clk)) == 0) {
+		return;
+	}
+
+	if (scas) {
+		p1 = NULL;
+	}
+	else if ((p1 = op_rep_get_ram (c, seg1, e86_get_si (c), cnt, size)) == NULL) {
+		return;
+	}
+
+	if ((p2 = op_rep_get_ram (c, seg2, e86_get_di (c), cnt, size)) == NULL) {
+		return;
+	}
+
+	if (e86_get_df (c)) {
+		step = -(long) size;
+
+		if (p1 != NULL) {
+			p1 += (unsigned long) (cnt - 1) * size;
+		}
+
+		p2 += (unsigned long) (cnt - 1) * size;
+	}
+	else {
+		step = size;
+	}
+
+	s1 = (size == 1) ? e86_get_al (c) : e86_get_ax (c);
+	s2 = 0;
+
+	i = 0;
+
+	while (i < cnt) {
+		if (p1 != NULL) {
+			s1 = (size == 1) ? p1[0] : e86_mk_uint16 (p1[0], p1[1]);
+			p1 += step;
+		}
+
+		s2 = (size == 1) ? p2[0] : e86_mk_uint16 (p2[0], p2[1]);
+		p2 += step;
+
+		i += 1;
+
+		if ((s1 == s2) != z) {
+			break;
+		}
+	}
+
+	if (size == 1) {
+		e86_set_flg_sub_8 (c, s1, s2);
+	}
+	else {
+		e86_set_flg_sub_16 (c, s1, s2);
+	}
+
+	if (p1 != NULL) {
+		op_rep_adjust (c, E86_REG_SI, i, size);
+	}
+
+	op_rep_adjust (c, E86_REG_DI, i, size);
+	op_rep_set_cnt (c, clk, i);
+}
+
 /* OP A4: MOVSB */
 static
 unsigned op_a4 (e8086_t *c)
@@ -2565,6 +2870,8 @@ unsigned op_a4 (e8086_t *c)
 
 		e86_set_clk (c, 18);
 
+		op_rep_movs (c, seg1, seg2, 1);
+
 		if (e86_get_cx (c) == 0) {
 			c->prefix &= ~E86_PREFIX_KEEP;
 			return (1);
@@ -2611,6 +2918,8 @@ unsigned op_a5 (e8086_t *c)
 
 		e86_set_clk (c, 18);
 
+		op_rep_movs (c, seg1, seg2, 2);
+
 		if (e86_get_cx (c) == 0) {
 			c->prefix &= ~E86_PREFIX_KEEP;
 			return (1);
@@ -2661,6 +2970,8 @@ unsigned op_a6 (e8086_t *c)
 
 		e86_set_clk (c, 22);
 
+		op_rep_cmps (c, seg1, seg2, 1, 0);
+
 		z = (c->prefix & E86_PREFIX_REP) ? 1 : 0;
 
 		if ((e86_get_cx (c) == 0) || (e86_get_zf (c) != z)) {
@@ -2715,6 +3026,8 @@ unsigned op_a7 (e8086_t *c)
 
 		e86_set_clk (c, 22);
 
+		op_rep_cmps (c, seg1, seg2, 2, 0);
+
 		z = (c->prefix & E86_PREFIX_REP) ? 1 : 0;
 
 		if ((e86_get_cx (c) == 0) || (e86_get_zf (c) != z)) {
@@ -2791,6 +3104,8 @@ unsigned op_aa (e8086_t *c)
 
 		e86_set_clk (c, 11);
 
+		op_rep_stos (c, seg, 1);
+
 		if (e86_get_cx (c) == 0) {
 			c->prefix &= ~E86_PREFIX_KEEP;
 			return (1);
@@ -2830,6 +3145,8 @@ unsigned op_ab (e8086_t *c)
 
 		e86_set_clk (c, 11);
 
+		op_rep_stos (c, seg, 2);
+
 		if (e86_get_cx (c) == 0) {
 			c->prefix &= ~E86_PREFIX_KEEP;
 			return (1);
@@ -2868,6 +3185,8 @@ unsigned op_ac (e8086_t *c)
 
 		e86_set_clk (c, 12);
 
+		op_rep_lods (c, seg, 1);
+
 		if (e86_get_cx (c) == 0) {
 			c->prefix &= ~E86_PREFIX_KEEP;
 			return (1);
@@ -2905,6 +3224,8 @@ unsigned op_ad (e8086_t *c)
 
 		e86_set_clk (c, 12);
 
+		op_rep_lods (c, seg, 2);
+
 		if (e86_get_cx (c) == 0) {
 			c->prefix &= ~E86_PREFIX_KEEP;
 			return (1);
@@ -2948,6 +3269,8 @@ unsigned op_ae (e8086_t *c)
 
 		e86_set_clk (c, 15);
 
+		op_rep_cmps (c, 0, seg, 1, 1);
+
 		z = (c->prefix & E86_PREFIX_REP) ? 1 : 0;
 
 		if ((e86_get_cx (c) == 0) || (e86_get_zf (c) != z)) {
@@ -2997,6 +3320,8 @@ unsigned op_af (e8086_t *c)
 
 		e86_set_clk (c, 15);
 
+		op_rep_cmps (c, 0, seg, 2, 1);
+
 		z = (c->prefix & E86_PREFIX_REP) ? 1 : 0;
 
 		if ((e86_get_cx (c) == 0) || (e86_get_zf (c) != z)) {
@@ -1290,6 +1290,39 @@ unsigned char hdc_read_data (hdc_t *hdc)
 	return (val);
 }
 
+unsigned hdc_read_buf (hdc_t *hdc, unsigned char *buf, unsigned cnt)
+{
+	if ((hdc->status & HDC_STATUS_REQ) == 0) {
+		return (0);
+	}
+
+	if (hdc->status & HDC_STATUS_CMD) {
+		return (0);
+	}
+
+	if (hdc->buf_idx >= hdc->buf_cnt) {
+		return (0);
+	}
+
+	if (cnt > (unsigned) (hdc->buf_cnt - hdc->buf_idx)) {
+		cnt = hdc->buf_cnt - hdc->buf_idx;
+	}
+
+	memcpy (buf, hdc->buf + hdc->buf_idx, cnt);
+
+	hdc->buf_idx += cnt;
+
+	if (hdc->buf_idx >= hdc->buf_cnt) {
+		hdc_set_dreq (hdc, 0);
+
+		if (hdc->cont != NULL) {
+			hdc->cont (hdc);
+		}
+	}
+
+	return (cnt);
+}
+
 
 static
 void hdc_select (hdc_t *hdc)
@@ -1449,6 +1482,39 @@ void hdc_write_data (hdc_t *hdc, unsigned char val)
 	}
 }
 
+unsigned hdc_write_buf (hdc_t *hdc, const unsigned char *buf, unsigned cnt)
+{
+	if ((hdc->status & HDC_STATUS_REQ) == 0) {
+		return (0);
+	}
+
+	if (hdc->status & HDC_STATUS_CMD) {
+		return (0);
+	}
+
+	if (hdc->buf_idx >= hdc->buf_cnt) {
+		return (0);
+	}
+
+	if (cnt > (unsigned) (hdc->buf_cnt - hdc->buf_idx)) {
+		cnt = hdc->buf_cnt - hdc->buf_idx;
+	}
+
+	memcpy (hdc->buf + hdc->buf_idx, buf, cnt);
+
+	hdc->buf_idx += cnt;
+
+	if (hdc->buf_idx >= hdc->buf_cnt) {
+		hdc_set_dreq (hdc, 0);
+
+		if (hdc->cont != NULL) {
+			hdc->cont (hdc);
+		}
+	}
+
+	return (cnt);
+}
+
 static
 unsigned char hdc_get_uint8 (hdc_t *hdc, unsigned long addr)
 {
@@ -90,6 +90,8 @@ typedef struct hdc_t {
 
 unsigned char hdc_read_data (hdc_t *hdc);
 void hdc_write_data (hdc_t *hdc, unsigned char val);
+unsigned hdc_read_buf (hdc_t *hdc, unsigned char *buf, unsigned cnt);
+unsigned hdc_write_buf (hdc_t *hdc, const unsigned char *buf, unsigned cnt);
 void hdc_set_tc (hdc_t *hdc, unsigned char val);
 
 hdc_t *hdc_new (unsigned long addr);
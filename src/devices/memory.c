@@ -1047,3 +1047,128 @@ void mem_set_uint32_le (memory_t *mem, unsigned long addr, unsigned long val)
 		mem->set_uint32 (mem->ext, addr, val);
 	}
 }
+
+/*
+ * Get the number of bytes starting at addr that are in blk, but at
+ * most cnt.
+ */
+static
+unsigned long mem_blk_get_span (const mem_blk_t *blk, unsigned long addr, unsigned long cnt)
+{
+	unsigned long n;
+
+	n = blk->addr2 - addr + 1;
+
+	if ((n == 0) || (n > cnt)) {
+		n = cnt;
+	}
+
+	return (n);
+}
+
+void mem_read_buf (memory_t *mem, unsigned long addr, void *buf, unsigned long cnt)
+{
+	unsigned long i, n;
+	unsigned char *dst;
+	mem_blk_t     *blk;
+
+	dst = buf;
+
+	while (cnt > 0) {
+		blk = mem_get_blk_inline (mem, addr, 1);
+
+		if (blk == NULL) {
+			*(dst++) = mem_get_uint8 (mem, addr);
+			addr += 1;
+			cnt -= 1;
+			continue;
+		}
+
+		n = mem_blk_get_span (blk, addr, cnt);
+
+		if (blk->get_uint8 == NULL) {
+			memcpy (dst, blk->data + (addr - blk->addr1), n);
+		}
+		else {
+			for (i = 0; i < n; i++) {
+				dst[i] = blk->get_uint8 (blk->ext, addr - blk->addr1 + i);
+			}
+		}
+
+		dst += n;
+		addr += n;
+		cnt -= n;
+	}
+}
+
+void mem_write_buf (memory_t *mem, unsigned long addr, const void *buf, unsigned long cnt)
+{
+	unsigned long       i, n;
+	const unsigned char *src;
+	mem_blk_t           *blk;
+
+	src = buf;
+
+	while (cnt > 0) {
+		blk = mem_get_blk_inline (mem, addr, 2);
+
+		if (blk == NULL) {
+			mem_set_uint8 (mem, addr, *(src++));
+			addr += 1;
+			cnt -= 1;
+			continue;
+		}
+
+		n = mem_blk_get_span (blk, addr, cnt);
+
+		if (blk->readonly) {
+			;
+		}
+		else if (blk->set_uint8 == NULL) {
+			memcpy (blk->data + (addr - blk->addr1), src, n);
+		}
+		else {
+			for (i = 0; i < n; i++) {
+				blk->set_uint8 (blk->ext, addr - blk->addr1 + i, src[i]);
+			}
+		}
+
+		src += n;
+		addr += n;
+		cnt -= n;
+	}
+}
+
+void mem_fill (memory_t *mem, unsigned long addr, unsigned char val, unsigned long cnt)
+{
+	unsigned long i, n;
+	mem_blk_t     *blk;
+
+	while (cnt > 0) {
+		blk = mem_get_blk_inline (mem, addr, 2);
+
+		if (blk == NULL) {
+			mem_set_uint8 (mem, addr, val);
+			addr += 1;
+			cnt -= 1;
+			continue;
+		}
+
+		n = mem_blk_get_span (blk, addr, cnt);
+
+		if (blk->readonly) {
+			;
+		}
+		else if (blk->set_uint8 == NULL) {
+			memset (blk->data + (addr - blk->addr1), val, n);
+		}
+		else {
+			for (i = 0; i < n; i++) {
+				blk->set_uint8 (blk->ext, addr - blk->addr1 + i, val);
+			}
+		}
+
+		addr += n;
+		cnt -= n;
+	}
+}
@@ -328,5 +328,37 @@ void mem_set_uint16_le (memory_t *mem, unsigned long addr, unsigned short val);
 void mem_set_uint32_be (memory_t *mem, unsigned long addr, unsigned long val);
 void mem_set_uint32_le (memory_t *mem, unsigned long addr, unsigned long val);
 
+/*!***************************************************************************
+ * @short Copy memory to a buffer
+ * @param mem  The memory structure
+ * @param addr The source address
+ * @param buf  The destination buffer
+ * @param cnt  The number of bytes to copy
+ *
+ * Blocks with backing store are copied directly, all other memory is
+ * read one byte at a time.
+ *****************************************************************************/
+void mem_read_buf (memory_t *mem, unsigned long addr, void *buf, unsigned long cnt);
+
+/*!***************************************************************************
+ * @short Copy a buffer to memory
+ * @param mem  The memory structure
+ * @param addr The destination address
+ * @param buf  The source buffer
+ * @param cnt  The number of bytes to copy
+ *
+ * Read-only blocks are skipped, like in mem_set_uint8().
+ *****************************************************************************/
+void mem_write_buf (memory_t *mem, unsigned long addr, const void *buf, unsigned long cnt);
+
+/*!***************************************************************************
+ * @short Fill memory with a constant value
+ * @param mem  The memory structure
+ * @param addr The destination address
+ * @param val  The fill value
+ * @param cnt  The number of bytes to set
+ *****************************************************************************/
+void mem_fill (memory_t *mem, unsigned long addr, unsigned char val, unsigned long cnt);
+
 
 #endif
@@ -628,13 +628,53 @@ void cga_line_mode2c_auto (cga_t *cga, unsigned row)
 	}
 }
 
+/*
+ * Check if the video memory used by a line was written since the
+ * line was last drawn
+ */
+static
+int cga_line_changed (cga_t *cga, unsigned row)
+{
+	unsigned      i, n, adr;
+	unsigned long frm;
+
+	if (row >= CGA_LINES) {
+		return (1);
+	}
+
+	frm = cga->line_frm[row];
+
+	/* one more, for the lookahead in cga_line_mode2c_auto() */
+	n = e6845_get_hd (&cga->crtc) + 1;
+
+	for (i = 0; i < n; i++) {
+		if (cga->reg[CGA_MODE] & CGA_MODE_G320) {
+			adr = ((cga->crtc.ra & 1) << 13);
+			adr |= ((cga->crtc.ma + i) << 1) & 0x1ffe;
+		}
+		else {
+			adr = ((cga->crtc.ma + i) << 1) & 0x3fff;
+		}
+
+		if (cga->page_frm[adr >> 8] >= frm) {
+			return (1);
+		}
+	}
+
+	return (0);
+}
+
 static
 void cga_hsync (cga_t *cga)
 {
 	unsigned      row, max, ch;
 	unsigned char mode;
 
-	if (cga->mod_cnt == 0) {
+	if (cga->video.frame.render == 0) {
+		return;
+	}
+
+	if ((cga->mod_cnt == 0) && (cga->mem_cnt == 0)) {
 		return;
 	}
 
@@ -652,6 +692,16 @@ void cga_hsync (cga_t *cga)
 		return;
 	}
 
+	if (cga->mod_cnt == 0) {
+		if (cga_line_changed (cga, row) == 0) {
+			return;
+		}
+	}
+
+	if (row < CGA_LINES) {
+		cga->line_frm[row] = cga->frame_cnt;
+	}
+
 	if ((mode & CGA_MODE_ENABLE) == 0) {
 		cga_line_blank (cga, row);
 	}
@@ -692,17 +742,25 @@ void cga_vsync (cga_t *cga)
 	if ((cga->term != NULL) && (vid->buf_w > 0) && (vid->buf_h > 0)) {
 		trm_set_size (cga->term, vid->buf_w, vid->buf_h);
 
-		if (cga->mod_cnt > 0) {
+		if (((cga->mod_cnt > 0) || (cga->mem_cnt > 0)) && vid->frame.render) {
 			trm_set_lines (cga->term, vid->buf, 0, vid->buf_h);
 		}
 
 		trm_update (cga->term);
 	}
 
-	if (cga->mod_cnt > 0) {
-		cga->mod_cnt -= 1;
+	if (vid->frame.render) {
+		if (cga->mod_cnt > 0) {
+			cga->mod_cnt -= 1;
+		}
+
+		if (cga->mem_cnt > 0) {
+			cga->mem_cnt -= 1;
+		}
 	}
 
+	cga->frame_cnt += 1;
+
 	vdl = e6845_get_vdl (&cga->crtc);
 	vsl = e6845_get_vsl (&cga->crtc);
 
@@ -730,6 +788,8 @@ void cga_vsync (cga_t *cga)
 			cga->mod_cnt = 1;
 		}
 	}
+
+	pce_frame_next (&vid->frame, (cga->mod_cnt > 0) || (cga->mem_cnt > 0));
 }
 
 static
@@ -982,7 +1042,8 @@ static
 void cga_mem_set_uint8 (cga_t *cga, unsigned long addr, unsigned char val)
 {
 	cga->mem[addr & 0x3fff] = val;
-	cga->mod_cnt = 2;
+	cga->page_frm[(addr >> 8) & 0x3f] = cga->frame_cnt;
+	cga->mem_cnt = 2;
 }
 
 static
@@ -990,7 +1051,9 @@ void cga_mem_set_uint16 (cga_t *cga, unsigned long addr, unsigned short val)
 {
 	cga->mem[(addr + 0) & 0x3fff] = val & 0xff;
 	cga->mem[(addr + 1) & 0x3fff] = (val >> 8) & 0xff;
-	cga->mod_cnt = 2;
+	cga->page_frm[(addr >> 8) & 0x3f] = cga->frame_cnt;
+	cga->page_frm[((addr + 1) >> 8) & 0x3f] = cga->frame_cnt;
+	cga->mem_cnt = 2;
 }
 
 static
@@ -1183,6 +1246,8 @@ mem_blk_t *cga_get_reg (cga_t *cga)
 static
 void cga_init (cga_t *cga, unsigned long io, unsigned long addr)
 {
+	unsigned i;
+
 	pce_video_init (&cga->video);
 
 	cga->video.ext = cga;
@@ -1216,6 +1281,17 @@ void cga_init (cga_t *cga, unsigned long io, unsigned long addr)
 	cga->font = cga_font_thick;
 	cga->clock = 0;
 	cga->mod_cnt = 0;
+	cga->mem_cnt = 0;
+
+	cga->frame_cnt = 1;
+
+	for (i = 0; i < 64; i++) {
+		cga->page_frm[i] = 0;
+	}
+
+	for (i = 0; i < CGA_LINES; i++) {
+		cga->line_frm[i] = 0;
+	}
 
 	cga->rgbi_max = 0;
 	cga->rgbi_buf = NULL;
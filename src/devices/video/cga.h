@@ -31,6 +31,9 @@
 #include <libini/libini.h>
 
 
+#define CGA_LINES 512
+
+
 typedef struct {
 	video_t             video;
 	e6845_t             crtc;
@@ -49,6 +52,14 @@ typedef struct {
 
 	unsigned char       mod_cnt;
 
+	/* like mod_cnt, but only video memory was modified */
+	unsigned char       mem_cnt;
+
+	/* the frame in which a 256 byte page was written / a line drawn */
+	unsigned long       frame_cnt;
+	unsigned long       page_frm[64];
+	unsigned long       line_frm[CGA_LINES];
+
 	unsigned            rgbi_max;
 	unsigned char       *rgbi_buf;
 
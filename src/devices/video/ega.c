@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <lib/log.h>
 #include <lib/msg.h>
@@ -160,6 +161,17 @@
 static void ega_clock (ega_t *ega, unsigned long cnt);
 
 
+/*
+ * Mark the whole screen as modified
+ */
+static
+void ega_set_dirty (ega_t *ega)
+{
+	ega->gen += 1;
+	ega->update_state |= EGA_UPDATE_DIRTY;
+}
+
+
 static
 void ega_set_irq (ega_t *ega, unsigned char val)
 {
@@ -215,7 +227,7 @@ void ega_set_blink_rate (ega_t *ega, unsigned rate, int start)
 	ega->blink_cnt = rate;
 	ega->blink_freq = rate;
 
-	ega->update_state |= EGA_UPDATE_DIRTY;
+	ega_set_dirty (ega);
 }
 
 /*
@@ -418,7 +430,7 @@ void ega_set_timing (ega_t *ega)
 	ega->clk_vd = v;
 
 	if (d) {
-		ega->update_state |= EGA_UPDATE_DIRTY;
+		ega_set_dirty (ega);
 	}
 }
 
@@ -493,6 +505,10 @@ int ega_set_buf_size (ega_t *ega, unsigned w, unsigned h)
 		ega->bufmax = cnt;
 	}
 
+	if ((ega->buf_w != w) || (ega->buf_h != h)) {
+		ega->gen += 1;
+	}
+
 	ega->buf_w = w;
 	ega->buf_h = h;
 
@@ -598,16 +614,40 @@ void ega_mode0_update_char (ega_t *ega, unsigned char *dst, unsigned w,
 	}
 }
 
+/*
+ * Check if any of cnt characters starting at CRTC address addr use
+ * video memory that was written since the last update
+ */
+static
+int ega_text_changed (ega_t *ega, unsigned addr, unsigned cnt)
+{
+	unsigned p;
+
+	while (cnt > 0) {
+		p = ega_get_crtc_addr (ega, addr, 0);
+
+		if (ega->mem_dirty[(p >> 8) & 0xff] & 0x03) {
+			return (1);
+		}
+
+		addr = (addr + 1) & 0xffff;
+		cnt -= 1;
+	}
+
+	return (0);
+}
+
 /*
  * Update text mode
  */
 static
 void ega_update_text (ega_t *ega)
 {
-	unsigned            x, y, w, h, cw, ch;
+	unsigned            i, x, y, w, h, cw, ch;
 	unsigned            w2, h2;
 	unsigned            addr, rptr, rofs, p;
-	unsigned            cpos;
+	unsigned            cpos, cols;
+	int                 full;
 	const unsigned char *src;
 	unsigned char       *dst;
 
@@ -620,12 +660,26 @@ void ega_update_text (ega_t *ega)
 		return;
 	}
 
+	full = (ega->gen != ega->update_gen);
+
+	/* the font is in plane 2 */
+	for (i = 0; i < 256; i++) {
+		if (ega->mem_dirty[i] & 0x04) {
+			full = 1;
+			break;
+		}
+	}
+
 	src = ega->mem;
 	dst = ega->buf;
 
 	addr = ega->latch_addr;
 	rofs = 2 * ega->reg_crt[EGA_CRT_OFS];
 	cpos = ega_get_cursor (ega);
+	cols = (w + cw - 1) / cw;
+
+	ega->update_y = h;
+	ega->update_h = 0;
 
 	y = 0;
 
@@ -640,23 +694,31 @@ void ega_update_text (ega_t *ega)
 
 		rptr = addr;
 
-		x = 0;
-		while (x < w) {
-			w2 = w - x;
-
-			if (w2 > cw) {
-				w2 = cw;
+		if (full || ega_text_changed (ega, rptr, cols)) {
+			if (y < ega->update_y) {
+				ega->update_y = y;
 			}
 
-			p = ega_get_crtc_addr (ega, rptr, 0);
+			ega->update_h = y + h2 - ega->update_y;
 
-			ega_mode0_update_char (ega, dst + 3 * x, w, w2, h2,
-				src[p], src[p + 0x10000], rptr == cpos
-			);
+			x = 0;
+			while (x < w) {
+				w2 = w - x;
 
-			rptr = (rptr + 1) & 0xffff;
+				if (w2 > cw) {
+					w2 = cw;
+				}
+
+				p = ega_get_crtc_addr (ega, rptr, 0);
+
+				ega_mode0_update_char (ega, dst + 3 * x, w, w2, h2,
+					src[p], src[p + 0x10000], rptr == cpos
+				);
+
+				rptr = (rptr + 1) & 0xffff;
 
-			x += w2;
+				x += w2;
+			}
 		}
 
 		addr = (addr + rofs) & 0xffff;
@@ -665,6 +727,29 @@ void ega_update_text (ega_t *ega)
 	}
 }
 
+/*
+ * Check if any of cnt character clocks starting at CRTC address addr
+ * use video memory that was written since the last update
+ */
+static
+int ega_graphics_changed (ega_t *ega, unsigned addr, unsigned row, unsigned cnt)
+{
+	unsigned p;
+
+	while (cnt > 0) {
+		p = ega_get_crtc_addr (ega, addr, row);
+
+		if (ega->mem_dirty[(p >> 8) & 0xff]) {
+			return (1);
+		}
+
+		addr = (addr + 1) & 0xffff;
+		cnt -= 1;
+	}
+
+	return (0);
+}
+
 /*
  * Update graphics mode
  */
@@ -679,6 +764,7 @@ void ega_update_graphics (ega_t *ega)
 	unsigned            msk, bit;
 	unsigned            idx;
 	unsigned char       buf[4];
+	int                 full;
 	const unsigned char *src;
 	unsigned char       *dst;
 
@@ -693,6 +779,9 @@ void ega_update_graphics (ega_t *ega)
 		return;
 	}
 
+	/* with an offset of 0, the next line depends on the last one */
+	full = (ega->gen != ega->update_gen) || (ega->reg_crt[EGA_CRT_OFS] == 0);
+
 	if (ega->reg_atc[EGA_ATC_MODE] & EGA_ATC_MODE_EB) {
 		blink1 = 0xff;
 		blink2 = ega->blink_on ? 0xff : 0x00;
@@ -713,67 +802,78 @@ void ega_update_graphics (ega_t *ega)
 	row = 0;
 	y = 0;
 
+	ega->update_y = h;
+	ega->update_h = 0;
+
 	while (y < h) {
-		dst = ega->buf + 3UL * y * w;
+		if (full || ega_graphics_changed (ega, addr, row, (hpp + w) / cw + 1)) {
+			if (y < ega->update_y) {
+				ega->update_y = y;
+			}
 
-		rptr = addr;
+			ega->update_h = y + 1 - ega->update_y;
 
-		ptr = ega_get_crtc_addr (ega, rptr, row);
+			dst = ega->buf + 3UL * y * w;
 
-		buf[0] = src[ptr + 0x00000];
-		buf[1] = src[ptr + 0x10000];
-		buf[2] = src[ptr + 0x20000];
-		buf[3] = (src[ptr + 0x30000] ^ blink1) | blink2;
+			rptr = addr;
 
-		msk = 0x80 >> (hpp & 7);
-		bit = (2 * hpp) & 6;
-		col = hpp;
+			ptr = ega_get_crtc_addr (ega, rptr, row);
 
-		rptr = (rptr + 1) & 0xffff;
+			buf[0] = src[ptr + 0x00000];
+			buf[1] = src[ptr + 0x10000];
+			buf[2] = src[ptr + 0x20000];
+			buf[3] = (src[ptr + 0x30000] ^ blink1) | blink2;
 
-		x = 0;
+			msk = 0x80 >> (hpp & 7);
+			bit = (2 * hpp) & 6;
+			col = hpp;
 
-		while (x < w) {
-			if (col >= cw) {
-				ptr = ega_get_crtc_addr (ega, rptr, row);
+			rptr = (rptr + 1) & 0xffff;
 
-				buf[0] = src[ptr + 0x00000];
-				buf[1] = src[ptr + 0x10000];
-				buf[2] = src[ptr + 0x20000];
-				buf[3] = (src[ptr + 0x30000] ^ blink1) | blink2;
+			x = 0;
 
-				msk = 0x80;
-				bit = 0;
-				col = 0;
+			while (x < w) {
+				if (col >= cw) {
+					ptr = ega_get_crtc_addr (ega, rptr, row);
 
-				rptr = (rptr + 1) & 0xffff;
-			}
+					buf[0] = src[ptr + 0x00000];
+					buf[1] = src[ptr + 0x10000];
+					buf[2] = src[ptr + 0x20000];
+					buf[3] = (src[ptr + 0x30000] ^ blink1) | blink2;
+
+					msk = 0x80;
+					bit = 0;
+					col = 0;
 
-			if (ega->reg_grc[EGA_GRC_MODE] & EGA_GRC_MODE_SR) {
-				/* CGA 4 color mode */
+					rptr = (rptr + 1) & 0xffff;
+				}
 
-				idx = (buf[0] >> (6 - bit)) & 0x03;
-				bit += 2;
+				if (ega->reg_grc[EGA_GRC_MODE] & EGA_GRC_MODE_SR) {
+					/* CGA 4 color mode */
 
-				if (bit > 6) {
-					buf[0] = buf[1];
-					buf[1] = 0;
-					bit = 0;
+					idx = (buf[0] >> (6 - bit)) & 0x03;
+					bit += 2;
+
+					if (bit > 6) {
+						buf[0] = buf[1];
+						buf[1] = 0;
+						bit = 0;
+					}
+				}
+				else {
+					idx = (buf[0] & msk) ? 0x01 : 0x00;
+					idx |= (buf[1] & msk) ? 0x02 : 0x00;
+					idx |= (buf[2] & msk) ? 0x04 : 0x00;
+					idx |= (buf[3] & msk) ? 0x08 : 0x00;
+					msk >>= 1;
 				}
-			}
-			else {
-				idx = (buf[0] & msk) ? 0x01 : 0x00;
-				idx |= (buf[1] & msk) ? 0x02 : 0x00;
-				idx |= (buf[2] & msk) ? 0x04 : 0x00;
-				idx |= (buf[3] & msk) ? 0x08 : 0x00;
-				msk >>= 1;
-			}
 
-			ega_get_palette (ega, idx, dst, dst + 1, dst + 2);
+				ega_get_palette (ega, idx, dst, dst + 1, dst + 2);
 
-			dst += 3;
-			col += 1;
-			x += 1;
+				dst += 3;
+				col += 1;
+				x += 1;
+			}
 		}
 
 		row += 1;
@@ -852,6 +952,13 @@ void ega_update (ega_t *ega)
 
 	if (show == 0) {
 		ega_update_blank (ega);
+
+		ega->update_y = 0;
+		ega->update_h = ega->buf_h;
+
+		/* the next update can't be incremental */
+		ega->gen += 1;
+
 		return;
 	}
 
@@ -861,6 +968,10 @@ void ega_update (ega_t *ega)
 	else {
 		ega_update_text (ega);
 	}
+
+	memset (ega->mem_dirty, 0, sizeof (ega->mem_dirty));
+
+	ega->update_gen = ega->gen;
 }
 
 
@@ -1100,6 +1211,7 @@ void ega_mem_set_uint8 (ega_t *ega, unsigned long addr, unsigned char val)
 		ega->mem[addr + 0x30000] = col[3];
 	}
 
+	ega->mem_dirty[addr >> 8] |= mapmsk;
 	ega->update_state |= EGA_UPDATE_DIRTY;
 }
 
@@ -1131,7 +1243,7 @@ void ega_atc_set_reg (ega_t *ega, unsigned reg, unsigned char val)
 
 	ega->reg_atc[reg] = val;
 
-	ega->update_state |= EGA_UPDATE_DIRTY;
+	ega_set_dirty (ega);
 }
 
 
@@ -1156,7 +1268,7 @@ void ega_seq_set_reg (ega_t *ega, unsigned reg, unsigned char val)
 
 	case EGA_SEQ_CLOCK: /* 1 */
 		ega->reg_seq[EGA_SEQ_CLOCK] = val;
-		ega->update_state |= EGA_UPDATE_DIRTY;
+		ega_set_dirty (ega);
 		break;
 
 	case EGA_SEQ_MAPMASK: /* 2 */
@@ -1165,7 +1277,7 @@ void ega_seq_set_reg (ega_t *ega, unsigned reg, unsigned char val)
 
 	case EGA_SEQ_CMAPSEL: /* 3 */
 		ega->reg_seq[EGA_SEQ_CMAPSEL] = val;
-		ega->update_state |= EGA_UPDATE_DIRTY;
+		ega_set_dirty (ega);
 		break;
 
 	case EGA_SEQ_MODE: /* 4 */
@@ -1192,7 +1304,7 @@ void ega_grc_set_reg (ega_t *ega, unsigned reg, unsigned char val)
 	ega->reg_grc[reg] = val;
 
 	if (reg == EGA_GRC_MODE) {
-		ega->update_state |= EGA_UPDATE_DIRTY;
+		ega_set_dirty (ega);
 	}
 }
 
@@ -1234,7 +1346,7 @@ void ega_crtc_set_reg (ega_t *ega, unsigned reg, unsigned char val)
 
 	ega_set_timing (ega);
 
-	ega->update_state |= EGA_UPDATE_DIRTY;
+	ega_set_dirty (ega);
 }
 
 
@@ -1458,7 +1570,7 @@ void ega_set_misc_out (ega_t *ega, unsigned char val)
 {
 	ega->reg[EGA_MOUT] = val;
 
-	ega->update_state |= EGA_UPDATE_DIRTY;
+	ega_set_dirty (ega);
 }
 
 /*
@@ -1622,6 +1734,8 @@ void ega_print_info (ega_t *ega, FILE *fp)
 static
 void ega_redraw (ega_t *ega, int now)
 {
+	ega_set_dirty (ega);
+
 	if (now) {
 		if (ega->term != NULL) {
 			ega_update (ega);
@@ -1630,13 +1744,12 @@ void ega_redraw (ega_t *ega, int now)
 			trm_update (ega->term);
 		}
 	}
-
-	ega->update_state |= EGA_UPDATE_DIRTY;
 }
 
 static
 void ega_clock (ega_t *ega, unsigned long cnt)
 {
+	int           skip;
 	unsigned      addr;
 	unsigned long clk;
 
@@ -1662,7 +1775,7 @@ void ega_clock (ega_t *ega, unsigned long cnt)
 
 		if (ega->latch_addr != addr) {
 			ega->latch_addr = addr;
-			ega->update_state |= EGA_UPDATE_DIRTY;
+			ega_set_dirty (ega);
 		}
 	}
 
@@ -1678,19 +1791,32 @@ void ega_clock (ega_t *ega, unsigned long cnt)
 			ega->blink_on = !ega->blink_on;
 
 			if ((ega->reg_atc[EGA_ATC_MODE] & EGA_ATC_MODE_G) == 0) {
-				ega->update_state |= EGA_UPDATE_DIRTY;
+				ega_set_dirty (ega);
 			}
 			else if (ega->reg_atc[EGA_ATC_MODE] & EGA_ATC_MODE_EB) {
-				ega->update_state |= EGA_UPDATE_DIRTY;
+				ega_set_dirty (ega);
 			}
 		}
 	}
 
+	skip = 0;
+
 	if (ega->term != NULL) {
 		if (ega->update_state & EGA_UPDATE_DIRTY) {
-			ega_update (ega);
-			trm_set_size (ega->term, ega->buf_w, ega->buf_h);
-			trm_set_lines (ega->term, ega->buf, 0, ega->buf_h);
+			if (pce_frame_next (&ega->video.frame, 1)) {
+				ega_update (ega);
+				trm_set_size (ega->term, ega->buf_w, ega->buf_h);
+				trm_set_lines (ega->term,
+					ega->buf + 3UL * ega->update_y * ega->buf_w,
+					ega->update_y, ega->update_h
+				);
+			}
+			else {
+				skip = 1;
+			}
+		}
+		else {
+			pce_frame_next (&ega->video.frame, 0);
 		}
 
 		trm_update (ega->term);
@@ -1698,6 +1824,11 @@ void ega_clock (ega_t *ega, unsigned long cnt)
 
 	ega->update_state = EGA_UPDATE_RETRACE;
 
+	if (skip) {
+		/* render the skipped frame later */
+		ega->update_state |= EGA_UPDATE_DIRTY;
+	}
+
 	if ((ega->reg_crt[EGA_CRT_VRE] & EGA_CRT_VRE_EVI) == 0) {
 		/* vertical retrace interrupt enabled */
 		ega_set_irq (ega, 1);
@@ -1809,6 +1940,14 @@ void ega_init (ega_t *ega, unsigned long io, unsigned long addr)
 
 	ega->update_state = 0;
 
+	ega->gen = 1;
+	ega->update_gen = 0;
+
+	memset (ega->mem_dirty, 0, sizeof (ega->mem_dirty));
+
+	ega->update_y = 0;
+	ega->update_h = 0;
+
 	ega->set_irq_ext = NULL;
 	ega->set_irq = NULL;
 	ega->set_irq_val = 0;
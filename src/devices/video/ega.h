@@ -75,6 +75,17 @@ typedef struct ega_s {
 
 	unsigned char update_state;
 
+	/* incremented when a change affects the whole screen */
+	unsigned long gen;
+	unsigned long update_gen;
+
+	/* the planes written to, for each 256 byte page */
+	unsigned char mem_dirty[256];
+
+	/* the lines that were drawn by the last update */
+	unsigned      update_y;
+	unsigned      update_h;
+
 	void          *set_irq_ext;
 	void          (*set_irq) (void *ext, unsigned char val);
 	unsigned char set_irq_val;
@@ -222,7 +222,7 @@ void hgc_hsync (hgc_t *hgc)
 {
 	unsigned row, max, ch;
 
-	if (hgc->mod_cnt == 0) {
+	if ((hgc->mod_cnt == 0) || (hgc->video.frame.render == 0)) {
 		return;
 	}
 
@@ -259,14 +259,14 @@ void hgc_vsync (hgc_t *hgc)
 	if ((hgc->term != NULL) && (vid->buf_w > 0) && (vid->buf_h > 0)) {
 		trm_set_size (hgc->term, vid->buf_w, vid->buf_h);
 
-		if (hgc->mod_cnt > 0) {
+		if ((hgc->mod_cnt > 0) && vid->frame.render) {
 			trm_set_lines (hgc->term, vid->buf, 0, vid->buf_h);
 		}
 
 		trm_update (hgc->term);
 	}
 
-	if (hgc->mod_cnt > 0) {
+	if ((hgc->mod_cnt > 0) && vid->frame.render) {
 		hgc->mod_cnt -= 1;
 	}
 
@@ -294,6 +294,8 @@ void hgc_vsync (hgc_t *hgc)
 			hgc->mod_cnt = 1;
 		}
 	}
+
+	pce_frame_next (&vid->frame, hgc->mod_cnt > 0);
 }
 
 static
@@ -165,7 +165,7 @@ void mda_hsync (mda_t *mda)
 {
 	unsigned row, max, ch;
 
-	if (mda->mod_cnt == 0) {
+	if ((mda->mod_cnt == 0) || (mda->video.frame.render == 0)) {
 		return;
 	}
 
@@ -199,14 +199,14 @@ void mda_vsync (mda_t *mda)
 	if ((mda->term != NULL) && (vid->buf_w > 0) && (vid->buf_h > 0)) {
 		trm_set_size (mda->term, vid->buf_w, vid->buf_h);
 
-		if (mda->mod_cnt > 0) {
+		if ((mda->mod_cnt > 0) && vid->frame.render) {
 			trm_set_lines (mda->term, vid->buf, 0, vid->buf_h);
 		}
 
 		trm_update (mda->term);
 	}
 
-	if (mda->mod_cnt > 0) {
+	if ((mda->mod_cnt > 0) && vid->frame.render) {
 		mda->mod_cnt -= 1;
 	}
 
@@ -234,6 +234,8 @@ void mda_vsync (mda_t *mda)
 			mda->mod_cnt = 1;
 		}
 	}
+
+	pce_frame_next (&vid->frame, mda->mod_cnt > 0);
 }
 
 static
@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <lib/log.h>
 #include <lib/msg.h>
@@ -169,6 +170,17 @@
 static void vga_clock (vga_t *vga, unsigned long cnt);
 
 
+/*
+ * Mark the whole screen as modified
+ */
+static
+void vga_set_dirty (vga_t *vga)
+{
+	vga->gen += 1;
+	vga->update_state |= VGA_UPDATE_DIRTY;
+}
+
+
 static
 void vga_set_irq (vga_t *vga, unsigned char val)
 {
@@ -202,7 +214,7 @@ void vga_set_blink_rate (vga_t *vga, unsigned rate, int start)
 	vga->blink_cnt = rate;
 	vga->blink_freq = rate;
 
-	vga->update_state |= VGA_UPDATE_DIRTY;
+	vga_set_dirty (vga);
 }
 
 /*
@@ -398,7 +410,7 @@ void vga_set_timing (vga_t *vga)
 	vga->clk_vd = v;
 
 	if (d) {
-		vga->update_state |= VGA_UPDATE_DIRTY;
+		vga_set_dirty (vga);
 	}
 }
 
@@ -483,6 +495,10 @@ int vga_set_buf_size (vga_t *vga, unsigned w, unsigned h)
 		vga->bufmax = cnt;
 	}
 
+	if ((vga->buf_w != w) || (vga->buf_h != h)) {
+		vga->gen += 1;
+	}
+
 	vga->buf_w = w;
 	vga->buf_h = h;
 
@@ -588,16 +604,40 @@ void vga_mode0_update_char (vga_t *vga, unsigned char *dst, unsigned w,
 	}
 }
 
+/*
+ * Check if any of cnt characters starting at CRTC address addr use
+ * video memory that was written since the last update
+ */
+static
+int vga_text_changed (vga_t *vga, unsigned addr, unsigned cnt)
+{
+	unsigned p;
+
+	while (cnt > 0) {
+		p = vga_get_crtc_addr (vga, addr, 0);
+
+		if (vga->mem_dirty[(p >> 8) & 0xff] & 0x03) {
+			return (1);
+		}
+
+		addr = (addr + 1) & 0xffff;
+		cnt -= 1;
+	}
+
+	return (0);
+}
+
 /*
  * Update text mode
  */
 static
 void vga_update_text (vga_t *vga)
 {
-	unsigned            x, y, w, h, cw, ch;
+	unsigned            i, x, y, w, h, cw, ch;
 	unsigned            w2, h2;
 	unsigned            addr, rptr, rofs, p;
-	unsigned            cpos;
+	unsigned            cpos, cols;
+	int                 full;
 	const unsigned char *src;
 	unsigned char       *dst;
 
@@ -610,12 +650,26 @@ void vga_update_text (vga_t *vga)
 		return;
 	}
 
+	full = (vga->gen != vga->update_gen);
+
+	/* the font is in plane 2 */
+	for (i = 0; i < 256; i++) {
+		if (vga->mem_dirty[i] & 0x04) {
+			full = 1;
+			break;
+		}
+	}
+
 	src = vga->mem;
 	dst = vga->buf;
 
 	addr = vga->latch_addr;
 	rofs = 2 * vga->reg_crt[VGA_CRT_OFS];
 	cpos = vga_get_cursor (vga);
+	cols = (w + cw - 1) / cw;
+
+	vga->update_y = h;
+	vga->update_h = 0;
 
 	y = 0;
 
@@ -630,23 +684,34 @@ void vga_update_text (vga_t *vga)
 
 		rptr = addr;
 
-		x = 0;
-		while (x < w) {
-			w2 = w - x;
-
-			if (w2 > cw) {
-				w2 = cw;
+		if (full || vga_text_changed (vga, rptr, cols)) {
+			if (y < vga->update_y) {
+				vga->update_y = y;
 			}
 
-			p = vga_get_crtc_addr (vga, rptr, 0);
+			vga->update_h = y + h2 - vga->update_y;
+
+			x = 0;
+			while (x < w) {
+				w2 = w - x;
 
-			vga_mode0_update_char (vga, dst + 3 * x, w, w2, h2,
-				src[p], src[p + 0x10000], rptr == cpos
-			);
+				if (w2 > cw) {
+					w2 = cw;
+				}
+
+				p = vga_get_crtc_addr (vga, rptr, 0);
 
-			rptr = (rptr + 1) & 0xffff;
+				vga_mode0_update_char (vga, dst + 3 * x, w, w2, h2,
+					src[p], src[p + 0x10000], rptr == cpos
+				);
 
-			x += w2;
+				rptr = (rptr + 1) & 0xffff;
+
+				x += w2;
+			}
+		}
+		else {
+			rptr = (rptr + cols) & 0xffff;
 		}
 
 		if (rofs == 0) {
@@ -660,6 +725,29 @@ void vga_update_text (vga_t *vga)
 	}
 }
 
+/*
+ * Check if any of cnt character clocks starting at CRTC address addr
+ * use video memory that was written since the last update
+ */
+static
+int vga_graphics_changed (vga_t *vga, unsigned addr, unsigned row, unsigned cnt)
+{
+	unsigned p;
+
+	while (cnt > 0) {
+		p = vga_get_crtc_addr (vga, addr, row);
+
+		if (vga->mem_dirty[(p >> 8) & 0xff]) {
+			return (1);
+		}
+
+		addr = (addr + 1) & 0xffff;
+		cnt -= 1;
+	}
+
+	return (0);
+}
+
 /*
  * Update graphics modes
  *
@@ -676,7 +764,7 @@ void vga_update_graphics (vga_t *vga)
 	unsigned            msk, bit;
 	unsigned            idx;
 	unsigned char       buf[4];
-	int                 m256, mcga;
+	int                 m256, mcga, full;
 	const unsigned char *src;
 	unsigned char       *dst;
 
@@ -713,6 +801,9 @@ void vga_update_graphics (vga_t *vga)
 		return;
 	}
 
+	/* with an offset of 0, the next line depends on the last one */
+	full = (vga->gen != vga->update_gen) || (vga->reg_crt[VGA_CRT_OFS] == 0);
+
 	if (vga->reg_atc[VGA_ATC_MODE] & VGA_ATC_MODE_EB) {
 		blink1 = 0xff;
 		blink2 = vga->blink_on ? 0xff : 0x00;
@@ -740,6 +831,9 @@ void vga_update_graphics (vga_t *vga)
 	row1 = 0;
 	y = 0;
 
+	vga->update_y = h;
+	vga->update_h = 0;
+
 	while (y < h) {
 		if (y == lcmp) {
 			addr = 0;
@@ -749,80 +843,88 @@ void vga_update_graphics (vga_t *vga)
 			}
 		}
 
-		dst = vga->buf + 3UL * y * w;
-
 		rptr = addr;
 
-		col = 0;
-		x = 0;
-
-		ptr = vga_get_crtc_addr (vga, rptr, row1);
-
-		buf[0] = src[ptr + 0x00000];
-		buf[1] = src[ptr + 0x10000];
-		buf[2] = src[ptr + 0x20000];
-		buf[3] = (src[ptr + 0x30000] ^ blink1) | blink2;
-
-		msk = 0x80 >> (hpp & 7);
+		if (full || vga_graphics_changed (vga, addr, row1, (hpp + w) / cw + 1)) {
+			if (y < vga->update_y) {
+				vga->update_y = y;
+			}
 
-		if (m256) {
-			bit = (hpp >> 1) & 3;
-		}
-		else if (mcga) {
-			bit = (2 * hpp) & 6;
-		}
+			vga->update_h = y + 1 - vga->update_y;
 
-		col = hpp;
+			dst = vga->buf + 3UL * y * w;
 
-		while (x < w) {
-			if (col >= cw) {
-				rptr = (rptr + 1) & 0xffff;
+			col = 0;
+			x = 0;
 
-				ptr = vga_get_crtc_addr (vga, rptr, row1);
+			ptr = vga_get_crtc_addr (vga, rptr, row1);
 
-				buf[0] = src[ptr + 0x00000];
-				buf[1] = src[ptr + 0x10000];
-				buf[2] = src[ptr + 0x20000];
-				buf[3] = (src[ptr + 0x30000] ^ blink1) | blink2;
+			buf[0] = src[ptr + 0x00000];
+			buf[1] = src[ptr + 0x10000];
+			buf[2] = src[ptr + 0x20000];
+			buf[3] = (src[ptr + 0x30000] ^ blink1) | blink2;
 
-				msk = 0x80;
-				bit = 0;
-				col = 0;
-			}
+			msk = 0x80 >> (hpp & 7);
 
 			if (m256) {
-				/* VGA 256 color mode */
-
-				idx = buf[bit & 3];
-				bit += 1;
+				bit = (hpp >> 1) & 3;
 			}
 			else if (mcga) {
-				/* CGA 4 color mode */
+				bit = (2 * hpp) & 6;
+			}
+
+			col = hpp;
+
+			while (x < w) {
+				if (col >= cw) {
+					rptr = (rptr + 1) & 0xffff;
 
-				idx = (buf[0] >> (6 - bit)) & 0x03;
-				bit += 2;
+					ptr = vga_get_crtc_addr (vga, rptr, row1);
 
-				if (bit > 6) {
-					buf[0] = buf[1];
-					buf[1] = 0;
+					buf[0] = src[ptr + 0x00000];
+					buf[1] = src[ptr + 0x10000];
+					buf[2] = src[ptr + 0x20000];
+					buf[3] = (src[ptr + 0x30000] ^ blink1) | blink2;
+
+					msk = 0x80;
 					bit = 0;
+					col = 0;
 				}
-			}
-			else {
-				/* EGA 16 color mode */
 
-				idx = (buf[0] & msk) ? 0x01 : 0x00;
-				idx |= (buf[1] & msk) ? 0x02 : 0x00;
-				idx |= (buf[2] & msk) ? 0x04 : 0x00;
-				idx |= (buf[3] & msk) ? 0x08 : 0x00;
-				msk >>= 1;
-			}
+				if (m256) {
+					/* VGA 256 color mode */
 
-			vga_get_palette (vga, idx, dst, dst + 1, dst + 2);
+					idx = buf[bit & 3];
+					bit += 1;
+				}
+				else if (mcga) {
+					/* CGA 4 color mode */
 
-			dst += 3;
-			col += 1;
-			x += 1;
+					idx = (buf[0] >> (6 - bit)) & 0x03;
+					bit += 2;
+
+					if (bit > 6) {
+						buf[0] = buf[1];
+						buf[1] = 0;
+						bit = 0;
+					}
+				}
+				else {
+					/* EGA 16 color mode */
+
+					idx = (buf[0] & msk) ? 0x01 : 0x00;
+					idx |= (buf[1] & msk) ? 0x02 : 0x00;
+					idx |= (buf[2] & msk) ? 0x04 : 0x00;
+					idx |= (buf[3] & msk) ? 0x08 : 0x00;
+					msk >>= 1;
+				}
+
+				vga_get_palette (vga, idx, dst, dst + 1, dst + 2);
+
+				dst += 3;
+				col += 1;
+				x += 1;
+			}
 		}
 
 		row0 += 1;
@@ -908,6 +1010,13 @@ void vga_update (vga_t *vga)
 
 	if (show == 0) {
 		vga_update_blank (vga);
+
+		vga->update_y = 0;
+		vga->update_h = vga->buf_h;
+
+		/* the next update can't be incremental */
+		vga->gen += 1;
+
 		return;
 	}
 
@@ -917,6 +1026,10 @@ void vga_update (vga_t *vga)
 	else {
 		vga_update_text (vga);
 	}
+
+	memset (vga->mem_dirty, 0, sizeof (vga->mem_dirty));
+
+	vga->update_gen = vga->gen;
 }
 
 
@@ -1031,45 +1144,45 @@ unsigned short vga_mem_get_uint16 (vga_t *vga, unsigned long addr)
 	return (val);
 }
 
+/*
+ * Write the planes selected by mapmsk, using the latches for the bits
+ * that are not set in bitmsk
+ */
 static
-void vga_mem_set_uint8 (vga_t *vga, unsigned long addr, unsigned char val)
+void vga_mem_set_planes (vga_t *vga, unsigned addr,
+	const unsigned char *col, unsigned char bitmsk, unsigned char mapmsk)
 {
-	unsigned      wrmode;
-	unsigned      rot;
-	unsigned char mapmsk, bitmsk;
-	unsigned char esr, set;
-	unsigned char col[4];
-
-	if ((vga->reg[VGA_MOUT] & VGA_MOUT_ERAM) == 0) {
-		return;
+	if (mapmsk & 0x01) {
+		vga->mem[addr + 0x00000] = (col[0] & bitmsk) | (vga->latch[0] & ~bitmsk);
 	}
 
-	switch ((vga->reg_grc[VGA_GRC_MISC] >> 2) & 3) {
-	case 0: /* 128K at A000 */
-		break;
-
-	case 1: /* 64K at A000 */
-		if (addr > 0xffff) {
-			return;
-		}
-		break;
+	if (mapmsk & 0x02) {
+		vga->mem[addr + 0x10000] = (col[1] & bitmsk) | (vga->latch[1] & ~bitmsk);
+	}
 
-	case 2: /* 32K at B000 */
-		if ((addr < 0x10000) || (addr > 0x17fff)) {
-			return;
-		}
-		addr -= 0x10000;
-		break;
+	if (mapmsk & 0x04) {
+		vga->mem[addr + 0x20000] = (col[2] & bitmsk) | (vga->latch[2] & ~bitmsk);
+	}
 
-	case 3: /* 32K at B800 */
-		if ((addr < 0x18000) || (addr > 0x1ffff)) {
-			return;
-		}
-		addr -= 0x18000;
-		break;
+	if (mapmsk & 0x08) {
+		vga->mem[addr + 0x30000] = (col[3] & bitmsk) | (vga->latch[3] & ~bitmsk);
 	}
 
-	addr &= 0xffff;
+	vga->mem_dirty[addr >> 8] |= mapmsk;
+	vga->update_state |= VGA_UPDATE_DIRTY;
+}
+
+/*
+ * Write a byte in any mode
+ */
+static
+void vga_mem_set_any (vga_t *vga, unsigned addr, unsigned char val)
+{
+	unsigned      wrmode;
+	unsigned      rot;
+	unsigned char mapmsk, bitmsk;
+	unsigned char esr, set;
+	unsigned char col[4];
 
 	wrmode = vga->reg_grc[VGA_GRC_MODE] & 3;
 	mapmsk = vga->reg_seq[VGA_SEQ_MAPMASK];
@@ -1159,39 +1272,224 @@ void vga_mem_set_uint8 (vga_t *vga, unsigned long addr, unsigned char val)
 		}
 	}
 
-	col[0] = (col[0] & bitmsk) | (vga->latch[0] & ~bitmsk);
-	col[1] = (col[1] & bitmsk) | (vga->latch[1] & ~bitmsk);
-	col[2] = (col[2] & bitmsk) | (vga->latch[2] & ~bitmsk);
-	col[3] = (col[3] & bitmsk) | (vga->latch[3] & ~bitmsk);
+	vga_mem_set_planes (vga, addr, col, bitmsk, mapmsk);
+}
+
+/*
+ * Write a byte in chain 4 mode, write mode 0, copy, no rotation,
+ * no set/reset and all bits enabled (mode 13h)
+ */
+static
+void vga_mem_set_ch4_copy (vga_t *vga, unsigned addr, unsigned char val)
+{
+	unsigned plane;
+
+	plane = addr & 3;
+	addr &= 0xfffc;
+
+	vga->mem[((unsigned long) plane << 16) + addr] = val;
+
+	vga->mem_dirty[addr >> 8] |= 1 << plane;
+	vga->update_state |= VGA_UPDATE_DIRTY;
+}
+
+/*
+ * Write a byte in planar mode, write mode 0, copy
+ */
+static
+void vga_mem_set_m0_copy (vga_t *vga, unsigned addr, unsigned char val)
+{
+	unsigned      rot;
+	unsigned char col[4];
+
+	rot = vga->wr_rot;
+	val = ((val >> rot) | (val << (8 - rot))) & 0xff;
+
+	col[0] = vga->wr_col[0] | (val & vga->wr_val[0]);
+	col[1] = vga->wr_col[1] | (val & vga->wr_val[1]);
+	col[2] = vga->wr_col[2] | (val & vga->wr_val[2]);
+	col[3] = vga->wr_col[3] | (val & vga->wr_val[3]);
+
+	vga_mem_set_planes (vga, addr, col, vga->wr_bitmsk, vga->wr_mapmsk);
+}
+
+/*
+ * Write a byte in planar mode, write mode 1
+ */
+static
+void vga_mem_set_m1 (vga_t *vga, unsigned addr, unsigned char val)
+{
+	unsigned char mapmsk;
+
+	mapmsk = vga->wr_mapmsk;
 
 	if (mapmsk & 0x01) {
-		vga->mem[addr + 0x00000] = col[0];
+		vga->mem[addr + 0x00000] = vga->latch[0];
 	}
 
 	if (mapmsk & 0x02) {
-		vga->mem[addr + 0x10000] = col[1];
+		vga->mem[addr + 0x10000] = vga->latch[1];
 	}
 
 	if (mapmsk & 0x04) {
-		vga->mem[addr + 0x20000] = col[2];
+		vga->mem[addr + 0x20000] = vga->latch[2];
 	}
 
 	if (mapmsk & 0x08) {
-		vga->mem[addr + 0x30000] = col[3];
+		vga->mem[addr + 0x30000] = vga->latch[3];
 	}
 
+	vga->mem_dirty[addr >> 8] |= mapmsk;
 	vga->update_state |= VGA_UPDATE_DIRTY;
 }
 
+/*
+ * Write a byte in planar mode, write mode 2, copy
+ */
 static
-void vga_mem_set_uint16 (vga_t *vga, unsigned long addr, unsigned short val)
+void vga_mem_set_m2_copy (vga_t *vga, unsigned addr, unsigned char val)
 {
+	unsigned char col[4];
+
+	col[0] = (val & 0x01) ? 0xff : 0x00;
+	col[1] = (val & 0x02) ? 0xff : 0x00;
+	col[2] = (val & 0x04) ? 0xff : 0x00;
+	col[3] = (val & 0x08) ? 0xff : 0x00;
+
+	vga_mem_set_planes (vga, addr, col, vga->wr_bitmsk, vga->wr_mapmsk);
+}
+
+/*
+ * Write a byte in planar mode, write mode 3, copy
+ */
+static
+void vga_mem_set_m3_copy (vga_t *vga, unsigned addr, unsigned char val)
+{
+	unsigned rot;
+
+	rot = vga->wr_rot;
+	val = ((val >> rot) | (val << (8 - rot))) & 0xff;
+
+	vga_mem_set_planes (vga, addr, vga->wr_col,
+		vga->wr_bitmsk & val, vga->wr_mapmsk
+	);
+}
+
+/*
+ * Select the memory write function after a register change
+ */
+static
+void vga_set_mem_fct (vga_t *vga)
+{
+	unsigned      i, wrmode, op, mode;
+	unsigned char esr, set;
+
 	if ((vga->reg[VGA_MOUT] & VGA_MOUT_ERAM) == 0) {
+		vga->wr_base = 0;
+		vga->wr_size = 0;
+	}
+	else {
+		switch ((vga->reg_grc[VGA_GRC_MISC] >> 2) & 3) {
+		case 0: /* 128K at A000 */
+			vga->wr_base = 0;
+			vga->wr_size = 0x20000;
+			break;
+
+		case 1: /* 64K at A000 */
+			vga->wr_base = 0;
+			vga->wr_size = 0x10000;
+			break;
+
+		case 2: /* 32K at B000 */
+			vga->wr_base = 0x10000;
+			vga->wr_size = 0x8000;
+			break;
+
+		case 3: /* 32K at B800 */
+			vga->wr_base = 0x18000;
+			vga->wr_size = 0x8000;
+			break;
+		}
+	}
+
+	wrmode = vga->reg_grc[VGA_GRC_MODE] & 3;
+	op = (vga->reg_grc[VGA_GRC_ROTATE] >> 3) & 3;
+	mode = vga->reg_seq[VGA_SEQ_MODE];
+	esr = vga->reg_grc[VGA_GRC_ENABLESR];
+	set = vga->reg_grc[VGA_GRC_SETRESET];
+
+	vga->wr_mapmsk = vga->reg_seq[VGA_SEQ_MAPMASK] & 0x0f;
+	vga->wr_bitmsk = vga->reg_grc[VGA_GRC_BITMASK];
+	vga->wr_rot = vga->reg_grc[VGA_GRC_ROTATE] & 7;
+
+	for (i = 0; i < 4; i++) {
+		if (wrmode == 3) {
+			vga->wr_col[i] = (set & (1 << i)) ? 0xff : 0x00;
+			vga->wr_val[i] = 0x00;
+		}
+		else if (esr & (1 << i)) {
+			vga->wr_col[i] = (set & (1 << i)) ? 0xff : 0x00;
+			vga->wr_val[i] = 0x00;
+		}
+		else {
+			vga->wr_col[i] = 0x00;
+			vga->wr_val[i] = 0xff;
+		}
+	}
+
+	vga->mem_set = vga_mem_set_any;
+
+	if (mode & VGA_SEQ_MODE_CH4) {
+		if ((wrmode == 0) && (op == 0) && (vga->wr_rot == 0)) {
+			if (((esr & 0x0f) == 0) && (vga->wr_bitmsk == 0xff)) {
+				vga->mem_set = vga_mem_set_ch4_copy;
+			}
+		}
+	}
+	else if (mode & VGA_SEQ_MODE_OE) {
+		if (wrmode == 1) {
+			vga->mem_set = vga_mem_set_m1;
+		}
+		else if (op == 0) {
+			if (wrmode == 0) {
+				vga->mem_set = vga_mem_set_m0_copy;
+			}
+			else if (wrmode == 2) {
+				vga->mem_set = vga_mem_set_m2_copy;
+			}
+			else {
+				vga->mem_set = vga_mem_set_m3_copy;
+			}
+		}
+	}
+}
+
+static
+void vga_mem_set_uint8 (vga_t *vga, unsigned long addr, unsigned char val)
+{
+	addr -= vga->wr_base;
+
+	if (addr >= vga->wr_size) {
 		return;
 	}
 
-	vga_mem_set_uint8 (vga, addr, val & 0xff);
-	vga_mem_set_uint8 (vga, addr + 1, (val >> 8) & 0xff);
+	vga->mem_set (vga, addr & 0xffff, val);
+}
+
+static
+void vga_mem_set_uint16 (vga_t *vga, unsigned long addr, unsigned short val)
+{
+	addr -= vga->wr_base;
+
+	if (addr < vga->wr_size) {
+		vga->mem_set (vga, addr & 0xffff, val & 0xff);
+	}
+
+	addr += 1;
+
+	if (addr < vga->wr_size) {
+		vga->mem_set (vga, addr & 0xffff, (val >> 8) & 0xff);
+	}
 }
 
 
@@ -1224,7 +1522,7 @@ void vga_atc_set_reg (vga_t *vga, unsigned reg, unsigned char val)
 
 	vga->reg_atc[reg] = val;
 
-	vga->update_state |= VGA_UPDATE_DIRTY;
+	vga_set_dirty (vga);
 }
 
 
@@ -1262,20 +1560,22 @@ void vga_seq_set_reg (vga_t *vga, unsigned reg, unsigned char val)
 
 	case VGA_SEQ_CLOCK: /* 1 */
 		vga->reg_seq[VGA_SEQ_CLOCK] = val;
-		vga->update_state |= VGA_UPDATE_DIRTY;
+		vga_set_dirty (vga);
 		break;
 
 	case VGA_SEQ_MAPMASK: /* 2 */
 		vga->reg_seq[VGA_SEQ_MAPMASK] = val;
+		vga_set_mem_fct (vga);
 		break;
 
 	case VGA_SEQ_CMAPSEL: /* 3 */
 		vga->reg_seq[VGA_SEQ_CMAPSEL] = val;
-		vga->update_state |= VGA_UPDATE_DIRTY;
+		vga_set_dirty (vga);
 		break;
 
 	case VGA_SEQ_MODE: /* 4 */
 		vga->reg_seq[VGA_SEQ_MODE] = val;
+		vga_set_mem_fct (vga);
 		break;
 	}
 }
@@ -1310,8 +1610,10 @@ void vga_grc_set_reg (vga_t *vga, unsigned reg, unsigned char val)
 
 	vga->reg_grc[reg] = val;
 
+	vga_set_mem_fct (vga);
+
 	if (reg == VGA_GRC_MODE) {
-		vga->update_state |= VGA_UPDATE_DIRTY;
+		vga_set_dirty (vga);
 	}
 }
 
@@ -1366,7 +1668,7 @@ void vga_crtc_set_reg (vga_t *vga, unsigned reg, unsigned char val)
 
 	vga_set_timing (vga);
 
-	vga->update_state |= VGA_UPDATE_DIRTY;
+	vga_set_dirty (vga);
 }
 
 
@@ -1705,7 +2007,7 @@ void vga_set_dac_data (vga_t *vga, unsigned char val)
 
 	if (vga->reg_dac[vga->dac_addr_write] != val) {
 		vga->reg_dac[vga->dac_addr_write] = val;
-		vga->update_state |= VGA_UPDATE_DIRTY;
+		vga_set_dirty (vga);
 	}
 
 	vga->dac_addr_write += 1;
@@ -1799,7 +2101,9 @@ void vga_set_misc_out (vga_t *vga, unsigned char val)
 {
 	vga->reg[VGA_MOUT] = val;
 
-	vga->update_state |= VGA_UPDATE_DIRTY;
+	vga_set_mem_fct (vga);
+
+	vga_set_dirty (vga);
 }
 
 /*
@@ -1970,6 +2274,8 @@ void vga_print_info (vga_t *vga, FILE *fp)
 static
 void vga_redraw (vga_t *vga, int now)
 {
+	vga_set_dirty (vga);
+
 	if (now) {
 		if (vga->term != NULL) {
 			vga_update (vga);
@@ -1978,13 +2284,12 @@ void vga_redraw (vga_t *vga, int now)
 			trm_update (vga->term);
 		}
 	}
-
-	vga->update_state |= VGA_UPDATE_DIRTY;
 }
 
 static
 void vga_clock (vga_t *vga, unsigned long cnt)
 {
+	int           skip;
 	unsigned      addr;
 	unsigned long clk;
 
@@ -2010,7 +2315,7 @@ void vga_clock (vga_t *vga, unsigned long cnt)
 
 		if (vga->latch_addr != addr) {
 			vga->latch_addr = addr;
-			vga->update_state |= VGA_UPDATE_DIRTY;
+			vga_set_dirty (vga);
 		}
 	}
 
@@ -2026,19 +2331,32 @@ void vga_clock (vga_t *vga, unsigned long cnt)
 			vga->blink_on = !vga->blink_on;
 
 			if ((vga->reg_atc[VGA_ATC_MODE] & VGA_ATC_MODE_G) == 0) {
-				vga->update_state |= VGA_UPDATE_DIRTY;
+				vga_set_dirty (vga);
 			}
 			else if (vga->reg_atc[VGA_ATC_MODE] & VGA_ATC_MODE_EB) {
-				vga->update_state |= VGA_UPDATE_DIRTY;
+				vga_set_dirty (vga);
 			}
 		}
 	}
 
+	skip = 0;
+
 	if (vga->term != NULL) {
 		if (vga->update_state & VGA_UPDATE_DIRTY) {
-			vga_update (vga);
-			trm_set_size (vga->term, vga->buf_w, vga->buf_h);
-			trm_set_lines (vga->term, vga->buf, 0, vga->buf_h);
+			if (pce_frame_next (&vga->video.frame, 1)) {
+				vga_update (vga);
+				trm_set_size (vga->term, vga->buf_w, vga->buf_h);
+				trm_set_lines (vga->term,
+					vga->buf + 3UL * vga->update_y * vga->buf_w,
+					vga->update_y, vga->update_h
+				);
+			}
+			else {
+				skip = 1;
+			}
+		}
+		else {
+			pce_frame_next (&vga->video.frame, 0);
 		}
 
 		trm_update (vga->term);
@@ -2046,6 +2364,11 @@ void vga_clock (vga_t *vga, unsigned long cnt)
 
 	vga->update_state = VGA_UPDATE_RETRACE;
 
+	if (skip) {
+		/* render the skipped frame later */
+		vga->update_state |= VGA_UPDATE_DIRTY;
+	}
+
 	if ((vga->reg_crt[VGA_CRT_VRE] & VGA_CRT_VRE_EVI) == 0) {
 		/* vertical retrace interrupt enabled */
 		vga_set_irq (vga, 1);
@@ -2139,6 +2462,8 @@ void vga_init (vga_t *vga, unsigned long io, unsigned long addr)
 		vga->latch[i] = 0;
 	}
 
+	vga_set_mem_fct (vga);
+
 	vga->latch_addr = 0;
 	vga->latch_hpp = 0;
 
@@ -2166,6 +2491,14 @@ void vga_init (vga_t *vga, unsigned long io, unsigned long addr)
 
 	vga->update_state = 0;
 
+	vga->gen = 1;
+	vga->update_gen = 0;
+
+	memset (vga->mem_dirty, 0, sizeof (vga->mem_dirty));
+
+	vga->update_y = 0;
+	vga->update_h = 0;
+
 	vga->set_irq_ext = NULL;
 	vga->set_irq = NULL;
 	vga->set_irq_val = 0;
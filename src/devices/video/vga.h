@@ -57,6 +57,18 @@ typedef struct vga_s {
 
 	unsigned char latch[4];
 
+	/* the memory write function, selected by vga_set_mem_fct() */
+	void          (*mem_set) (struct vga_s *vga, unsigned addr, unsigned char val);
+
+	/* these are derived from the write related registers */
+	unsigned long wr_base;
+	unsigned long wr_size;
+	unsigned char wr_mapmsk;
+	unsigned char wr_bitmsk;
+	unsigned char wr_rot;
+	unsigned char wr_col[4];
+	unsigned char wr_val[4];
+
 	char          blink_on;
 	unsigned      blink_cnt;
 	unsigned      blink_freq;
@@ -74,6 +86,17 @@ typedef struct vga_s {
 
 	unsigned char update_state;
 
+	/* incremented when a change affects the whole screen */
+	unsigned long gen;
+	unsigned long update_gen;
+
+	/* the planes written to, for each 256 byte page */
+	unsigned char mem_dirty[256];
+
+	/* the lines that were drawn by the last update */
+	unsigned      update_y;
+	unsigned      update_h;
+
 	void          *set_irq_ext;
 	void          (*set_irq) (void *ext, unsigned char val);
 	unsigned char set_irq_val;
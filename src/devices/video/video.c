@@ -26,10 +26,110 @@
 #include <string.h>
 
 #include <lib/msg.h>
+#include <lib/sysdep.h>
 
 #include "video.h"
 
 
+void pce_frame_init (pce_frame_t *frm)
+{
+	frm->max_fps = 0;
+	frm->skip_max = 0;
+	frm->period = 0;
+
+	frm->render = 1;
+	frm->skip_cnt = 0;
+
+	frm->clk = 0;
+	frm->since = 0;
+	frm->lag = 0;
+
+	frm->rendered = 0;
+	frm->dropped = 0;
+
+	pce_get_interval_us (&frm->clk);
+}
+
+void pce_frame_set_params (pce_frame_t *frm, unsigned max_fps, unsigned skip_max, unsigned hz)
+{
+	frm->max_fps = max_fps;
+	frm->skip_max = skip_max;
+	frm->period = (hz > 0) ? (1000000 / hz) : 0;
+
+	frm->skip_cnt = 0;
+	frm->lag = 0;
+}
+
+int pce_frame_next (pce_frame_t *frm, int dirty)
+{
+	int           skip;
+	unsigned long dt;
+
+	if ((frm->max_fps == 0) && (frm->skip_max == 0)) {
+		if (dirty) {
+			frm->rendered += 1;
+		}
+
+		frm->render = 1;
+
+		return (1);
+	}
+
+	dt = pce_get_interval_us (&frm->clk);
+
+	frm->since += dt;
+
+	/* how far the emulation is behind real time */
+	if (frm->period > 0) {
+		frm->lag += dt;
+		frm->lag = (frm->lag > frm->period) ? (frm->lag - frm->period) : 0;
+
+		if (frm->lag > 1000000) {
+			frm->lag = 1000000;
+		}
+	}
+
+	if (dirty == 0) {
+		frm->render = 1;
+		return (1);
+	}
+
+	skip = 0;
+
+	if ((frm->skip_max > 0) && (frm->period > 0)) {
+		if ((frm->lag > frm->period) && (frm->skip_cnt < frm->skip_max)) {
+			skip = 1;
+		}
+	}
+
+	if (frm->max_fps > 0) {
+		if (frm->since < (1000000 / frm->max_fps)) {
+			skip = 1;
+		}
+	}
+
+	if (skip) {
+		frm->skip_cnt += 1;
+		frm->dropped += 1;
+		frm->render = 0;
+		return (0);
+	}
+
+	frm->skip_cnt = 0;
+	frm->since = 0;
+	frm->rendered += 1;
+	frm->render = 1;
+
+	return (1);
+}
+
+void pce_frame_print_info (const pce_frame_t *frm, FILE *fp)
+{
+	fprintf (fp, "FRAMES: RENDERED=%lu DROPPED=%lu MAXFPS=%u SKIP=%u\n",
+		frm->rendered, frm->dropped, frm->max_fps, frm->skip_max
+	);
+}
+
 void pce_video_init (video_t *vid)
 {
 	vid->ext = NULL;
@@ -46,6 +146,8 @@ void pce_video_init (video_t *vid)
 	vid->dotclk[1] = 0;
 	vid->dotclk[2] = 0;
 
+	pce_frame_init (&vid->frame);
+
 	vid->del = NULL;
 	vid->set_msg = NULL;
 	vid->set_terminal = NULL;
@@ -102,6 +204,28 @@ int pce_video_set_msg (video_t *vid, const char *msg, const char *val)
 
 		return (0);
 	}
+	else if (msg_is_message ("emu.video.fps", msg)) {
+		unsigned v;
+
+		if (msg_get_uint (val, &v)) {
+			return (1);
+		}
+
+		vid->frame.max_fps = v;
+
+		return (0);
+	}
+	else if (msg_is_message ("emu.video.frameskip", msg)) {
+		unsigned v;
+
+		if (msg_get_uint (val, &v)) {
+			return (1);
+		}
+
+		vid->frame.skip_max = v;
+
+		return (0);
+	}
 
 	if (vid->set_msg != NULL) {
 		return (vid->set_msg (vid->ext, msg, val));
@@ -147,6 +271,8 @@ void pce_video_print_info (video_t *vid, FILE *fp)
 	if (vid->print_info != NULL) {
 		vid->print_info (vid->ext, fp);
 	}
+
+	pce_frame_print_info (&vid->frame, fp);
 }
 
 void pce_video_redraw (video_t *vid, int now)
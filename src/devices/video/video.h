@@ -29,6 +29,33 @@
 #include <devices/memory.h>
 
 
+/*!***************************************************************************
+ * @short The frame pacing state
+ *****************************************************************************/
+typedef struct {
+	/* render at most max_fps frames per host second (0 = no limit) */
+	unsigned      max_fps;
+
+	/* skip at most skip_max frames in a row if emulation is behind */
+	unsigned      skip_max;
+
+	/* the nominal emulated frame period in microseconds */
+	unsigned long period;
+
+	/* the result of the last call to pce_frame_next() */
+	char          render;
+
+	unsigned      skip_cnt;
+
+	unsigned long clk;
+	unsigned long since;
+	unsigned long lag;
+
+	unsigned long rendered;
+	unsigned long dropped;
+} pce_frame_t;
+
+
 typedef struct {
 	void      (*del) (void *ext);
 
@@ -58,6 +85,8 @@ typedef struct {
 
 	/* the dot clock (clock, remainder, last) */
 	unsigned long dotclk[3];
+
+	pce_frame_t   frame;
 } video_t;
 
 
@@ -70,6 +99,29 @@ typedef struct {
 	} while (0)
 
 
+void pce_frame_init (pce_frame_t *frm);
+
+/*!***************************************************************************
+ * @short Set the frame pacing parameters
+ * @param max_fps   Render at most max_fps frames per second (0 = no limit)
+ * @param skip_max  Skip at most skip_max frames in a row if the emulation
+ *                  falls behind real time (0 = never)
+ * @param hz        The nominal emulated frame rate
+ *****************************************************************************/
+void pce_frame_set_params (pce_frame_t *frm, unsigned max_fps, unsigned skip_max, unsigned hz);
+
+/*!***************************************************************************
+ * @short Decide whether to render an emulated frame
+ * @param dirty  If false, the frame doesn't need to be rendered anyway
+ * @return Non-zero if the frame should be rendered
+ *
+ * This function must be called exactly once per emulated frame.
+ *****************************************************************************/
+int pce_frame_next (pce_frame_t *frm, int dirty);
+
+void pce_frame_print_info (const pce_frame_t *frm, FILE *fp);
+
+
 void pce_video_init (video_t *vid);
 
 void pce_video_del (video_t *vid);
@@ -59,23 +59,77 @@ int dsk_pri_save (disk_pri_t *dp)
 
 	dp->img->readonly = 0;
 
+	/* the image file is about to be overwritten */
+	if (pri_img_load_all (dp->img)) {
+		return (1);
+	}
+
 	if (pri_img_save (dp->dsk.fname, dp->img, dp->type)) {
 		return (1);
 	}
 
+	pri_img_clear_dirty (dp->img);
+
+	if (pri_journal_remove (dp->dsk.fname)) {
+		return (1);
+	}
+
 	dp->dirty = 0;
+	dp->journal = 0;
+	dp->compact = 0;
 
 	return (0);
 }
 
+/*
+ * Append the modified tracks to the journal, or rewrite the image
+ * if that fails.
+ */
+static
+int dsk_pri_journal (disk_pri_t *dp)
+{
+	if ((dp->dsk.fname == NULL) || (dp->img == NULL)) {
+		return (1);
+	}
+
+	if (dsk_get_readonly (&dp->dsk)) {
+		return (1);
+	}
+
+	if (dp->compact == 0) {
+		if (pri_journal_save (dp->dsk.fname, dp->img) == 0) {
+			dp->dirty = 0;
+			dp->journal = 1;
+			return (0);
+		}
+	}
+
+	return (dsk_pri_save (dp));
+}
+
 static
-int dsk_pri_commit (disk_pri_t *dp)
+int dsk_pri_commit (disk_pri_t *dp, int compact)
 {
-	if (dp->dirty == 0) {
-		return (0);
+	int r;
+
+	if (compact) {
+		if (dp->dirty == 0) {
+			if ((dp->journal == 0) || dsk_get_readonly (&dp->dsk)) {
+				return (0);
+			}
+		}
+
+		r = dsk_pri_save (dp);
 	}
+	else {
+		if (dp->dirty == 0) {
+			return (0);
+		}
 
-	if (dsk_pri_save (dp)) {
+		r = dsk_pri_journal (dp);
+	}
+
+	if (r) {
 		fprintf (stderr,
 			"disk %u: writing back pri image to %s failed\n",
 			dp->dsk.drive,
@@ -92,7 +146,10 @@ static
 int dsk_pri_set_msg (disk_t *dsk, const char *msg, const char *val)
 {
 	if (strcmp (msg, "commit") == 0) {
-		return (dsk_pri_commit (dsk->ext));
+		return (dsk_pri_commit (dsk->ext, 0));
+	}
+	else if (strcmp (msg, "compact") == 0) {
+		return (dsk_pri_commit (dsk->ext, 1));
 	}
 
 	return (1);
@@ -105,7 +162,7 @@ void dsk_pri_del (disk_t *dsk)
 
 	dp = dsk->ext;
 
-	dsk_pri_commit (dp);
+	dsk_pri_commit (dp, 1);
 
 	if (dp->img != NULL) {
 		pri_img_del (dp->img);
@@ -114,12 +171,14 @@ void dsk_pri_del (disk_t *dsk)
 	free (dp);
 }
 
-disk_t *dsk_pri_open_fp (FILE *fp, unsigned type, int ro)
+static
+disk_t *dsk_pri_new (pri_img_t *img, unsigned type, int ro)
 {
 	disk_t     *dsk;
 	disk_pri_t *dp;
 
 	if ((dp = malloc (sizeof (disk_pri_t))) == NULL) {
+		pri_img_del (img);
 		return (NULL);
 	}
 
@@ -135,14 +194,11 @@ disk_t *dsk_pri_open_fp (FILE *fp, unsigned type, int ro)
 	dsk->set_msg = dsk_pri_set_msg;
 
 	dp->dirty = 0;
+	dp->journal = 0;
+	dp->compact = 0;
 	dp->type = type;
 
-	dp->img = pri_img_load_fp (fp, type);
-
-	if (dp->img == NULL) {
-		dsk_pri_del (dsk);
-		return (NULL);
-	}
+	dp->img = img;
 
 	if (dp->img->readonly) {
 		dsk_set_readonly (dsk, 1);
@@ -151,10 +207,24 @@ disk_t *dsk_pri_open_fp (FILE *fp, unsigned type, int ro)
 	return (dsk);
 }
 
+disk_t *dsk_pri_open_fp (FILE *fp, unsigned type, int ro)
+{
+	pri_img_t *img;
+
+	if ((img = pri_img_load_fp (fp, type)) == NULL) {
+		return (NULL);
+	}
+
+	return (dsk_pri_new (img, type, ro));
+}
+
 disk_t *dsk_pri_open (const char *fname, unsigned type, int ro)
 {
-	disk_t *dsk;
-	FILE   *fp;
+	unsigned long cnt;
+	disk_t        *dsk;
+	disk_pri_t    *dp;
+	pri_img_t     *img;
+	FILE          *fp;
 
 	if (type == PRI_FORMAT_NONE) {
 		type = pri_probe (fname);
@@ -184,16 +254,33 @@ disk_t *dsk_pri_open (const char *fname, unsigned type, int ro)
 		return (NULL);
 	}
 
-	dsk = dsk_pri_open_fp (fp, type, ro);
-
 	fclose (fp);
 
-	if (dsk == NULL) {
+	img = pri_img_load_lazy (fname, type, PCE_BLK_PRI_TRACKS);
+
+	if (img == NULL) {
+		return (NULL);
+	}
+
+	if ((dsk = dsk_pri_new (img, type, ro)) == NULL) {
 		return (NULL);
 	}
 
 	dsk_set_fname (dsk, fname);
 
+	dp = dsk->ext;
+
+	if (pri_journal_load (fname, dp->img, &cnt)) {
+		fprintf (stderr, "pri: damaged journal (%s.jnl)\n", fname);
+
+		dp->journal = 1;
+		dp->compact = 1;
+	}
+
+	if (cnt > 0) {
+		dp->journal = 1;
+	}
+
 	return (dsk);
 }
 
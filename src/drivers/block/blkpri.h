@@ -35,6 +35,10 @@
 #include <stdio.h>
 
 
+/* the number of unmodified tracks kept in memory when loading on demand */
+#define PCE_BLK_PRI_TRACKS 16
+
+
 typedef struct {
 	disk_t     dsk;
 
@@ -42,6 +46,12 @@ typedef struct {
 
 	char       dirty;
 
+	/* the image has a journal that has not been compacted */
+	char       journal;
+
+	/* the next write-back must rewrite the image */
+	char       compact;
+
 	unsigned   type;
 } disk_pri_t;
 
@@ -52,6 +52,20 @@ int dsk_psi_apply_weak (unsigned char *dst, const unsigned char *msk, unsigned c
 	return (r);
 }
 
+static
+void dsk_psi_set_dirty (disk_psi_t *fdc, unsigned c, unsigned h)
+{
+	psi_trk_t *trk;
+
+	fdc->dirty = 1;
+
+	trk = psi_img_get_track (fdc->img, c, h, 0);
+
+	if (trk != NULL) {
+		trk->dirty = 1;
+	}
+}
+
 unsigned dsk_psi_read_chs (disk_psi_t *fdc, void *buf, unsigned *cnt,
 	unsigned c, unsigned h, unsigned s, int phy)
 {
@@ -174,7 +188,7 @@ unsigned dsk_psi_write_chs (disk_psi_t *fdc, const void *buf, unsigned *cnt,
 		sct->flags &= ~PSI_FLAG_NO_DAM;
 	}
 
-	fdc->dirty = 1;
+	dsk_psi_set_dirty (fdc, c, h);
 
 	if (*cnt > sct->n) {
 		*cnt = sct->n;
@@ -218,7 +232,7 @@ unsigned dsk_psi_write_tags (disk_psi_t *fdc, const void *buf, unsigned cnt,
 		return (0);
 	}
 
-	fdc->dirty = 1;
+	dsk_psi_set_dirty (fdc, c, h);
 
 	cnt = psi_sct_set_tags (sct, buf, cnt);
 
@@ -244,6 +258,7 @@ int dsk_psi_erase_track (disk_psi_t *fdc, unsigned c, unsigned h)
 	}
 
 	fdc->dirty = 1;
+	trk->dirty = 1;
 
 	fdc->dsk.blocks -= trk->sct_cnt;
 
@@ -267,6 +282,7 @@ int dsk_psi_erase_disk (disk_psi_t *fdc)
 	fdc->dsk.blocks = 0;
 
 	fdc->dirty = 1;
+	fdc->compact = 1;
 
 	return (0);
 }
@@ -298,6 +314,7 @@ int dsk_psi_format_sector (disk_psi_t *fdc,
 	}
 
 	fdc->dirty = 1;
+	trk->dirty = 1;
 
 	sct = psi_sct_new (c, h, s, cnt);
 
@@ -460,9 +477,43 @@ int fdc_save (disk_psi_t *fdc)
 		return (1);
 	}
 
+	psi_img_clear_dirty (fdc->img);
+
+	if (psi_journal_remove (fdc->dsk.fname)) {
+		return (1);
+	}
+
+	fdc->journal = 0;
+	fdc->compact = 0;
+
 	return (0);
 }
 
+/*
+ * Append the modified tracks to the journal. The image is only
+ * rewritten if the modifications can't be journaled.
+ */
+static
+int fdc_commit (disk_psi_t *fdc)
+{
+	if ((fdc->dsk.fname == NULL) || (fdc->img == NULL)) {
+		return (1);
+	}
+
+	if (dsk_get_readonly (&fdc->dsk)) {
+		return (1);
+	}
+
+	if (fdc->compact == 0) {
+		if (psi_journal_save (fdc->dsk.fname, fdc->img) == 0) {
+			fdc->journal = 1;
+			return (0);
+		}
+	}
+
+	return (fdc_save (fdc));
+}
+
 static
 int fdc_set_geometry (disk_psi_t *fdc)
 {
@@ -515,6 +566,19 @@ int dsk_psi_set_msg (disk_t *dsk, const char *msg, const char *val)
 	fdc = dsk->ext;
 
 	if (strcmp (msg, "commit") == 0) {
+		if (fdc->dirty == 0) {
+			return (0);
+		}
+
+		if (fdc_commit (fdc)) {
+			return (1);
+		}
+
+		fdc->dirty = 0;
+
+		return (0);
+	}
+	else if (strcmp (msg, "compact") == 0) {
 		if (fdc_save (fdc)) {
 			return (1);
 		}
@@ -534,7 +598,7 @@ void dsk_psi_del (disk_t *dsk)
 
 	fdc = dsk->ext;
 
-	if (fdc->dirty) {
+	if (fdc->dirty || (fdc->journal && !dsk_get_readonly (dsk))) {
 		fprintf (stderr, "disk %u: writing back psi image to %s\n",
 			fdc->dsk.drive,
 			(fdc->dsk.fname != NULL) ? fdc->dsk.fname : "<none>"
@@ -576,6 +640,8 @@ disk_t *dsk_psi_open_fp (FILE *fp, unsigned type, int ro)
 	fdc->type = type;
 	fdc->encoding = PSI_ENC_MFM;
 	fdc->dirty = 0;
+	fdc->journal = 0;
+	fdc->compact = 0;
 
 	fdc->img = psi_load_fp (fp, type);
 
@@ -591,8 +657,10 @@ disk_t *dsk_psi_open_fp (FILE *fp, unsigned type, int ro)
 
 disk_t *dsk_psi_open (const char *fname, unsigned type, int ro)
 {
-	disk_t *dsk;
-	FILE   *fp;
+	unsigned long cnt;
+	disk_t        *dsk;
+	disk_psi_t    *fdc;
+	FILE          *fp;
 
 	if (type == PSI_FORMAT_NONE) {
 		type = psi_probe (fname);
@@ -632,6 +700,20 @@ disk_t *dsk_psi_open (const char *fname, unsigned type, int ro)
 
 	dsk_set_fname (dsk, fname);
 
+	fdc = dsk->ext;
+
+	if (psi_journal_load (fname, fdc->img, &cnt)) {
+		fprintf (stderr, "psi: damaged journal (%s.jnl)\n", fname);
+
+		fdc->journal = 1;
+		fdc->compact = 1;
+	}
+
+	if (cnt > 0) {
+		fdc->journal = 1;
+		fdc_set_geometry (fdc);
+	}
+
 	return (dsk);
 }
 
@@ -56,6 +56,12 @@ typedef struct {
 	unsigned  type;
 	unsigned  encoding;
 	char      dirty;
+
+	/* the image has a journal that has not been compacted */
+	char      journal;
+
+	/* the next write-back must rewrite the image */
+	char      compact;
 } disk_psi_t;
 
 
@@ -37,6 +37,8 @@
 
 #include <drivers/psi/psi-img.h>
 
+#include <lib/sysdep.h>
+
 
 uint16_t dsk_get_uint16_be (const void *buf, unsigned i)
 {
@@ -372,6 +374,12 @@ void dsk_init (disk_t *dsk, void *ext, uint32_t n, uint32_t c, uint32_t h, uint3
 
 	dsk->fname = NULL;
 
+	dsk->stat_rd_ops = 0;
+	dsk->stat_rd_blk = 0;
+	dsk->stat_wr_ops = 0;
+	dsk->stat_wr_blk = 0;
+	dsk->stat_us = 0;
+
 	dsk->ext = ext;
 }
 
@@ -812,11 +820,25 @@ int dsk_get_lba (disk_t *dsk, uint32_t c, uint32_t h, uint32_t s, uint32_t *v)
 
 int dsk_read_lba (disk_t *dsk, void *buf, uint32_t i, uint32_t n)
 {
-	if (dsk->read != NULL) {
-		return (dsk->read (dsk, buf, i, n));
+	int                r;
+	unsigned long long t;
+
+	if (dsk->read == NULL) {
+		return (1);
 	}
 
-	return (1);
+	t = pce_get_stat_us();
+
+	r = dsk->read (dsk, buf, i, n);
+
+	dsk->stat_rd_ops += 1;
+	dsk->stat_rd_blk += n;
+
+	if (t > 0) {
+		dsk->stat_us += pce_get_cpu_us() - t;
+	}
+
+	return (r);
 }
 
 int dsk_read_lbaz (disk_t *dsk, void *buf, uint32_t i, uint32_t n)
@@ -848,11 +870,25 @@ int dsk_read_chs (disk_t *dsk, void *buf,
 
 int dsk_write_lba (disk_t *dsk, const void *buf, uint32_t i, uint32_t n)
 {
-	if (dsk->write != NULL) {
-		return (dsk->write (dsk, buf, i, n));
+	int                r;
+	unsigned long long t;
+
+	if (dsk->write == NULL) {
+		return (1);
 	}
 
-	return (1);
+	t = pce_get_stat_us();
+
+	r = dsk->write (dsk, buf, i, n);
+
+	dsk->stat_wr_ops += 1;
+	dsk->stat_wr_blk += n;
+
+	if (t > 0) {
+		dsk->stat_us += pce_get_cpu_us() - t;
+	}
+
+	return (r);
 }
 
 int dsk_write_chs (disk_t *dsk, const void *buf,
@@ -88,6 +88,13 @@ typedef struct disk_s {
 
 	char          *fname;
 
+	/* statistics */
+	unsigned long long stat_rd_ops;
+	unsigned long long stat_rd_blk;
+	unsigned long long stat_wr_ops;
+	unsigned long long stat_wr_blk;
+	unsigned long long stat_us;
+
 	void          *ext;
 } disk_t;
 
@@ -268,6 +268,9 @@ void chr_init (char_drv_t *cdrv, void *ext)
 
 	cdrv->cap_fp = NULL;
 
+	cdrv->stat_rd = 0;
+	cdrv->stat_wr = 0;
+
 	cdrv->close = NULL;
 
 	cdrv->read = NULL;
@@ -456,6 +459,8 @@ unsigned chr_read (char_drv_t *cdrv, void *buf, unsigned cnt)
 
 	ret = cdrv->read (cdrv, buf, cnt);
 
+	cdrv->stat_rd += ret;
+
 	chr_log_data (cdrv, 0, buf, ret);
 
 	return (ret);
@@ -471,6 +476,8 @@ unsigned chr_write (char_drv_t *cdrv, const void *buf, unsigned cnt)
 
 	ret = cdrv->write (cdrv, buf, cnt);
 
+	cdrv->stat_wr += ret;
+
 	if (cdrv->cap_fp != NULL) {
 		chr_cap_data (cdrv, buf, ret);
 	}
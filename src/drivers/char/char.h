@@ -57,6 +57,10 @@ typedef struct char_drv_t {
 
 	FILE          *cap_fp;
 
+	/* statistics */
+	unsigned long long stat_rd;
+	unsigned long long stat_wr;
+
 	void (*close) (struct char_drv_t *cdrv);
 
 	unsigned (*read) (struct char_drv_t *cdrv, void *buf, unsigned cnt);
@@ -129,6 +129,43 @@ int pfi_dec_add_bit (pfi_dec_t *buf, int val, int weak, unsigned long clk)
 	return (0);
 }
 
+void pfi_dec_reset (pfi_dec_t *buf)
+{
+	buf->cnt = 0;
+	buf->index = 0;
+}
+
+/*
+ * Store a bit without checking the buffer size
+ */
+static
+void pfi_dec_put_bit (pfi_dec_t *buf, int val, int weak, unsigned long clk)
+{
+	unsigned long i;
+	unsigned char m;
+
+	i = buf->cnt / 8;
+	m = 0x80 >> (buf->cnt & 7);
+
+	if (val) {
+		buf->buf[i] |= m;
+	}
+	else {
+		buf->buf[i] &= ~m;
+	}
+
+	if (weak) {
+		buf->weak[i] |= m;
+	}
+	else {
+		buf->weak[i] &= ~m;
+	}
+
+	buf->clk[buf->cnt] = clk;
+
+	buf->cnt += 1;
+}
+
 void pfi_dec_clock_average (pfi_dec_t *bit)
 {
 	unsigned long i;
@@ -180,10 +217,36 @@ void pfi_dec_clock_median (pfi_dec_t *bit)
 	}
 }
 
+/*
+ * Estimate the number of bits decoded from revolution rev and the
+ * revolution following it.
+ */
+static
+unsigned long pfi_trk_decode_size (const pfi_trk_t *trk, unsigned rev, double cell)
+{
+	unsigned long clk1, clk2;
+
+	clk1 = (trk->index_cnt >= rev) ? trk->index[rev - 1] : 0;
+
+	if (trk->index_cnt > (rev + 1)) {
+		clk2 = trk->index[rev + 1];
+	}
+	else {
+		clk2 = pfi_trk_get_clk (trk, trk->pulse_cnt);
+	}
+
+	if (clk2 <= clk1) {
+		return (0);
+	}
+
+	return ((unsigned long) ((clk2 - clk1) / cell) + 64);
+}
+
 int pfi_trk_decode_bits (pfi_trk_t *trk, pfi_dec_t *dst, unsigned long rate, unsigned rev)
 {
 	unsigned      idx;
 	uint32_t      val, ofs;
+	unsigned long clk;
 	unsigned char weak;
 	double        cell, cell0, pulse;
 	double        adjust1, adjust2, limit1, limit2, phase;
@@ -220,6 +283,10 @@ int pfi_trk_decode_bits (pfi_trk_t *trk, pfi_dec_t *dst, unsigned long rate, uns
 
 	weak = 0;
 
+	if (pfi_dec_alloc_bits (dst, pfi_trk_decode_size (trk, rev, limit1))) {
+		return (1);
+	}
+
 	while (pfi_trk_get_pulse (trk, &val, &ofs) == 0) {
 		if ((val == 0) || (ofs < val)) {
 			idx += 1;
@@ -241,12 +308,19 @@ int pfi_trk_decode_bits (pfi_trk_t *trk, pfi_dec_t *dst, unsigned long rate, uns
 
 		pulse += (double) val / cell;
 
+		/* the cell size is constant until the next 1 bit */
+		clk = trk->clock / cell;
+
+		if (pfi_dec_alloc_bits (dst, (unsigned long) pulse + 1)) {
+			return (1);
+		}
+
 		while (pulse > 1.5) {
 			if (pulse < 1.6) {
 				weak = 3;
 			}
 
-			pfi_dec_add_bit (dst, 0, weak & 1, trk->clock / cell);
+			pfi_dec_put_bit (dst, 0, weak & 1, clk);
 
 			weak >>= 1;
 			pulse -= 1.0;
@@ -256,7 +330,7 @@ int pfi_trk_decode_bits (pfi_trk_t *trk, pfi_dec_t *dst, unsigned long rate, uns
 			weak = 3;
 		}
 
-		pfi_dec_add_bit (dst, 1, weak & 1, trk->clock / cell);
+		pfi_dec_put_bit (dst, 1, weak & 1, clk);
 
 		weak >>= 1;
 		pulse -= 1.0;
@@ -44,6 +44,11 @@ void pfi_dec_free (pfi_dec_t *buf);
 int pfi_dec_alloc_bits (pfi_dec_t *buf, unsigned long cnt);
 int pfi_dec_add_bit (pfi_dec_t *buf, int val, int weak, unsigned long clk);
 
+/*!***************************************************************************
+ * @short Discard the decoded bits but keep the buffers
+ *****************************************************************************/
+void pfi_dec_reset (pfi_dec_t *buf);
+
 void pfi_dec_clock_average (pfi_dec_t *bit);
 void pfi_dec_clock_median (pfi_dec_t *bit);
 
@@ -401,9 +401,14 @@ psi_img_t *pri_decode_gcr (pri_img_t *img)
 			}
 			else {
 				dtrk = pri_decode_gcr_trk (trk, h);
+
+				if (dtrk != NULL) {
+					dtrk->dirty = trk->dirty;
+				}
 			}
 
-			if ((dtrk->sct_cnt == 0) && ((h + 1) == cyl->trk_cnt)) {
+			/* keep modified tracks, they must be written back */
+			if ((dtrk->sct_cnt == 0) && ((h + 1) == cyl->trk_cnt) && (dtrk->dirty == 0)) {
 				psi_trk_del (dtrk);
 				continue;
 			}
@@ -547,6 +547,10 @@ psi_img_t *pri_decode_mfm (pri_img_t *img, pri_dec_mfm_t *par)
 				return (NULL);
 			}
 
+			if (trk != NULL) {
+				dtrk->dirty = trk->dirty;
+			}
+
 			psi_img_set_track (dimg, dtrk, c, h);
 		}
 	}
@@ -41,6 +41,21 @@
 #define PRI_CRC_POLY   0x1edc6f41
 
 
+typedef struct {
+	unsigned long c;
+	unsigned long h;
+	unsigned long ofs;
+} pri_lazy_idx_t;
+
+typedef struct {
+	FILE           *fp;
+
+	unsigned long  idx_cnt;
+	unsigned long  idx_max;
+	pri_lazy_idx_t *idx;
+} pri_lazy_pri_t;
+
+
 static
 unsigned long pri_crc (unsigned long crc, const void *buf, unsigned cnt)
 {
@@ -486,6 +501,292 @@ pri_img_t *pri_load_pri (FILE *fp)
 }
 
 
+static
+void pri_lazy_del (void *ext)
+{
+	pri_lazy_pri_t *lp;
+
+	lp = ext;
+
+	fclose (lp->fp);
+	free (lp->idx);
+	free (lp);
+}
+
+static
+pri_lazy_idx_t *pri_lazy_find (pri_lazy_pri_t *lp, unsigned long c, unsigned long h)
+{
+	unsigned long i;
+
+	for (i = 0; i < lp->idx_cnt; i++) {
+		if ((lp->idx[i].c == c) && (lp->idx[i].h == h)) {
+			return (&lp->idx[i]);
+		}
+	}
+
+	return (NULL);
+}
+
+static
+int pri_lazy_add (pri_lazy_pri_t *lp, unsigned long c, unsigned long h, unsigned long ofs)
+{
+	unsigned long  max;
+	pri_lazy_idx_t *idx;
+
+	if ((idx = pri_lazy_find (lp, c, h)) == NULL) {
+		if (lp->idx_cnt >= lp->idx_max) {
+			max = (lp->idx_max < 64) ? 64 : (2 * lp->idx_max);
+
+			idx = realloc (lp->idx, max * sizeof (pri_lazy_idx_t));
+
+			if (idx == NULL) {
+				return (1);
+			}
+
+			lp->idx = idx;
+			lp->idx_max = max;
+		}
+
+		idx = &lp->idx[lp->idx_cnt++];
+
+		idx->c = c;
+		idx->h = h;
+	}
+
+	idx->ofs = ofs;
+
+	return (0);
+}
+
+static
+int pri_lazy_load_track (pri_lazy_pri_t *lp, pri_img_t *img, unsigned long ofs)
+{
+	unsigned long type, size;
+	unsigned long crc;
+	pri_trk_t     *trk;
+	unsigned char buf[8];
+
+	if (fseek (lp->fp, ofs, SEEK_SET)) {
+		return (1);
+	}
+
+	trk = NULL;
+
+	while (1) {
+		crc = 0;
+
+		if (pri_read_crc (lp->fp, buf, 8, &crc)) {
+			return (1);
+		}
+
+		type = pri_get_uint32_be (buf, 0);
+		size = pri_get_uint32_be (buf, 4);
+
+		switch (type) {
+		case PRI_CHUNK_END:
+		case PRI_CHUNK_TEXT:
+			return (0);
+
+		case PRI_CHUNK_TRAK:
+			if (trk != NULL) {
+				return (0);
+			}
+
+			if (pri_load_trak (lp->fp, img, &trk, size, crc)) {
+				return (1);
+			}
+			break;
+
+		case PRI_CHUNK_DATA:
+			if (pri_load_data (lp->fp, img, trk, size, crc)) {
+				return (1);
+			}
+			break;
+
+		case PRI_CHUNK_FUZZ:
+			if (pri_load_fuzz (lp->fp, img, trk, size, crc)) {
+				return (1);
+			}
+			break;
+
+		case PRI_CHUNK_BCLK:
+			if (pri_load_bclk (lp->fp, img, trk, size, crc)) {
+				return (1);
+			}
+			break;
+
+		case PRI_CHUNK_WEAK:
+			if (pri_load_weak (lp->fp, img, trk, size, crc)) {
+				return (1);
+			}
+			break;
+
+		default:
+			if (pri_skip_chunk (lp->fp, size, crc)) {
+				return (1);
+			}
+			break;
+		}
+	}
+
+	return (1);
+}
+
+static
+int pri_lazy_load (void *ext, pri_img_t *img, unsigned long c, unsigned long h)
+{
+	pri_lazy_pri_t *lp;
+	pri_lazy_idx_t *idx;
+
+	lp = ext;
+
+	if ((idx = pri_lazy_find (lp, c, h)) == NULL) {
+		return (0);
+	}
+
+	if (pri_lazy_load_track (lp, img, idx->ofs)) {
+		/* don't leave a partially loaded track behind */
+		pri_trk_del (img->cyl[c]->trk[h]);
+		img->cyl[c]->trk[h] = NULL;
+
+		return (1);
+	}
+
+	return (0);
+}
+
+static
+int pri_lazy_index (pri_lazy_pri_t *lp, pri_img_t *img)
+{
+	long          ofs;
+	unsigned long type, size;
+	unsigned long c, h;
+	unsigned long crc;
+	pri_cyl_t     *cyl;
+	unsigned char buf[16];
+
+	crc = 0;
+
+	if (pri_read_crc (lp->fp, buf, 8, &crc)) {
+		return (1);
+	}
+
+	if (pri_get_uint32_be (buf, 0) != PRI_CHUNK_PRI) {
+		return (1);
+	}
+
+	if (pri_load_header (lp->fp, img, pri_get_uint32_be (buf, 4), crc)) {
+		return (1);
+	}
+
+	while (1) {
+		if ((ofs = ftell (lp->fp)) < 0) {
+			return (1);
+		}
+
+		crc = 0;
+
+		if (pri_read_crc (lp->fp, buf, 8, &crc)) {
+			return (1);
+		}
+
+		type = pri_get_uint32_be (buf, 0);
+		size = pri_get_uint32_be (buf, 4);
+
+		if (type == PRI_CHUNK_END) {
+			return (pri_skip_chunk (lp->fp, size, crc));
+		}
+		else if (type == PRI_CHUNK_TEXT) {
+			if (pri_load_text (lp->fp, img, size, crc)) {
+				return (1);
+			}
+
+			continue;
+		}
+		else if (type == PRI_CHUNK_TRAK) {
+			if (size < 16) {
+				return (1);
+			}
+
+			if (pri_read (lp->fp, buf, 16)) {
+				return (1);
+			}
+
+			c = pri_get_uint32_be (buf, 0);
+			h = pri_get_uint32_be (buf, 4);
+
+			if (pri_lazy_add (lp, c, h, ofs)) {
+				return (1);
+			}
+
+			if ((cyl = pri_img_get_cylinder (img, c, 1)) == NULL) {
+				return (1);
+			}
+
+			/* create an empty slot for the track */
+			if (h >= cyl->trk_cnt) {
+				if (pri_cyl_set_track (cyl, NULL, h)) {
+					return (1);
+				}
+			}
+
+			size -= 16;
+		}
+
+		/* the chunk data and the crc are checked when loading a track */
+		if (fseek (lp->fp, size + 4, SEEK_CUR)) {
+			return (1);
+		}
+	}
+
+	return (1);
+}
+
+pri_img_t *pri_load_pri_lazy (FILE *fp, unsigned long max)
+{
+	pri_img_t      *img;
+	pri_lazy_pri_t *lp;
+	pri_lazy_t     *lazy;
+
+	if ((img = pri_img_new()) == NULL) {
+		return (NULL);
+	}
+
+	lp = malloc (sizeof (pri_lazy_pri_t));
+	lazy = malloc (sizeof (pri_lazy_t));
+
+	if ((lp == NULL) || (lazy == NULL)) {
+		free (lazy);
+		free (lp);
+		pri_img_del (img);
+		return (NULL);
+	}
+
+	lp->fp = fp;
+	lp->idx_cnt = 0;
+	lp->idx_max = 0;
+	lp->idx = NULL;
+
+	if (pri_lazy_index (lp, img)) {
+		free (lp->idx);
+		free (lp);
+		free (lazy);
+		pri_img_del (img);
+		return (NULL);
+	}
+
+	lazy->ext = lp;
+	lazy->load = pri_lazy_load;
+	lazy->del = pri_lazy_del;
+	lazy->max = max;
+	lazy->clk = 0;
+
+	pri_img_set_lazy (img, lazy);
+
+	return (img);
+}
+
+
 static
 int pri_save_chunk (FILE *fp, unsigned ckid, unsigned size, const void *data)
 {
@@ -722,7 +1023,8 @@ int pri_save_track (FILE *fp, const pri_trk_t *trk, unsigned long c, unsigned lo
 	return (0);
 }
 
-int pri_save_pri (FILE *fp, const pri_img_t *img)
+static
+int pri_save_image (FILE *fp, const pri_img_t *img, int dirty)
 {
 	unsigned long c, h;
 	pri_cyl_t     *cyl;
@@ -732,8 +1034,10 @@ int pri_save_pri (FILE *fp, const pri_img_t *img)
 		return (1);
 	}
 
-	if (pri_save_text (fp, img)) {
-		return (1);
+	if (dirty == 0) {
+		if (pri_save_text (fp, img)) {
+			return (1);
+		}
 	}
 
 	for (c = 0; c < img->cyl_cnt; c++) {
@@ -746,6 +1050,10 @@ int pri_save_pri (FILE *fp, const pri_img_t *img)
 				continue;
 			}
 
+			if (dirty && (trk->dirty == 0)) {
+				continue;
+			}
+
 			if (pri_save_track (fp, trk, c, h)) {
 				return (1);
 			}
@@ -759,6 +1067,17 @@ int pri_save_pri (FILE *fp, const pri_img_t *img)
 	return (0);
 }
 
+int pri_save_pri (FILE *fp, const pri_img_t *img)
+{
+	return (pri_save_image (fp, img, 0));
+}
+
+/* Save only the modified tracks, without the comment */
+int pri_save_pri_dirty (FILE *fp, const pri_img_t *img)
+{
+	return (pri_save_image (fp, img, 1));
+}
+
 
 int pri_probe_pri_fp (FILE *fp)
 {
@@ -29,7 +29,18 @@
 
 pri_img_t *pri_load_pri (FILE *fp);
 
+/*!***************************************************************************
+ * @short Load a PRI image on demand
+ * @param max The maximum number of unmodified tracks kept in memory
+ *
+ * Only an index of the tracks is built. Tracks are loaded when they are
+ * first accessed through pri_img_get_track(). On success, the image
+ * takes ownership of fp.
+ *****************************************************************************/
+pri_img_t *pri_load_pri_lazy (FILE *fp, unsigned long max);
+
 int pri_save_pri (FILE *fp, const pri_img_t *img);
+int pri_save_pri_dirty (FILE *fp, const pri_img_t *img);
 
 int pri_probe_pri_fp (FILE *fp);
 int pri_probe_pfdc (const char *fname);
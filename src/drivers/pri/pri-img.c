@@ -314,6 +314,29 @@ pri_img_t *pri_img_load (const char *fname, unsigned type)
 	return (img);
 }
 
+pri_img_t *pri_img_load_lazy (const char *fname, unsigned type, unsigned long max)
+{
+	FILE      *fp;
+	pri_img_t *img;
+
+	type = pri_get_type (type, fname);
+
+	if (type != PRI_FORMAT_PRI) {
+		return (pri_img_load (fname, type));
+	}
+
+	if ((fp = fopen (fname, "rb")) == NULL) {
+		return (NULL);
+	}
+
+	if ((img = pri_load_pri_lazy (fp, max)) == NULL) {
+		fclose (fp);
+		return (NULL);
+	}
+
+	return (img);
+}
+
 int pri_img_save_fp (FILE *fp, const pri_img_t *img, unsigned type)
 {
 	switch (type) {
@@ -357,6 +380,163 @@ int pri_img_save (const char *fname, const pri_img_t *img, unsigned type)
 	return (r);
 }
 
+static
+char *pri_journal_name (const char *fname)
+{
+	char *ret;
+
+	if ((ret = malloc (strlen (fname) + 5)) == NULL) {
+		return (NULL);
+	}
+
+	strcpy (ret, fname);
+	strcat (ret, ".jnl");
+
+	return (ret);
+}
+
+static
+void pri_journal_apply (pri_img_t *img, pri_img_t *rec)
+{
+	unsigned long c, h;
+	pri_cyl_t     *cyl;
+	pri_trk_t     *trk;
+
+	for (c = 0; c < rec->cyl_cnt; c++) {
+		if ((cyl = rec->cyl[c]) == NULL) {
+			continue;
+		}
+
+		for (h = 0; h < cyl->trk_cnt; h++) {
+			if ((trk = cyl->trk[h]) == NULL) {
+				continue;
+			}
+
+			if (pri_img_set_track (img, trk, c, h) == 0) {
+				cyl->trk[h] = NULL;
+			}
+		}
+	}
+}
+
+int pri_journal_load (const char *fname, pri_img_t *img, unsigned long *cnt)
+{
+	int       c, r;
+	char      *jname;
+	FILE      *fp;
+	pri_img_t *rec;
+
+	*cnt = 0;
+
+	if ((jname = pri_journal_name (fname)) == NULL) {
+		return (1);
+	}
+
+	fp = fopen (jname, "rb");
+
+	free (jname);
+
+	if (fp == NULL) {
+		return (0);
+	}
+
+	r = 0;
+
+	while ((c = fgetc (fp)) != EOF) {
+		ungetc (c, fp);
+
+		if ((rec = pri_load_pri (fp)) == NULL) {
+			r = 1;
+			break;
+		}
+
+		pri_journal_apply (img, rec);
+
+		pri_img_del (rec);
+
+		*cnt += 1;
+	}
+
+	fclose (fp);
+
+	return (r);
+}
+
+int pri_journal_save (const char *fname, pri_img_t *img)
+{
+	int           r;
+	unsigned long c, h;
+	unsigned long dirty;
+	char          *jname;
+	FILE          *fp;
+	pri_cyl_t     *cyl;
+
+	dirty = 0;
+
+	for (c = 0; c < img->cyl_cnt; c++) {
+		if ((cyl = img->cyl[c]) == NULL) {
+			continue;
+		}
+
+		for (h = 0; h < cyl->trk_cnt; h++) {
+			if ((cyl->trk[h] != NULL) && cyl->trk[h]->dirty) {
+				dirty += 1;
+			}
+		}
+	}
+
+	if (dirty == 0) {
+		return (0);
+	}
+
+	if ((jname = pri_journal_name (fname)) == NULL) {
+		return (1);
+	}
+
+	fp = fopen (jname, "ab");
+
+	free (jname);
+
+	if (fp == NULL) {
+		return (1);
+	}
+
+	r = pri_save_pri_dirty (fp, img);
+
+	if (fclose (fp)) {
+		r = 1;
+	}
+
+	if (r == 0) {
+		pri_img_clear_dirty (img);
+	}
+
+	return (r);
+}
+
+int pri_journal_remove (const char *fname)
+{
+	char *jname;
+	FILE *fp;
+
+	if ((jname = pri_journal_name (fname)) == NULL) {
+		return (1);
+	}
+
+	if ((fp = fopen (jname, "rb")) != NULL) {
+		fclose (fp);
+
+		if (remove (jname)) {
+			free (jname);
+			return (1);
+		}
+	}
+
+	free (jname);
+
+	return (0);
+}
+
 unsigned pri_probe_fp (FILE *fp)
 {
 	if (pri_probe_pri_fp (fp)) {
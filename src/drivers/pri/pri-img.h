@@ -63,9 +63,34 @@ unsigned pri_guess_type (const char *fname);
 pri_img_t *pri_img_load_fp (FILE *fp, unsigned type);
 pri_img_t *pri_img_load (const char *fname, unsigned type);
 
+/*!***************************************************************************
+ * @short Load an image, loading its tracks on demand if possible
+ *
+ * Only PRI images are loaded on demand, other formats are loaded
+ * completely.
+ *****************************************************************************/
+pri_img_t *pri_img_load_lazy (const char *fname, unsigned type, unsigned long max);
+
 int pri_img_save_fp (FILE *fp, const pri_img_t *img, unsigned type);
 int pri_img_save (const char *fname, const pri_img_t *img, unsigned type);
 
+/*!***************************************************************************
+ * @short Apply the journal of an image file
+ * @retval cnt The number of journal records that were applied
+ * @return Non-zero if the journal is damaged
+ *
+ * The journal is stored in <fname>.jnl. It consists of PRI images that
+ * contain the tracks that were modified since the previous record.
+ *****************************************************************************/
+int pri_journal_load (const char *fname, pri_img_t *img, unsigned long *cnt);
+
+/*!***************************************************************************
+ * @short Append the modified tracks of an image to its journal
+ *****************************************************************************/
+int pri_journal_save (const char *fname, pri_img_t *img);
+
+int pri_journal_remove (const char *fname);
+
 unsigned pri_probe_fp (FILE *fp);
 unsigned pri_probe (const char *fname);
 
@@ -159,6 +159,11 @@ pri_trk_t *pri_trk_new (unsigned long size, unsigned long clock)
 	trk->cur_evt = NULL;
 	trk->wrap = 0;
 
+	trk->dirty = 0;
+
+	trk->lazy = 0;
+	trk->lru = 0;
+
 	return (trk);
 }
 
@@ -1084,6 +1089,8 @@ pri_img_t *pri_img_new (void)
 	img->woz_track_sync = 0;
 	img->woz_cleaned = 0;
 
+	img->lazy = NULL;
+
 	return (img);
 }
 
@@ -1092,6 +1099,8 @@ void pri_img_del (pri_img_t *img)
 	unsigned long i;
 
 	if (img != NULL) {
+		pri_img_set_lazy (img, NULL);
+
 		for (i = 0; i < img->cyl_cnt; i++) {
 			pri_cyl_del (img->cyl[i]);
 		}
@@ -1237,11 +1246,135 @@ pri_trk_t *pri_img_get_track_const (const pri_img_t *img, unsigned long c, unsig
 	return (cyl->trk[h]);
 }
 
+/*
+ * Discard the least recently used tracks that were loaded on demand
+ * and not modified, until at most lazy->max such tracks remain.
+ */
+static
+void pri_img_lazy_evict (pri_img_t *img, const pri_trk_t *keep)
+{
+	unsigned long c, h, cnt;
+	unsigned long lc, lh;
+	pri_cyl_t     *cyl;
+	pri_trk_t     *trk, *lru;
+
+	while (1) {
+		cnt = 0;
+		lru = NULL;
+		lc = 0;
+		lh = 0;
+
+		for (c = 0; c < img->cyl_cnt; c++) {
+			if ((cyl = img->cyl[c]) == NULL) {
+				continue;
+			}
+
+			for (h = 0; h < cyl->trk_cnt; h++) {
+				trk = cyl->trk[h];
+
+				if ((trk == NULL) || (trk->lazy == 0) || trk->dirty) {
+					continue;
+				}
+
+				cnt += 1;
+
+				if (trk == keep) {
+					continue;
+				}
+
+				if ((lru == NULL) || (trk->lru < lru->lru)) {
+					lru = trk;
+					lc = c;
+					lh = h;
+				}
+			}
+		}
+
+		if ((cnt <= img->lazy->max) || (lru == NULL)) {
+			return;
+		}
+
+		pri_trk_del (lru);
+
+		img->cyl[lc]->trk[lh] = NULL;
+	}
+}
+
+static
+int pri_img_lazy_load (pri_img_t *img, unsigned long c, unsigned long h)
+{
+	int        r;
+	pri_lazy_t *lazy;
+
+	lazy = img->lazy;
+
+	/* the loader must not recurse into on demand loading */
+	img->lazy = NULL;
+	r = lazy->load (lazy->ext, img, c, h);
+	img->lazy = lazy;
+
+	if (r) {
+		fprintf (stderr, "pri: loading track %lu/%lu failed\n", c, h);
+		return (1);
+	}
+
+	return (0);
+}
+
+static
+int pri_img_lazy_get (pri_img_t *img, unsigned long c, unsigned long h, pri_trk_t **trk)
+{
+	pri_cyl_t *cyl;
+
+	*trk = NULL;
+
+	if ((c >= img->cyl_cnt) || (img->cyl[c] == NULL)) {
+		return (0);
+	}
+
+	cyl = img->cyl[c];
+
+	if (h >= cyl->trk_cnt) {
+		return (0);
+	}
+
+	if (cyl->trk[h] != NULL) {
+		*trk = cyl->trk[h];
+		(*trk)->lru = ++img->lazy->clk;
+		return (0);
+	}
+
+	if (pri_img_lazy_load (img, c, h)) {
+		return (1);
+	}
+
+	if ((*trk = cyl->trk[h]) == NULL) {
+		return (0);
+	}
+
+	(*trk)->lazy = 1;
+	(*trk)->lru = ++img->lazy->clk;
+
+	pri_img_lazy_evict (img, *trk);
+
+	return (0);
+}
+
 pri_trk_t *pri_img_get_track (pri_img_t *img, unsigned long c, unsigned long h, int alloc)
 {
 	pri_cyl_t *cyl;
 	pri_trk_t *trk;
 
+	if (img->lazy != NULL) {
+		if (pri_img_lazy_get (img, c, h, &trk)) {
+			return (NULL);
+		}
+
+		if (trk != NULL) {
+			return (trk);
+		}
+	}
+
 	cyl = pri_img_get_cylinder (img, c, alloc);
 
 	if (cyl == NULL) {
@@ -1340,3 +1473,70 @@ int pri_img_add_comment_nl (pri_img_t *img)
 
 	return (0);
 }
+
+/* Mark all tracks as not modified */
+void pri_img_clear_dirty (pri_img_t *img)
+{
+	unsigned long c, h;
+	pri_cyl_t     *cyl;
+
+	for (c = 0; c < img->cyl_cnt; c++) {
+		if ((cyl = img->cyl[c]) == NULL) {
+			continue;
+		}
+
+		for (h = 0; h < cyl->trk_cnt; h++) {
+			if ((cyl->trk[h] != NULL) && cyl->trk[h]->dirty) {
+				/* it can no longer be reloaded from the file */
+				cyl->trk[h]->dirty = 0;
+				cyl->trk[h]->lazy = 0;
+			}
+		}
+	}
+}
+
+void pri_img_set_lazy (pri_img_t *img, pri_lazy_t *lazy)
+{
+	if (img->lazy != NULL) {
+		if (img->lazy->del != NULL) {
+			img->lazy->del (img->lazy->ext);
+		}
+
+		free (img->lazy);
+	}
+
+	img->lazy = lazy;
+}
+
+/* Load all tracks that have not been loaded on demand yet */
+int pri_img_load_all (pri_img_t *img)
+{
+	unsigned long c, h;
+	pri_cyl_t     *cyl;
+
+	if (img->lazy == NULL) {
+		return (0);
+	}
+
+	for (c = 0; c < img->cyl_cnt; c++) {
+		if ((cyl = img->cyl[c]) == NULL) {
+			continue;
+		}
+
+		for (h = 0; h < cyl->trk_cnt; h++) {
+			if (cyl->trk[h] == NULL) {
+				if (pri_img_lazy_load (img, c, h)) {
+					return (1);
+				}
+			}
+
+			if (cyl->trk[h] != NULL) {
+				cyl->trk[h]->lazy = 0;
+			}
+		}
+	}
+
+	pri_img_set_lazy (img, NULL);
+
+	return (0);
+}
@@ -49,6 +49,13 @@ typedef struct {
 	unsigned long idx;
 	pri_evt_t     *cur_evt;
 	char          wrap;
+
+	/* the track was modified since it was last saved */
+	char          dirty;
+
+	/* the track was loaded on demand and can be discarded */
+	char          lazy;
+	unsigned long lru;
 } pri_trk_t;
 
 
@@ -58,7 +65,29 @@ typedef struct {
 } pri_cyl_t;
 
 
+struct pri_img_s;
+
+
+/*
+ * On demand track loading. Tracks that have not been loaded yet are
+ * NULL in the cylinder track array.
+ */
 typedef struct {
+	void          *ext;
+
+	/* load track c/h from the image file, 0 if it does not exist */
+	int           (*load) (void *ext, struct pri_img_s *img, unsigned long c, unsigned long h);
+
+	void          (*del) (void *ext);
+
+	/* the maximum number of tracks loaded on demand */
+	unsigned long max;
+
+	unsigned long clk;
+} pri_lazy_t;
+
+
+typedef struct pri_img_s {
 	unsigned long cyl_cnt;
 	pri_cyl_t     **cyl;
 
@@ -69,6 +98,8 @@ typedef struct {
 
 	char          woz_track_sync;
 	char          woz_cleaned;
+
+	pri_lazy_t    *lazy;
 } pri_img_t;
 
 
@@ -136,5 +167,10 @@ int pri_img_add_comment (pri_img_t *img, const unsigned char *buf, unsigned cnt)
 int pri_img_set_comment (pri_img_t *img, const unsigned char *buf, unsigned cnt);
 int pri_img_add_comment_nl (pri_img_t *img);
 
+void pri_img_clear_dirty (pri_img_t *img);
+
+void pri_img_set_lazy (pri_img_t *img, pri_lazy_t *lazy);
+int pri_img_load_all (pri_img_t *img);
+
 
 #endif
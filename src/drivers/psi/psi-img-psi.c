@@ -1140,7 +1140,8 @@ int psi_save_text (FILE *fp, const psi_img_t *img)
 	return (r);
 }
 
-int psi_save_psi (FILE *fp, const psi_img_t *img)
+static
+int psi_save_image (FILE *fp, const psi_img_t *img, int dirty)
 {
 	unsigned        c, h, s;
 	unsigned        enc;
@@ -1152,8 +1153,10 @@ int psi_save_psi (FILE *fp, const psi_img_t *img)
 		return (1);
 	}
 
-	if (psi_save_text (fp, img)) {
-		return (1);
+	if (dirty == 0) {
+		if (psi_save_text (fp, img)) {
+			return (1);
+		}
 	}
 
 	for (c = 0; c < img->cyl_cnt; c++) {
@@ -1162,6 +1165,10 @@ int psi_save_psi (FILE *fp, const psi_img_t *img)
 		for (h = 0; h < cyl->trk_cnt; h++) {
 			trk = cyl->trk[h];
 
+			if (dirty && (trk->dirty == 0)) {
+				continue;
+			}
+
 			for (s = 0; s < trk->sct_cnt; s++) {
 				sct = trk->sct[s];
 
@@ -1181,6 +1188,16 @@ int psi_save_psi (FILE *fp, const psi_img_t *img)
 	return (0);
 }
 
+int psi_save_psi (FILE *fp, const psi_img_t *img)
+{
+	return (psi_save_image (fp, img, 0));
+}
+
+int psi_save_psi_dirty (FILE *fp, const psi_img_t *img)
+{
+	return (psi_save_image (fp, img, 1));
+}
+
 
 int psi_probe_psi_fp (FILE *fp)
 {
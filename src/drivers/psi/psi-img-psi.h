@@ -31,6 +31,13 @@ psi_img_t *psi_load_psi (FILE *fp);
 
 int psi_save_psi (FILE *fp, const psi_img_t *img);
 
+/*!***************************************************************************
+ * @short Save only the modified tracks of an image
+ *
+ * The comment is not saved.
+ *****************************************************************************/
+int psi_save_psi_dirty (FILE *fp, const psi_img_t *img);
+
 int psi_probe_psi_fp (FILE *fp);
 int psi_probe_psi (const char *fname);
 
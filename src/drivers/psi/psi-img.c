@@ -299,6 +299,175 @@ int psi_save (const char *fname, const psi_img_t *img, unsigned type)
 }
 
 
+static
+char *psi_journal_name (const char *fname)
+{
+	char *ret;
+
+	ret = malloc (strlen (fname) + 5);
+
+	if (ret == NULL) {
+		return (NULL);
+	}
+
+	strcpy (ret, fname);
+	strcat (ret, ".jnl");
+
+	return (ret);
+}
+
+static
+void psi_journal_apply (psi_img_t *img, psi_img_t *rec)
+{
+	unsigned  c, h;
+	psi_cyl_t *cyl;
+	psi_trk_t *trk;
+
+	for (c = 0; c < rec->cyl_cnt; c++) {
+		cyl = rec->cyl[c];
+
+		for (h = 0; h < cyl->trk_cnt; h++) {
+			trk = cyl->trk[h];
+
+			/* tracks that were only created to fill gaps */
+			if (trk->sct_cnt == 0) {
+				continue;
+			}
+
+			if (psi_img_set_track (img, trk, c, h) == 0) {
+				cyl->trk[h] = NULL;
+			}
+		}
+	}
+}
+
+int psi_journal_load (const char *fname, psi_img_t *img, unsigned long *cnt)
+{
+	int       c, r;
+	char      *jname;
+	FILE      *fp;
+	psi_img_t *rec;
+
+	*cnt = 0;
+
+	if ((jname = psi_journal_name (fname)) == NULL) {
+		return (1);
+	}
+
+	fp = fopen (jname, "rb");
+
+	free (jname);
+
+	if (fp == NULL) {
+		return (0);
+	}
+
+	r = 0;
+
+	while ((c = fgetc (fp)) != EOF) {
+		ungetc (c, fp);
+
+		if ((rec = psi_load_psi (fp)) == NULL) {
+			r = 1;
+			break;
+		}
+
+		psi_journal_apply (img, rec);
+
+		psi_img_del (rec);
+
+		*cnt += 1;
+	}
+
+	fclose (fp);
+
+	return (r);
+}
+
+int psi_journal_save (const char *fname, psi_img_t *img)
+{
+	int       r;
+	unsigned  c, h;
+	unsigned  dirty;
+	char      *jname;
+	FILE      *fp;
+	psi_cyl_t *cyl;
+	psi_trk_t *trk;
+
+	dirty = 0;
+
+	for (c = 0; c < img->cyl_cnt; c++) {
+		cyl = img->cyl[c];
+
+		for (h = 0; h < cyl->trk_cnt; h++) {
+			trk = cyl->trk[h];
+
+			if (trk->dirty == 0) {
+				continue;
+			}
+
+			/* an erased track can't be expressed in the journal */
+			if (trk->sct_cnt == 0) {
+				return (1);
+			}
+
+			dirty += 1;
+		}
+	}
+
+	if (dirty == 0) {
+		return (0);
+	}
+
+	if ((jname = psi_journal_name (fname)) == NULL) {
+		return (1);
+	}
+
+	fp = fopen (jname, "ab");
+
+	free (jname);
+
+	if (fp == NULL) {
+		return (1);
+	}
+
+	r = psi_save_psi_dirty (fp, img);
+
+	if (fclose (fp)) {
+		r = 1;
+	}
+
+	if (r == 0) {
+		psi_img_clear_dirty (img);
+	}
+
+	return (r);
+}
+
+int psi_journal_remove (const char *fname)
+{
+	char *jname;
+	FILE *fp;
+
+	if ((jname = psi_journal_name (fname)) == NULL) {
+		return (1);
+	}
+
+	if ((fp = fopen (jname, "rb")) != NULL) {
+		fclose (fp);
+
+		if (remove (jname)) {
+			free (jname);
+			return (1);
+		}
+	}
+
+	free (jname);
+
+	return (0);
+}
+
+
 unsigned psi_probe_fp (FILE *fp)
 {
 	if (psi_probe_psi_fp (fp)) {
@@ -59,6 +59,30 @@ psi_img_t *psi_load (const char *fname, unsigned type);
 int psi_save_fp (FILE *fp, const psi_img_t *img, unsigned type);
 int psi_save (const char *fname, const psi_img_t *img, unsigned type);
 
+/*!***************************************************************************
+ * @short Apply the journal of an image file
+ * @param fname The image file name
+ * @param img   The image that was loaded from fname
+ * @retval cnt  The number of journal records that were applied
+ * @return Non-zero if the journal is damaged
+ *
+ * The journal is stored in <fname>.jnl. It consists of PSI images that
+ * contain the tracks that were modified since the previous record.
+ *****************************************************************************/
+int psi_journal_load (const char *fname, psi_img_t *img, unsigned long *cnt);
+
+/*!***************************************************************************
+ * @short Append the modified tracks of an image to its journal
+ * @return Non-zero if the modifications could not be written to the
+ *         journal. The image must then be saved in full.
+ *****************************************************************************/
+int psi_journal_save (const char *fname, psi_img_t *img);
+
+/*!***************************************************************************
+ * @short Remove the journal of an image file
+ *****************************************************************************/
+int psi_journal_remove (const char *fname);
+
 unsigned psi_probe_fp (FILE *fp);
 unsigned psi_probe (const char *fname);
 
@@ -442,6 +442,7 @@ psi_trk_t *psi_trk_new (unsigned h)
 	trk->h = h;
 	trk->sct_cnt = 0;
 	trk->sct = NULL;
+	trk->dirty = 0;
 
 	return (trk);
 }
@@ -1106,3 +1107,49 @@ unsigned long psi_img_get_sector_count (const psi_img_t *img)
 
 	return (cnt);
 }
+
+void psi_img_clear_dirty (psi_img_t *img)
+{
+	unsigned  c, h;
+	psi_cyl_t *cyl;
+
+	for (c = 0; c < img->cyl_cnt; c++) {
+		cyl = img->cyl[c];
+
+		for (h = 0; h < cyl->trk_cnt; h++) {
+			if (cyl->trk[h] != NULL) {
+				cyl->trk[h]->dirty = 0;
+			}
+		}
+	}
+}
+
+unsigned psi_img_copy_dirty (psi_img_t *dst, const psi_img_t *src)
+{
+	unsigned  c, h, cnt;
+	psi_cyl_t *cyl;
+	psi_trk_t *trk;
+
+	cnt = 0;
+
+	for (c = 0; c < src->cyl_cnt; c++) {
+		cyl = src->cyl[c];
+
+		for (h = 0; h < cyl->trk_cnt; h++) {
+			if ((cyl->trk[h] == NULL) || (cyl->trk[h]->dirty == 0)) {
+				continue;
+			}
+
+			trk = psi_img_get_track (dst, c, h, 0);
+
+			if (trk != NULL) {
+				trk->dirty = 1;
+			}
+			else {
+				cnt += 1;
+			}
+		}
+	}
+
+	return (cnt);
+}
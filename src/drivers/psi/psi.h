@@ -78,6 +78,9 @@ typedef struct {
 	unsigned short h;
 	unsigned short sct_cnt;
 	psi_sct_t      **sct;
+
+	/* the track was modified since it was last saved */
+	char           dirty;
 } psi_trk_t;
 
 
@@ -206,5 +209,16 @@ void psi_img_clear_position (psi_img_t *img);
 
 unsigned long psi_img_get_sector_count (const psi_img_t *img);
 
+/*!***************************************************************************
+ * @short Mark all tracks as not modified
+ *****************************************************************************/
+void psi_img_clear_dirty (psi_img_t *img);
+
+/*!***************************************************************************
+ * @short  Mark the tracks in dst as modified that are modified in src
+ * @return The number of modified tracks in src that don't exist in dst
+ *****************************************************************************/
+unsigned psi_img_copy_dirty (psi_img_t *dst, const psi_img_t *src);
+
 
 #endif
@@ -22,6 +22,7 @@
 
 #include <config.h>
 
+#include <stddef.h>
 #include <stdint.h>
 #include <math.h>
 
@@ -106,48 +107,197 @@ void snd_iir2_set_lowpass (sound_iir2_t *iir, unsigned long freq, unsigned long
 	iir->b[2] = (long) (SND_IIR_MUL * (om * (om - sqrt(2.0)) + 1.0) / b0);
 }
 
+void snd_iir2_set_highpass (sound_iir2_t *iir, unsigned long freq, unsigned long srate)
+{
+	double om, b0;
+
+	snd_iir2_init (iir);
+
+	if ((freq == 0) || (srate == 0)) {
+		return;
+	}
+
+	if ((2 * freq) >= srate) {
+		freq = (srate / 2) - 1;
+	}
+
+	om = 1.0 / tan ((3.14159265358979312 * freq) / srate);
+	b0 = om * (om + sqrt(2.0)) + 1.0;
+
+	iir->a[0] = (long) (SND_IIR_MUL * om * om / b0);
+	iir->a[1] = (long) (SND_IIR_MUL * -2.0 * om * om / b0);
+	iir->a[2] = (long) (SND_IIR_MUL * om * om / b0);
+
+	iir->b[0] = (long) (SND_IIR_MUL * 1.0);
+	iir->b[1] = (long) (SND_IIR_MUL * 2.0 * (1.0 - om * om) / b0);
+	iir->b[2] = (long) (SND_IIR_MUL * (om * (om - sqrt(2.0)) + 1.0) / b0);
+}
+
+/*
+ * A filter with its state and coefficients held in local variables
+ * while a block of samples is processed.
+ */
+typedef struct {
+	long a0, a1, a2;
+	long b1, b2;
+	long x0, x1;
+	long y0, y1;
+} snd_iir2_reg_t;
+
+static inline
+void snd_iir2_load (snd_iir2_reg_t *r, const sound_iir2_t *iir)
+{
+	r->a0 = iir->a[0];
+	r->a1 = iir->a[1];
+	r->a2 = iir->a[2];
+	r->b1 = iir->b[1];
+	r->b2 = iir->b[2];
+	r->x0 = iir->x[0];
+	r->x1 = iir->x[1];
+	r->y0 = iir->y[0];
+	r->y1 = iir->y[1];
+}
+
+static inline
+void snd_iir2_clear (snd_iir2_reg_t *r)
+{
+	r->a0 = 0;
+	r->a1 = 0;
+	r->a2 = 0;
+	r->b1 = 0;
+	r->b2 = 0;
+	r->x0 = 0;
+	r->x1 = 0;
+	r->y0 = 0;
+	r->y1 = 0;
+}
+
+static inline
+void snd_iir2_store (const snd_iir2_reg_t *r, sound_iir2_t *iir)
+{
+	iir->x[0] = r->x0;
+	iir->x[1] = r->x1;
+	iir->y[0] = r->y0;
+	iir->y[1] = r->y1;
+}
+
+/*
+ * Filter one sample. Both v and the result are centered around 0 and
+ * the result is clamped to [-32768, 32767].
+ */
+static inline
+long snd_iir2_step (snd_iir2_reg_t *r, long v)
+{
+	long y;
+
+	y = r->a0 * v + r->a1 * r->x0 + r->a2 * r->x1;
+	y -= r->b1 * r->y0 + r->b2 * r->y1;
+	y = y / SND_IIR_MUL;
+
+	r->x1 = r->x0;
+	r->x0 = v;
+	r->y1 = r->y0;
+	r->y0 = y;
+
+	if (y < -32768) {
+		return (-32768);
+	}
+	else if (y > 32767) {
+		return (32767);
+	}
+
+	return (y);
+}
+
 void snd_iir2_filter (sound_iir2_t *iir, uint16_t *dst, const uint16_t *src,
 	unsigned cnt, unsigned ofs, int sign)
 {
-	long     v;
-	uint16_t sig;
+	long           v;
+	uint16_t       sig;
+	snd_iir2_reg_t r;
+
+	if (cnt == 0) {
+		return;
+	}
 
 	sig = sign ? 0x8000 : 0;
 
+	snd_iir2_load (&r, iir);
+
 	while (cnt > 0) {
-		v = *src ^ sig;
-		v -= 32768;
+		v = (long) (*src ^ sig) - 32768;
+		v = snd_iir2_step (&r, v);
+
+		*dst = (uint16_t) (v + 32768) ^ sig;
+
+		src += ofs;
+		dst += ofs;
+		cnt -= 1;
+	}
+
+	snd_iir2_store (&r, iir);
+}
 
-		iir->x[2] = iir->x[1];
-		iir->x[1] = iir->x[0];
-		iir->x[0] = v;
+void snd_filter_chain (uint16_t *dst, const uint16_t *src, unsigned cnt,
+	unsigned ofs, sound_iir2_t *lp, sound_iir2_t *hp, unsigned volume,
+	int sign)
+{
+	long           v, vol;
+	uint16_t       sig;
+	snd_iir2_reg_t rlp, rhp;
 
-		iir->y[2] = iir->y[1];
-		iir->y[1] = iir->y[0];
+	if (cnt == 0) {
+		return;
+	}
 
-		iir->y[0] = iir->a[0] * iir->x[0];
-		iir->y[0] += iir->a[1] * iir->x[1] + iir->a[2] * iir->x[2];
-		iir->y[0] -= iir->b[1] * iir->y[1] + iir->b[2] * iir->y[2];
+	sig = sign ? 0x8000 : 0;
+	vol = (long) volume;
 
-		iir->y[0] = iir->y[0] / SND_IIR_MUL;
+	snd_iir2_clear (&rlp);
+	snd_iir2_clear (&rhp);
 
-		v = iir->y[0];
-		v += 32768;
+	if (lp != NULL) {
+		snd_iir2_load (&rlp, lp);
+	}
+
+	if (hp != NULL) {
+		snd_iir2_load (&rhp, hp);
+	}
 
-		if (v < 0) {
-			v = 0;
+	while (cnt > 0) {
+		v = (long) (*src ^ sig) - 32768;
+
+		if (lp != NULL) {
+			v = snd_iir2_step (&rlp, v);
 		}
-		else if (v > 65535) {
-			v = 0xffff;
+
+		if (hp != NULL) {
+			v = snd_iir2_step (&rhp, v);
 		}
-		else {
-			v &= 0xffff;
+
+		if (vol != 256) {
+			v = (vol * v + 127) / 256;
+
+			if (v < -32768) {
+				v = -32768;
+			}
+			else if (v > 32767) {
+				v = 32767;
+			}
 		}
 
-		*dst = ((uint16_t) v) ^ sig;
+		*dst = (uint16_t) (v + 32768) ^ sig;
 
 		src += ofs;
 		dst += ofs;
 		cnt -= 1;
 	}
+
+	if (lp != NULL) {
+		snd_iir2_store (&rlp, lp);
+	}
+
+	if (hp != NULL) {
+		snd_iir2_store (&rhp, hp);
+	}
 }
@@ -67,6 +67,15 @@ void snd_iir2_set_lowpass (sound_iir2_t *iir,
 	unsigned long freq, unsigned long srate
 );
 
+/*!***************************************************************************
+ * @short Initialize a high-pass IIR filter
+ * @param freq   The cut-off frequency
+ * @param srate  The sample rate
+ *****************************************************************************/
+void snd_iir2_set_highpass (sound_iir2_t *iir,
+	unsigned long freq, unsigned long srate
+);
+
 /*!***************************************************************************
  * @short Filter samples with an IIR2 filter
  * @param dst   The destination buffer
@@ -82,4 +91,24 @@ void snd_iir2_filter (sound_iir2_t *iir,
 );
 
 
+/*!***************************************************************************
+ * @short Filter samples and adjust the volume in one pass
+ * @param dst     The destination buffer
+ * @param src     The source buffer
+ * @param cnt     The sample count
+ * @param ofs     The sample offset in both src and dst
+ * @param lp      The low-pass filter or NULL
+ * @param hp      The high-pass filter or NULL
+ * @param volume  The volume adjustment is (volume / 256)
+ * @param sign    The sample signedness in both src and dst
+ *
+ * This is equivalent to calling snd_iir2_filter() with lp and hp followed
+ * by snd_volume(). The source and destination buffer can be the same.
+ *****************************************************************************/
+void snd_filter_chain (uint16_t *dst, const uint16_t *src, unsigned cnt,
+	unsigned ofs, sound_iir2_t *lp, sound_iir2_t *hp, unsigned volume,
+	int sign
+);
+
+
 #endif
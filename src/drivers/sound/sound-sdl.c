@@ -20,6 +20,8 @@
  *****************************************************************************/
 
 
+#include <config.h>
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -36,70 +38,79 @@
 #endif
 
 
+/*
+ * The ring buffer is shared between snd_sdl_write() (the producer) and
+ * the SDL audio callback (the consumer) without locking. The data must be
+ * visible to the other side before the index that publishes it.
+ */
+#if defined(PCE_ENABLE_SDL2)
+#define snd_sdl_release() SDL_MemoryBarrierRelease()
+#define snd_sdl_acquire() SDL_MemoryBarrierAcquire()
+#elif defined(__GNUC__)
+#define snd_sdl_release() __sync_synchronize()
+#define snd_sdl_acquire() __sync_synchronize()
+#else
+#define snd_sdl_release()
+#define snd_sdl_acquire()
+#endif
+
+
 static
-sound_sdl_buf_t *snd_sdl_buf_new (sound_sdl_t *drv, unsigned size)
+unsigned long snd_sdl_ms_to_bytes (sound_sdl_t *drv, unsigned long ms, unsigned long srate)
 {
-	unsigned char   *tmp;
-	sound_sdl_buf_t *buf;
+	unsigned long cnt;
 
-	if (drv->free != NULL) {
-		buf = drv->free;
-		drv->free = drv->free->next;
-	}
-	else {
-		if (drv->buf_cnt > 32) {
-			return (NULL);
-		}
+	cnt = (srate * ms + 999) / 1000;
 
-		buf = malloc (sizeof (sound_sdl_buf_t));
+	return (cnt * drv->frame);
+}
 
-		if (buf == NULL) {
-			return (NULL);
-		}
+static
+void snd_sdl_ring_free (sound_sdl_t *drv)
+{
+	free (drv->ring);
 
-		buf->max = 0;
-		buf->data = NULL;
+	drv->ring = NULL;
+	drv->ring_size = 0;
+	drv->ring_rd = 0;
+	drv->ring_wr = 0;
+}
 
-		drv->buf_cnt += 1;
-	}
+static
+int snd_sdl_ring_alloc (sound_sdl_t *drv, unsigned long srate)
+{
+	unsigned long size, min;
 
-	buf->next = NULL;
+	snd_sdl_ring_free (drv);
 
-	buf->idx = 0;
-	buf->cnt = 0;
+	drv->target_min = snd_sdl_ms_to_bytes (drv, drv->latency_min, srate);
+	drv->target_max = snd_sdl_ms_to_bytes (drv, drv->latency_max, srate);
 
-	if (buf->max < size) {
-		tmp = realloc (buf->data, size);
+	if (drv->target_max < drv->target_min) {
+		drv->target_max = drv->target_min;
+	}
 
-		if (tmp == NULL) {
-			free (buf->data);
-			free (buf);
+	drv->target = drv->target_min;
 
-			drv->buf_cnt -= 1;
+	min = 2 * drv->target_max + (unsigned long) drv->frame * drv->samples;
 
-			return (NULL);
-		}
+	size = 4096;
 
-		buf->max = size;
-		buf->data = tmp;
+	while (size < min) {
+		size *= 2;
 	}
 
-	return (buf);
-}
-
-static
-void snd_sdl_buf_free_list (sound_sdl_buf_t *buf)
-{
-	sound_sdl_buf_t *tmp;
+	if ((drv->ring = malloc (size)) == NULL) {
+		return (1);
+	}
 
-	while (buf != NULL) {
-		tmp = buf;
-		buf = buf->next;
+	drv->ring_size = size;
 
-		free (tmp->data);
-		free (tmp);
-	}
+	drv->running = 0;
+	drv->last_wr = 0;
+	drv->good_cnt = 0;
 
+	return (0);
 }
 
 static
@@ -113,8 +124,13 @@ void snd_sdl_close (sound_drv_t *sdrv)
 		SDL_CloseAudio();
 	}
 
-	snd_sdl_buf_free_list (drv->head);
-	snd_sdl_buf_free_list (drv->free);
+#if DEBUG_SND_SDL >= 1
+	fprintf (stderr, "snd-sdl: %lu underruns, %lu overruns\n",
+		drv->underruns, drv->overruns
+	);
+#endif
+
+	snd_sdl_ring_free (drv);
 
 	snd_free (sdrv);
 
@@ -124,21 +140,25 @@ void snd_sdl_close (sound_drv_t *sdrv)
 static
 int snd_sdl_write (sound_drv_t *sdrv, const uint16_t *buf, unsigned cnt)
 {
-	int             sign;
-	unsigned long   bcnt, scnt;
-	sound_sdl_buf_t *bbuf;
-	sound_sdl_t     *drv;
+	int           sign;
+	unsigned long bcnt, scnt;
+	unsigned long wr, avail, idx, n;
+	sound_sdl_t   *drv;
 
 	drv = sdrv->ext;
 
+	if (drv->ring == NULL) {
+		return (1);
+	}
+
 	scnt = (unsigned long) sdrv->channels * (unsigned long) cnt;
 	bcnt = 2 * scnt;
 
-	SDL_LockAudio();
-	bbuf = snd_sdl_buf_new (drv, bcnt);
-	SDL_UnlockAudio();
+	wr = drv->ring_wr;
+	avail = drv->ring_size - (wr - drv->ring_rd);
 
-	if (bbuf == NULL) {
+	if (bcnt > avail) {
+		drv->overruns += 1;
 #if DEBUG_SND_SDL >= 1
 		fprintf (stderr, "snd-sdl: buffer overrun\n");
 #endif
@@ -147,23 +167,20 @@ int snd_sdl_write (sound_drv_t *sdrv, const uint16_t *buf, unsigned cnt)
 
 	sign = (sdrv->sample_sign != drv->sign);
 
-	snd_set_buf (bbuf->data, buf, scnt, sign, drv->big_endian);
-
-	bbuf->idx = 0;
-	bbuf->cnt = bcnt;
+	idx = wr & (drv->ring_size - 1);
+	n = drv->ring_size - idx;
 
-	SDL_LockAudio();
-
-	if (drv->tail == NULL) {
-		drv->head = bbuf;
+	if (n >= bcnt) {
+		snd_set_buf (drv->ring + idx, buf, scnt, sign, drv->big_endian);
 	}
 	else {
-		drv->tail->next = bbuf;
+		snd_set_buf (drv->ring + idx, buf, n / 2, sign, drv->big_endian);
+		snd_set_buf (drv->ring, buf + n / 2, scnt - n / 2, sign, drv->big_endian);
 	}
 
-	drv->tail = bbuf;
+	snd_sdl_release();
 
-	SDL_UnlockAudio();
+	drv->ring_wr = wr + bcnt;
 
 	if (drv->is_paused) {
 		SDL_PauseAudio (0);
@@ -173,55 +190,128 @@ int snd_sdl_write (sound_drv_t *sdrv, const uint16_t *buf, unsigned cnt)
 	return (0);
 }
 
+/*
+ * Adjust the target fill level after the callback consumed cnt bytes.
+ */
+static
+void snd_sdl_adjust_target (sound_sdl_t *drv, unsigned long cnt, int underrun)
+{
+	unsigned long tgt;
+
+	tgt = drv->target;
+
+	if (underrun) {
+		tgt += tgt / 2;
+
+		if (tgt > drv->target_max) {
+			tgt = drv->target_max;
+		}
+
+		drv->good_cnt = 0;
+	}
+	else {
+		drv->good_cnt += cnt;
+
+		/* shrink the target after a few seconds without underruns */
+		if (drv->good_cnt < 64 * tgt) {
+			return;
+		}
+
+		drv->good_cnt = 0;
+
+		tgt -= tgt / 16;
+
+		if (tgt < drv->target_min) {
+			tgt = drv->target_min;
+		}
+	}
+
+	drv->target = tgt - (tgt % drv->frame);
+}
+
 static
 void snd_sdl_callback (void *user, Uint8 *buf, int cnt)
 {
-	int             n;
-	sound_sdl_t     *drv;
-	sound_sdl_buf_t *src;
+	int           underrun;
+	unsigned long wr, rd, avail, idx, n;
+	sound_sdl_t   *drv;
 
 	drv = user;
 
-	if (drv->head == NULL) {
-		SDL_PauseAudio (1);
-		drv->is_paused = 1;
-		return;
+	wr = drv->ring_wr;
+	rd = drv->ring_rd;
+
+	snd_sdl_acquire();
+
+	avail = wr - rd;
+
+	if (drv->running == 0) {
+		/*
+		 * Wait until the target fill level is reached, or until
+		 * the producer stopped writing.
+		 */
+		if ((avail == 0) || ((avail < drv->target) && (wr != drv->last_wr))) {
+			drv->last_wr = wr;
+			memset (buf, 0, cnt);
+			return;
+		}
+
+		drv->running = 1;
 	}
 
-	while (cnt > 0) {
-		if (drv->head == NULL) {
+	underrun = 0;
+
+	if (avail < (unsigned long) cnt) {
+		memset (buf + avail, 0, cnt - avail);
+
+		if (wr != drv->last_wr) {
+			/* the producer is active but could not keep up */
+			drv->underruns += 1;
+			underrun = 1;
 #if DEBUG_SND_SDL >= 1
 			fprintf (stderr, "snd-sdl: buffer underrun\n");
 #endif
-			memset (buf, 0, cnt);
-			return;
 		}
 
-		src = drv->head;
+		drv->running = 0;
 
-		n = src->cnt - src->idx;
+		cnt = avail;
+	}
 
-		if (n <= cnt) {
-			memcpy (buf, src->data + src->idx, n);
+	idx = rd & (drv->ring_size - 1);
+	n = drv->ring_size - idx;
 
-			buf += n;
-			cnt -= n;
+	if (n >= (unsigned long) cnt) {
+		memcpy (buf, drv->ring + idx, cnt);
+	}
+	else {
+		memcpy (buf, drv->ring + idx, n);
+		memcpy (buf + n, drv->ring, cnt - n);
+	}
 
-			drv->head = src->next;
+	snd_sdl_release();
 
-			if (drv->head == NULL) {
-				drv->tail = NULL;
-			}
+	drv->ring_rd = rd + cnt;
+	drv->last_wr = wr;
 
-			src->next = drv->free;
-			drv->free = src;
-		}
-		else {
-			memcpy (buf, src->data + src->idx, cnt);
-			src->idx += cnt;
-			cnt = 0;
-		}
+	snd_sdl_adjust_target (drv, cnt, underrun);
+}
+
+static
+int snd_sdl_get_delay (sound_drv_t *sdrv, unsigned long *cur, unsigned long *tgt)
+{
+	sound_sdl_t *drv;
+
+	drv = sdrv->ext;
+
+	if (drv->ring == NULL) {
+		return (1);
 	}
+
+	*cur = (drv->ring_wr - drv->ring_rd) / drv->frame;
+	*tgt = drv->target / drv->frame;
+
+	return (0);
 }
 
 static
@@ -247,10 +337,16 @@ int snd_sdl_set_params (sound_drv_t *sdrv, unsigned chn, unsigned long srate, in
 		drv->is_open = 0;
 	}
 
+	drv->frame = 2 * chn;
+
+	if (snd_sdl_ring_alloc (drv, srate)) {
+		return (1);
+	}
+
 	req.freq = srate;
 	req.format = AUDIO_S16LSB;
 	req.channels = chn;
-	req.samples = 1024;
+	req.samples = drv->samples;
 	req.callback = snd_sdl_callback;
 	req.userdata = drv;
 
@@ -258,6 +354,7 @@ int snd_sdl_set_params (sound_drv_t *sdrv, unsigned chn, unsigned long srate, in
 		fprintf (stderr, "snd-sdl: error opening output (%s)\n",
 			SDL_GetError()
 		);
+		snd_sdl_ring_free (drv);
 		return (1);
 	}
 
@@ -280,15 +377,36 @@ int snd_sdl_init (sound_sdl_t *drv, const char *name)
 	drv->sdrv.close = snd_sdl_close;
 	drv->sdrv.write = snd_sdl_write;
 	drv->sdrv.set_params = snd_sdl_set_params;
+	drv->sdrv.get_delay = snd_sdl_get_delay;
 
 	drv->is_open = 0;
 	drv->is_paused = 1;
 
-	drv->buf_cnt = 0;
+	drv->samples = drv_get_option_uint (name, "samples", 1024);
+	drv->frame = 2;
+
+	if ((drv->samples < 64) || (drv->samples > 32768)) {
+		drv->samples = 1024;
+	}
+
+	drv->latency_min = drv_get_option_uint (name, "latency", 40);
+	drv->latency_max = drv_get_option_uint (name, "latencymax", 250);
+
+	drv->ring_size = 0;
+	drv->ring = NULL;
+	drv->ring_rd = 0;
+	drv->ring_wr = 0;
+
+	drv->target = 0;
+	drv->target_min = 0;
+	drv->target_max = 0;
+
+	drv->running = 0;
+	drv->last_wr = 0;
+	drv->good_cnt = 0;
 
-	drv->head = NULL;
-	drv->tail = NULL;
-	drv->free = NULL;
+	drv->underruns = 0;
+	drv->overruns = 0;
 
 	return (0);
 }
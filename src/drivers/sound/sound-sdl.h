@@ -27,28 +27,43 @@
 #include <drivers/sound/sound.h>
 
 
-typedef struct sound_sdl_buf_t {
-	struct sound_sdl_buf_t *next;
-	unsigned               idx;
-	unsigned               cnt;
-	unsigned               max;
-	unsigned char          *data;
-} sound_sdl_buf_t;
-
 typedef struct sound_sdl_t {
-	sound_drv_t sdrv;
+	sound_drv_t   sdrv;
+
+	char          is_open;
+	char          is_paused;
+
+	int           sign;
+	int           big_endian;
+
+	unsigned      samples;
+	unsigned      frame;
+
+	unsigned long latency_min;
+	unsigned long latency_max;
+
+	/* the ring buffer, size is a power of 2 */
+	unsigned long ring_size;
+	unsigned char *ring;
+
+	/* written by snd_sdl_write() only */
+	volatile unsigned long ring_wr;
 
-	char        is_open;
-	char        is_paused;
+	/* written by the callback only */
+	volatile unsigned long ring_rd;
 
-	int         sign;
-	int         big_endian;
+	/* the target fill level in bytes, written by the callback only */
+	volatile unsigned long target;
+	unsigned long          target_min;
+	unsigned long          target_max;
 
-	unsigned        buf_cnt;
+	/* callback state */
+	char          running;
+	unsigned long last_wr;
+	unsigned long good_cnt;
 
-	sound_sdl_buf_t *head;
-	sound_sdl_buf_t *tail;
-	sound_sdl_buf_t *free;
+	volatile unsigned long underruns;
+	unsigned long          overruns;
 } sound_sdl_t;
 
 
@@ -29,6 +29,8 @@
 #include <drivers/sound/sound.h>
 #include <drivers/sound/sound-wav.h>
 
+#include <lib/sysdep.h>
+
 
 struct snd_drv_list {
 	const char *prefix;
@@ -54,7 +56,8 @@ struct snd_drv_list drvtab[] = {
 
 /*
  * Initialize the low-pass filter in sdrv->lowpass_iir2 with a cut-off
- * frequency of sdrv->lowpass_freq.
+ * frequency of sdrv->lowpass_freq and the high-pass filter in
+ * sdrv->highpass_iir2 with a cut-off frequency of sdrv->highpass_freq.
  */
 static
 void snd_fix_lowpass (sound_drv_t *sdrv)
@@ -68,6 +71,13 @@ void snd_fix_lowpass (sound_drv_t *sdrv)
 		);
 
 		snd_iir2_reset (&sdrv->lowpass_iir2[i]);
+
+		snd_iir2_set_highpass (
+			&sdrv->highpass_iir2[i],
+			sdrv->highpass_freq, sdrv->sample_rate
+		);
+
+		snd_iir2_reset (&sdrv->highpass_iir2[i]);
 	}
 }
 
@@ -121,24 +131,18 @@ void snd_set_buf (unsigned char *dst, const uint16_t *src, unsigned long cnt,
 
 	if (be) {
 		for (i = 0; i < cnt; i++) {
-			val = *src ^ sig;
+			val = src[i] ^ sig;
 
-			dst[0] = (val >> 8) & 0xff;
-			dst[1] = val & 0xff;
-
-			dst += 2;
-			src += 1;
+			dst[2 * i + 0] = (val >> 8) & 0xff;
+			dst[2 * i + 1] = val & 0xff;
 		}
 	}
 	else {
 		for (i = 0; i < cnt; i++) {
-			val = *src ^ sig;
-
-			dst[0] = val & 0xff;
-			dst[1] = (val >> 8) & 0xff;
+			val = src[i] ^ sig;
 
-			dst += 2;
-			src += 1;
+			dst[2 * i + 0] = val & 0xff;
+			dst[2 * i + 1] = (val >> 8) & 0xff;
 		}
 	}
 }
@@ -152,6 +156,7 @@ void snd_init (sound_drv_t *sdrv, void *ext)
 	sdrv->sample_sign = 0;
 
 	sdrv->lowpass_freq = 0;
+	sdrv->highpass_freq = 0;
 
 	sdrv->bbuf_max = 0;
 	sdrv->bbuf = NULL;
@@ -163,11 +168,18 @@ void snd_init (sound_drv_t *sdrv, void *ext)
 	sdrv->wav_cnt = 0;
 	sdrv->wav_filter = 1;
 
+	sdrv->stat_samples = 0;
+	sdrv->stat_us = 0;
+
 	sdrv->close = NULL;
 
 	sdrv->write = NULL;
 
 	sdrv->set_params = NULL;
+
+	sdrv->set_opts = NULL;
+
+	sdrv->get_delay = NULL;
 }
 
 void snd_free (sound_drv_t *sdrv)
@@ -203,6 +215,13 @@ const uint16_t *snd_filter (sound_drv_t *sdrv, const uint16_t *buf, unsigned cnt
 	unsigned      i;
 	unsigned long scnt;
 	uint16_t      *sbuf;
+	sound_iir2_t  *lp, *hp;
+
+	if ((sdrv->lowpass_freq == 0) && (sdrv->highpass_freq == 0)) {
+		if (sdrv->volume == 256) {
+			return (buf);
+		}
+	}
 
 	scnt = (unsigned long) sdrv->channels * (unsigned long) cnt;
 
@@ -210,40 +229,42 @@ const uint16_t *snd_filter (sound_drv_t *sdrv, const uint16_t *buf, unsigned cnt
 		return (NULL);
 	}
 
-	if (sdrv->lowpass_freq != 0) {
-		for (i = 0; i < sdrv->channels; i++) {
-			snd_iir2_filter (
-				&sdrv->lowpass_iir2[i], sbuf + i, buf + i,
-				cnt, sdrv->channels, sdrv->sample_sign
-			);
-		}
-
-		buf = sbuf;
-	}
+	for (i = 0; i < sdrv->channels; i++) {
+		lp = (sdrv->lowpass_freq != 0) ? &sdrv->lowpass_iir2[i] : NULL;
+		hp = (sdrv->highpass_freq != 0) ? &sdrv->highpass_iir2[i] : NULL;
 
-	if (sdrv->volume != 256) {
-		snd_volume (sbuf, buf, scnt, sdrv->volume, sdrv->sample_sign);
-		buf = sbuf;
+		snd_filter_chain (sbuf + i, buf + i, cnt, sdrv->channels,
+			lp, hp, sdrv->volume, sdrv->sample_sign
+		);
 	}
 
-	return (buf);
+	return (sbuf);
 }
 
 int snd_write (sound_drv_t *sdrv, const uint16_t *buf, unsigned cnt)
 {
-	int            r;
-	const uint16_t *sbuf;
+	int                r;
+	unsigned long long t;
+	const uint16_t     *sbuf;
 
 	if ((sdrv == NULL) || (sdrv->write == NULL)) {
 		return (1);
 	}
 
+	t = pce_get_stat_us();
+
 	sbuf = snd_filter (sdrv, buf, cnt);
 
 	r = sdrv->write (sdrv, sbuf, cnt);
 
 	snd_wav_write (sdrv, sdrv->wav_filter ? sbuf : buf, cnt);
 
+	sdrv->stat_samples += cnt;
+
+	if (t > 0) {
+		sdrv->stat_us += pce_get_cpu_us() - t;
+	}
+
 	return (r);
 }
 
@@ -322,6 +343,19 @@ int snd_set_opts (sound_drv_t *sdrv, unsigned opts, int val)
 	return (0);
 }
 
+int snd_get_delay (sound_drv_t *sdrv, unsigned long *cur, unsigned long *tgt)
+{
+	if (sdrv == NULL) {
+		return (1);
+	}
+
+	if (sdrv->get_delay == NULL) {
+		return (1);
+	}
+
+	return (sdrv->get_delay (sdrv, cur, tgt));
+}
+
 void snd_set_volume (sound_drv_t *sdrv, unsigned val)
 {
 	sdrv->volume = (val <= 65535) ? val : 65535;
@@ -348,6 +382,7 @@ sound_drv_t *snd_open_sdrv (sound_drv_t *sdrv, const char *name)
 	sdrv->wav_filter = drv_get_option_bool (name, "wavfilter", 1);
 
 	sdrv->lowpass_freq = drv_get_option_uint (name, "lowpass", 0);
+	sdrv->highpass_freq = drv_get_option_uint (name, "highpass", 0);
 
 	snd_fix_lowpass (sdrv);
 
@@ -50,6 +50,9 @@ typedef struct sound_drv_t {
 	unsigned long lowpass_freq;
 	sound_iir2_t  lowpass_iir2[SND_CHN_MAX];
 
+	unsigned long highpass_freq;
+	sound_iir2_t  highpass_iir2[SND_CHN_MAX];
+
 	unsigned long bbuf_max;
 	unsigned char *bbuf;
 
@@ -60,6 +63,10 @@ typedef struct sound_drv_t {
 	unsigned long wav_cnt;
 	char          wav_filter;
 
+	/* statistics */
+	unsigned long long stat_samples;
+	unsigned long long stat_us;
+
 	void (*close) (struct sound_drv_t *sdrv);
 
 	int (*write) (struct sound_drv_t *sdrv, const uint16_t *buf, unsigned cnt);
@@ -69,6 +76,10 @@ typedef struct sound_drv_t {
 	);
 
 	int (*set_opts) (struct sound_drv_t *sdrv, unsigned opts, int val);
+
+	int (*get_delay) (struct sound_drv_t *sdrv,
+		unsigned long *cur, unsigned long *tgt
+	);
 } sound_drv_t;
 
 
@@ -114,8 +125,9 @@ void snd_close (sound_drv_t *sdrv);
  * @param buf  The source samples
  * @param cnt  The number of samples in buf
  *
- * The samples in buf are filtered by sdrv->lowpass_iir2. The buffer returned
- * is sdrv->sbuf.
+ * The samples in buf are filtered by sdrv->lowpass_iir2 and
+ * sdrv->highpass_iir2 and the volume is adjusted, all in one pass over
+ * the samples. The buffer returned is sdrv->sbuf.
  *****************************************************************************/
 const uint16_t *snd_filter (sound_drv_t *sdrv, const uint16_t *buf, unsigned cnt);
 
@@ -141,6 +153,17 @@ int snd_set_params (sound_drv_t *sdrv, unsigned chn, unsigned long srate, int si
 
 int snd_set_opts (sound_drv_t *sdrv, unsigned opts, int val);
 
+/*!***************************************************************************
+ * @short  Get the output buffer fill level
+ * @retval cur  The number of buffered samples per channel
+ * @retval tgt  The number of buffered samples per channel the driver aims for
+ * @return Non-zero if the driver does not buffer its output
+ *
+ * Emulators can use this to adjust their speed control so that the
+ * sound buffer neither runs dry nor overflows.
+ *****************************************************************************/
+int snd_get_delay (sound_drv_t *sdrv, unsigned long *cur, unsigned long *tgt);
+
 void snd_set_volume (sound_drv_t *sdrv, unsigned val);
 
 
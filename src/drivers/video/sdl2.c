@@ -357,6 +357,7 @@ int sdl2_set_frame_size (sdl2_t *sdl)
 
 	sdl->txt_w = tw;
 	sdl->txt_h = th;
+	sdl->txt_full = 1;
 
 	return (0);
 }
@@ -379,8 +380,7 @@ static
 void sdl2_update (sdl2_t *sdl)
 {
 	terminal_t *trm;
-	void       *pixels;
-	int        pitch;
+	SDL_Rect   rect;
 
 	trm = &sdl->trm;
 
@@ -398,9 +398,29 @@ void sdl2_update (sdl2_t *sdl)
 		return;
 	}
 
-	SDL_LockTexture (sdl->texture, NULL, &pixels, &pitch);
-	memcpy (pixels, trm->buf, 3UL * trm->w * trm->h);
-	SDL_UnlockTexture (sdl->texture);
+	rect.x = 0;
+	rect.y = 0;
+	rect.w = trm->w;
+	rect.h = trm->h;
+
+	if (sdl->txt_full == 0) {
+		/* only upload the lines that changed */
+		rect.y = trm->update_y;
+		rect.h = trm->update_h;
+
+		if ((rect.y + rect.h) > (int) trm->h) {
+			rect.y = 0;
+			rect.h = trm->h;
+		}
+	}
+
+	if (rect.h > 0) {
+		SDL_UpdateTexture (sdl->texture, &rect,
+			trm->buf + 3UL * trm->w * rect.y, 3 * trm->w
+		);
+	}
+
+	sdl->txt_full = 0;
 
 	SDL_RenderCopy (sdl->render, sdl->texture, NULL, NULL);
 	SDL_RenderPresent (sdl->render);
@@ -870,6 +890,7 @@ void sdl2_init (sdl2_t *sdl, ini_sct_t *sct)
 
 	sdl->txt_w = 0;
 	sdl->txt_h = 0;
+	sdl->txt_full = 1;
 
 	sdl->wdw_w = 0;
 	sdl->wdw_h = 0;
@@ -51,6 +51,7 @@ typedef struct {
 
 	unsigned      txt_w;
 	unsigned      txt_h;
+	char          txt_full;
 
 	unsigned      wdw_w;
 	unsigned      wdw_h;
@@ -97,6 +97,9 @@ void trm_init (terminal_t *trm, void *ext)
 	trm->update_w = 0;
 	trm->update_h = 0;
 
+	trm->stat_updates = 0;
+	trm->stat_us = 0;
+
 	trm->pict_index = 0;
 }
 
@@ -286,6 +289,7 @@ void trm_set_size (terminal_t *trm, unsigned w, unsigned h)
 
 		tmp = realloc (trm->buf, cnt);
 		if (tmp == NULL) {
+			trm_set_size (trm, 0, 0);
 			return;
 		}
 
@@ -371,10 +375,13 @@ void trm_set_lines (terminal_t *trm, const void *buf, unsigned y, unsigned cnt)
 	const unsigned char *src;
 	unsigned char       *dst;
 
+	if ((dst = trm_get_lines (trm, y, cnt)) == NULL) {
+		return;
+	}
+
 	w3 = 3UL * trm->w;
 
 	src = buf;
-	dst = trm->buf + w3 * y;
 
 	while (cnt > 0) {
 		if (memcmp (dst, src, w3) != 0) {
@@ -405,6 +412,28 @@ void trm_set_lines (terminal_t *trm, const void *buf, unsigned y, unsigned cnt)
 
 	memcpy (dst, src, w3 * cnt);
 
+	trm_set_lines_dirty (trm, y, cnt);
+}
+
+unsigned char *trm_get_lines (terminal_t *trm, unsigned y, unsigned cnt)
+{
+	if (trm->buf == NULL) {
+		return (NULL);
+	}
+
+	if ((y > trm->h) || (cnt > (trm->h - y))) {
+		return (NULL);
+	}
+
+	return (trm->buf + 3UL * trm->w * y);
+}
+
+void trm_set_lines_dirty (terminal_t *trm, unsigned y, unsigned cnt)
+{
+	if (cnt == 0) {
+		return;
+	}
+
 	trm->update_x = 0;
 	trm->update_w = trm->w;
 
@@ -426,12 +455,22 @@ void trm_set_lines (terminal_t *trm, const void *buf, unsigned y, unsigned cnt)
 
 void trm_update (terminal_t *trm)
 {
+	unsigned long long t;
+
 	if ((trm->update_w == 0) || (trm->update_h == 0)) {
 		return;
 	}
 
 	if (trm->update != NULL) {
+		t = pce_get_stat_us();
+
 		trm->update (trm->ext);
+
+		trm->stat_updates += 1;
+
+		if (t > 0) {
+			trm->stat_us += pce_get_cpu_us() - t;
+		}
 	}
 
 	trm->update_x = 0;
@@ -94,6 +94,10 @@ typedef struct {
 	unsigned      update_w;
 	unsigned      update_h;
 
+	/* statistics */
+	unsigned long long stat_updates;
+	unsigned long long stat_us;
+
 	/* picture index for screenshots */
 	unsigned      pict_index;
 } terminal_t;
@@ -222,6 +226,28 @@ void trm_set_pixel (terminal_t *trm, unsigned x, unsigned y, const unsigned char
  *****************************************************************************/
 void trm_set_lines (terminal_t *trm, const void *buf, unsigned y, unsigned cnt);
 
+/*!***************************************************************************
+ * @short Get a pointer to lines in the terminal buffer
+ * @param y   The first line in the terminal buffer
+ * @param cnt The number of lines
+ * @return A pointer to line y or NULL if the lines are not in the buffer
+ *
+ * This allows a device to render directly into the terminal buffer,
+ * 3 bytes per pixel (RGB) and trm->w pixels per line. The modified lines
+ * must then be marked with trm_set_lines_dirty(). The pointer is
+ * invalidated by trm_set_size().
+ *****************************************************************************/
+unsigned char *trm_get_lines (terminal_t *trm, unsigned y, unsigned cnt);
+
+/*!***************************************************************************
+ * @short Mark lines in the terminal buffer as modified
+ * @param y   The first line in the terminal buffer
+ * @param cnt The number of lines
+ *
+ * The lines will be sent to the screen by the next call to trm_update().
+ *****************************************************************************/
+void trm_set_lines_dirty (terminal_t *trm, unsigned y, unsigned cnt);
+
 /*!***************************************************************************
  * @short Update the screen from the terminal buffer
  *****************************************************************************/
@@ -20,9 +20,16 @@
  *****************************************************************************/
 
 
+#include <config.h>
+
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef PCE_ENABLE_X11_SHM
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
+
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/Xos.h>
@@ -312,6 +319,191 @@ void xt_set_window_title (xterm_t *xt, const char *str)
 	XFlush (xt->display);
 }
 
+/* the generic converter using xt_get_pixel() */
+#define XT_FMT_GENERIC 0
+/* 32 bits per pixel, 8 bits per channel, B G R X in memory */
+#define XT_FMT_BGRX    1
+/* 32 or 24 bits per pixel, 8 bits per channel, arbitrary byte order */
+#define XT_FMT_BYTE32  2
+#define XT_FMT_BYTE24  3
+
+
+/*
+ * Decode a bit mask into the first set bit and the number of set bits
+ */
+static
+void xt_decode_mask (unsigned long mask, unsigned *i, unsigned *n)
+{
+	*i = 0;
+	*n = 0;
+
+	if (mask == 0) {
+		return;
+	}
+
+	while ((mask & 1) == 0) {
+		mask = mask >> 1;
+		*i += 1;
+	}
+
+	while (mask & 1) {
+		mask = mask >> 1;
+		*n += 1;
+	}
+}
+
+/*
+ * Get the byte offset of an 8 bit channel within a pixel
+ */
+static
+unsigned xt_get_byte_ofs (const XImage *img, unsigned shift, unsigned bpp)
+{
+	if (img->byte_order == MSBFirst) {
+		return (bpp - 1 - shift / 8);
+	}
+
+	return (shift / 8);
+}
+
+/*
+ * Select the converter for the pixel format of the backing image
+ */
+static
+void xt_image_get_format (xterm_t *xt)
+{
+	unsigned *sh;
+	unsigned bpp;
+	unsigned used;
+
+	sh = xt->img_shift;
+
+	xt_decode_mask (xt->img->red_mask, &sh[0], &sh[1]);
+	xt_decode_mask (xt->img->green_mask, &sh[2], &sh[3]);
+	xt_decode_mask (xt->img->blue_mask, &sh[4], &sh[5]);
+
+	xt->img_fmt = XT_FMT_GENERIC;
+
+	bpp = xt->img->bits_per_pixel / 8;
+
+	if ((bpp != 3) && (bpp != 4)) {
+		return;
+	}
+
+	if ((sh[1] != 8) || (sh[3] != 8) || (sh[5] != 8)) {
+		return;
+	}
+
+	if ((sh[0] & 7) || (sh[2] & 7) || (sh[4] & 7)) {
+		return;
+	}
+
+	xt->img_ofs[0] = xt_get_byte_ofs (xt->img, sh[0], bpp);
+	xt->img_ofs[1] = xt_get_byte_ofs (xt->img, sh[2], bpp);
+	xt->img_ofs[2] = xt_get_byte_ofs (xt->img, sh[4], bpp);
+
+	if (bpp == 3) {
+		xt->img_fmt = XT_FMT_BYTE24;
+		return;
+	}
+
+	/* the unused byte */
+	used = (1U << xt->img_ofs[0]) | (1U << xt->img_ofs[1]) | (1U << xt->img_ofs[2]);
+	xt->img_ofs[3] = 0;
+
+	while (used & (1U << xt->img_ofs[3])) {
+		xt->img_ofs[3] += 1;
+	}
+
+	if ((xt->img_ofs[0] == 2) && (xt->img_ofs[1] == 1) && (xt->img_ofs[2] == 0)) {
+		xt->img_fmt = XT_FMT_BGRX;
+	}
+	else {
+		xt->img_fmt = XT_FMT_BYTE32;
+	}
+}
+
+#ifdef PCE_ENABLE_X11_SHM
+static int xt_shm_error = 0;
+
+static
+int xt_shm_error_handler (Display *dpy, XErrorEvent *evt)
+{
+	xt_shm_error = 1;
+
+	return (0);
+}
+
+/*
+ * Allocate the backing image in a shared memory segment
+ */
+static
+int xt_image_alloc_shm (xterm_t *xt, Visual *vis, unsigned depth, unsigned w, unsigned h)
+{
+	Bool            ok;
+	XShmSegmentInfo *shm;
+	XErrorHandler   old;
+
+	if (XShmQueryExtension (xt->display) == False) {
+		return (1);
+	}
+
+	shm = &xt->shm_info;
+
+	xt->img = XShmCreateImage (xt->display, vis, depth, ZPixmap, NULL, shm, w, h);
+
+	if (xt->img == NULL) {
+		return (1);
+	}
+
+	shm->shmid = shmget (IPC_PRIVATE,
+		(size_t) xt->img->bytes_per_line * h, IPC_CREAT | 0600
+	);
+
+	if (shm->shmid < 0) {
+		XDestroyImage (xt->img);
+		xt->img = NULL;
+		return (1);
+	}
+
+	shm->shmaddr = shmat (shm->shmid, NULL, 0);
+
+	if (shm->shmaddr == (char *) -1) {
+		shmctl (shm->shmid, IPC_RMID, NULL);
+		XDestroyImage (xt->img);
+		xt->img = NULL;
+		return (1);
+	}
+
+	shm->readOnly = False;
+
+	xt->img->data = shm->shmaddr;
+
+	/* XShmAttach fails if the X server is not on the local host */
+	XSync (xt->display, False);
+	xt_shm_error = 0;
+	old = XSetErrorHandler (xt_shm_error_handler);
+	ok = XShmAttach (xt->display, shm);
+	XSync (xt->display, False);
+	XSetErrorHandler (old);
+
+	/* the segment is removed after the last detach */
+	shmctl (shm->shmid, IPC_RMID, NULL);
+
+	if (xt_shm_error || (ok == False)) {
+		shmdt (shm->shmaddr);
+		xt->img->data = NULL;
+		XDestroyImage (xt->img);
+		xt->img = NULL;
+		return (1);
+	}
+
+	xt->img_buf = (unsigned char *) shm->shmaddr;
+	xt->img_shm = 1;
+
+	return (0);
+}
+#endif
+
 /*
  * Allocate the backing image
  */
@@ -328,10 +520,26 @@ int xt_image_alloc (xterm_t *xt, unsigned w, unsigned h)
 
 	depth = attrib.depth;
 
+	xt->img_shm = 0;
+
+#ifdef PCE_ENABLE_X11_SHM
+	if (xt->use_shm) {
+		if (xt_image_alloc_shm (xt, vis, depth, w, h) == 0) {
+			xt_image_get_format (xt);
+			return (0);
+		}
+
+		/* don't try again */
+		xt->use_shm = 0;
+	}
+#endif
+
 	xt->img = XCreateImage (xt->display, vis, depth, ZPixmap, 0, NULL, w, h, 8, 0);
 	xt->img_buf = malloc (xt->img->bytes_per_line * h);
 	xt->img->data = (char *) xt->img_buf;
 
+	xt_image_get_format (xt);
+
 	return (0);
 }
 
@@ -341,34 +549,50 @@ int xt_image_alloc (xterm_t *xt, unsigned w, unsigned h)
 static
 void xt_image_free (xterm_t *xt)
 {
+	if (xt->img == NULL) {
+		return;
+	}
+
+#ifdef PCE_ENABLE_X11_SHM
+	if (xt->img_shm) {
+		XShmDetach (xt->display, &xt->shm_info);
+		XSync (xt->display, False);
+		shmdt (xt->shm_info.shmaddr);
+		xt->img->data = NULL;
+		xt->img_shm = 0;
+	}
+#endif
+
 	XDestroyImage (xt->img);
 
-	xt->img = None;
+	xt->img = NULL;
 	xt->img_buf = NULL;
 }
 
 /*
- * Decode a bit mask into the first set bit and the number of set bits
+ * Send a rectangle of the backing image to the window
  */
 static
-void xt_decode_mask (unsigned long mask, unsigned *i, unsigned *n)
+void xt_image_put (xterm_t *xt, int x, int y, unsigned w, unsigned h)
 {
-	*i = 0;
-	*n = 0;
-
-	if (mask == 0) {
+	if (xt->img == NULL) {
 		return;
 	}
 
-	while ((mask & 1) == 0) {
-		mask = mask >> 1;
-		*i += 1;
-	}
+#ifdef PCE_ENABLE_X11_SHM
+	if (xt->img_shm) {
+		XShmPutImage (xt->display, xt->wdw, xt->gc, xt->img,
+			x, y, x, y, w, h, False
+		);
 
-	while (mask & 1) {
-		mask = mask >> 1;
-		*n += 1;
+		/* wait until the server has read the shared buffer */
+		XSync (xt->display, False);
+
+		return;
 	}
+#endif
+
+	XPutImage (xt->display, xt->wdw, xt->gc, xt->img, x, y, x, y, w, h);
 }
 
 static inline
@@ -392,8 +616,90 @@ unsigned long xt_get_pixel (const unsigned char *src,
 	return (val);
 }
 
+/*
+ * Convert one line of RGB pixels to B G R X
+ */
+static
+void xt_draw_line_bgrx (unsigned char *dst, const unsigned char *src, unsigned w)
+{
+	while (w >= 4) {
+		dst[0] = src[2];
+		dst[1] = src[1];
+		dst[2] = src[0];
+		dst[3] = 0;
+		dst[4] = src[5];
+		dst[5] = src[4];
+		dst[6] = src[3];
+		dst[7] = 0;
+		dst[8] = src[8];
+		dst[9] = src[7];
+		dst[10] = src[6];
+		dst[11] = 0;
+		dst[12] = src[11];
+		dst[13] = src[10];
+		dst[14] = src[9];
+		dst[15] = 0;
+
+		src += 12;
+		dst += 16;
+		w -= 4;
+	}
+
+	while (w > 0) {
+		dst[0] = src[2];
+		dst[1] = src[1];
+		dst[2] = src[0];
+		dst[3] = 0;
+
+		src += 3;
+		dst += 4;
+		w -= 1;
+	}
+}
+
+/*
+ * Convert one line of RGB pixels to 8 bit channels at arbitrary byte
+ * offsets within a pixel of bpp bytes
+ */
+static
+void xt_draw_line_byte (unsigned char *dst, const unsigned char *src, unsigned w,
+	const unsigned *ofs, unsigned bpp)
+{
+	unsigned ro, go, bo;
+
+	ro = ofs[0];
+	go = ofs[1];
+	bo = ofs[2];
+
+	if (bpp == 4) {
+		while (w > 0) {
+			dst[ofs[3]] = 0;
+			dst[ro] = src[0];
+			dst[go] = src[1];
+			dst[bo] = src[2];
+
+			src += 3;
+			dst += 4;
+			w -= 1;
+		}
+	}
+	else {
+		while (w > 0) {
+			dst[ro] = src[0];
+			dst[go] = src[1];
+			dst[bo] = src[2];
+
+			src += 3;
+			dst += 3;
+			w -= 1;
+		}
+	}
+}
+
 /*
  * Render the terminal buffer into the backing image
+ *
+ * src is the (scaled) terminal buffer with the same width as the image.
  */
 static
 void xt_image_draw (xterm_t *xt, const unsigned char *src, unsigned x, unsigned y, unsigned w, unsigned h)
@@ -403,17 +709,45 @@ void xt_image_draw (xterm_t *xt, const unsigned char *src, unsigned x, unsigned
 	unsigned      si, di;
 	unsigned      ri, rn, gi, gn, bi, bn;
 	unsigned      bpp;
-	unsigned long val;
+	unsigned long val, sw;
 
-	src = src + 3 * w * y;
-	dst = xt->img_buf + xt->img->bytes_per_line * y;
+	if (xt->img == NULL) {
+		return;
+	}
+
+	sw = 3UL * xt->img->width;
 
-	xt_decode_mask (xt->img->red_mask, &ri, &rn);
-	xt_decode_mask (xt->img->green_mask, &gi, &gn);
-	xt_decode_mask (xt->img->blue_mask, &bi, &bn);
+	src = src + sw * y;
+	dst = xt->img_buf + xt->img->bytes_per_line * y;
 
 	bpp = xt->img->bits_per_pixel / 8;
 
+	switch (xt->img_fmt) {
+	case XT_FMT_BGRX:
+		for (j = 0; j < h; j++) {
+			xt_draw_line_bgrx (dst + 4 * x, src + 3 * x, w);
+			src += sw;
+			dst += xt->img->bytes_per_line;
+		}
+		return;
+
+	case XT_FMT_BYTE32:
+	case XT_FMT_BYTE24:
+		for (j = 0; j < h; j++) {
+			xt_draw_line_byte (dst + bpp * x, src + 3 * x, w, xt->img_ofs, bpp);
+			src += sw;
+			dst += xt->img->bytes_per_line;
+		}
+		return;
+	}
+
+	ri = xt->img_shift[0];
+	rn = xt->img_shift[1];
+	gi = xt->img_shift[2];
+	gn = xt->img_shift[3];
+	bi = xt->img_shift[4];
+	bn = xt->img_shift[5];
+
 	for (j = 0; j < h; j++) {
 		si = 3 * x;
 		di = bpp * x;
@@ -422,7 +756,7 @@ void xt_image_draw (xterm_t *xt, const unsigned char *src, unsigned x, unsigned
 		case ((1 << 1) | 0):
 		case ((1 << 1) | 1):
 			for (i = 0; i < w; i++) {
-				dst[di] = src[1];
+				dst[di] = src[si + 1];
 				si += 3;
 				di += 1;
 			}
@@ -529,7 +863,7 @@ void xt_image_draw (xterm_t *xt, const unsigned char *src, unsigned x, unsigned
 			break;
 		}
 
-		src += 3 * w;
+		src += sw;
 		dst += xt->img->bytes_per_line;
 	}
 }
@@ -593,7 +927,7 @@ void xt_update (xterm_t *xt)
 
 	xt_image_draw (xt, buf, ux, uy, uw, uh);
 
-	XPutImage (xt->display, xt->wdw, xt->gc, xt->img, ux, uy, ux, uy, uw, uh);
+	xt_image_put (xt, ux, uy, uw, uh);
 }
 
 /*
@@ -684,9 +1018,7 @@ void xt_event_expose (xterm_t *xt, XEvent *event)
 
 	evt = (XExposeEvent *) event;
 
-	XPutImage (xt->display, xt->wdw, xt->gc, xt->img,
-		evt->x, evt->y, evt->x, evt->y, evt->width, evt->height
-	);
+	xt_image_put (xt, evt->x, evt->y, evt->width, evt->height);
 }
 
 static
@@ -1003,6 +1335,8 @@ void xt_init (xterm_t *xt, ini_sct_t *sct)
 	xt->gc = None;
 	xt->img = NULL;
 	xt->img_buf = NULL;
+	xt->img_fmt = 0;
+	xt->img_shm = 0;
 
 	xt->empty_cursor = None;
 
@@ -1018,6 +1352,9 @@ void xt_init (xterm_t *xt, ini_sct_t *sct)
 	ini_get_bool (sct, "report_keys", &rep, 0);
 	xt->report_keys = (rep != 0);
 
+	ini_get_bool (sct, "shm", &rep, 1);
+	xt->use_shm = (rep != 0);
+
 	xt_init_keymap_default (xt);
 	xt_init_keymap_user (xt, sct);
 }
@@ -32,6 +32,10 @@
 #include <X11/Xatom.h>
 #include <X11/keysym.h>
 
+#ifdef PCE_ENABLE_X11_SHM
+#include <X11/extensions/XShm.h>
+#endif
+
 #include <drivers/video/terminal.h>
 
 #include <libini/libini.h>
@@ -67,6 +71,17 @@ typedef struct {
 	XImage        *img;
 	unsigned char *img_buf;
 
+	/* the image pixel format, see xt_image_get_format() */
+	unsigned      img_fmt;
+	unsigned      img_ofs[4];
+	unsigned      img_shift[6];
+
+	char          use_shm;
+	char          img_shm;
+#ifdef PCE_ENABLE_X11_SHM
+	XShmSegmentInfo shm_info;
+#endif
+
 	Cursor        empty_cursor;
 
 	unsigned      wdw_w;
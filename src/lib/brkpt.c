@@ -251,6 +251,13 @@ void bps_init (bp_set_t *bps)
 {
 	bps->cnt = 0;
 	bps->bp = NULL;
+
+	bps->hash_size = 0;
+	bps->hash = NULL;
+	bps->next = NULL;
+
+	bps->other_cnt = 0;
+	bps->other = NULL;
 }
 
 void bps_free (bp_set_t *bps)
@@ -262,6 +269,95 @@ void bps_free (bp_set_t *bps)
 	}
 
 	free (bps->bp);
+	free (bps->hash);
+	free (bps->next);
+}
+
+static
+int bps_is_hashed (const breakpoint_t *bp)
+{
+	return ((bp->type == BP_TYPE_ADDR) || (bp->type == BP_TYPE_SEGOFS));
+}
+
+static
+unsigned bps_hash (const bp_set_t *bps, unsigned seg, unsigned long addr)
+{
+	addr += (unsigned long) seg << 4;
+	addr ^= addr >> 13;
+	addr *= 0x9e3779b1UL;
+
+	return ((addr >> 8) & (bps->hash_size - 1));
+}
+
+/*
+ * Rebuild the address hash after the breakpoint list has changed
+ *
+ * Each bucket is a chain of breakpoint indices in list order. The
+ * other breakpoints are kept in a separate list, also in list order.
+ */
+static
+void bps_hash_rebuild (bp_set_t *bps)
+{
+	unsigned     i, h, n, size;
+	unsigned     *tmp;
+	breakpoint_t *bp;
+
+	size = 64;
+
+	while (size < (2 * bps->cnt)) {
+		size *= 2;
+	}
+
+	if (size != bps->hash_size) {
+		if ((tmp = realloc (bps->hash, size * sizeof (unsigned))) == NULL) {
+			goto error;
+		}
+
+		bps->hash = tmp;
+		bps->hash_size = size;
+	}
+
+	if ((tmp = realloc (bps->next, (2 * bps->cnt + 1) * sizeof (unsigned))) == NULL) {
+		goto error;
+	}
+
+	bps->next = tmp;
+	bps->other = tmp + bps->cnt;
+
+	for (i = 0; i < bps->hash_size; i++) {
+		bps->hash[i] = 0;
+	}
+
+	i = bps->cnt;
+
+	while (i > 0) {
+		i -= 1;
+
+		bp = bps->bp[i];
+
+		if (bps_is_hashed (bp)) {
+			h = bps_hash (bps, bp->seg, bp->addr);
+			bps->next[i] = bps->hash[h];
+			bps->hash[h] = i + 1;
+		}
+	}
+
+	n = 0;
+
+	for (i = 0; i < bps->cnt; i++) {
+		if (bps_is_hashed (bps->bp[i]) == 0) {
+			bps->other[n++] = i;
+		}
+	}
+
+	bps->other_cnt = n;
+
+	return;
+
+error:
+	free (bps->hash);
+	bps->hash = NULL;
+	bps->hash_size = 0;
 }
 
 int bps_bp_add (bp_set_t *bps, breakpoint_t *bp)
@@ -277,6 +373,8 @@ int bps_bp_add (bp_set_t *bps, breakpoint_t *bp)
 	bps->bp[bps->cnt] = bp;
 	bps->cnt += 1;
 
+	bps_hash_rebuild (bps);
+
 	return (0);
 }
 
@@ -304,6 +402,8 @@ void bps_bp_del_index (bp_set_t *bps, unsigned idx)
 	}
 
 	bps->cnt -= 1;
+
+	bps_hash_rebuild (bps);
 }
 
 void bps_bp_del (bp_set_t *bps, breakpoint_t *bp)
@@ -327,9 +427,18 @@ void bps_bp_del_all (bp_set_t *bps)
 	}
 
 	free (bps->bp);
+	free (bps->hash);
+	free (bps->next);
 
 	bps->cnt = 0;
 	bps->bp = NULL;
+
+	bps->hash_size = 0;
+	bps->hash = NULL;
+	bps->next = NULL;
+
+	bps->other_cnt = 0;
+	bps->other = NULL;
 }
 
 void bps_list (bp_set_t *bps, FILE *fp)
@@ -346,11 +455,42 @@ void bps_list (bp_set_t *bps, FILE *fp)
 
 breakpoint_t *bps_match (bp_set_t *bps, unsigned seg, unsigned long addr)
 {
-	unsigned i;
+	unsigned     i, j, h, idx;
+	breakpoint_t *bp;
 
-	for (i = 0; i < bps->cnt; i++) {
-		if (bp_match (bps->bp[i], seg, addr)) {
-			return (bps->bp[i]);
+	if (bps->cnt == 0) {
+		return (NULL);
+	}
+
+	if (bps->hash == NULL) {
+		for (i = 0; i < bps->cnt; i++) {
+			if (bp_match (bps->bp[i], seg, addr)) {
+				return (bps->bp[i]);
+			}
+		}
+
+		return (NULL);
+	}
+
+	h = bps_hash (bps, seg, addr);
+
+	i = bps->hash[h];
+	j = 0;
+
+	/* merge the hash chain and the other breakpoints in list order */
+	while ((i > 0) || (j < bps->other_cnt)) {
+		if ((j < bps->other_cnt) && ((i == 0) || (bps->other[j] < (i - 1)))) {
+			idx = bps->other[j++];
+		}
+		else {
+			idx = i - 1;
+			i = bps->next[idx];
+		}
+
+		bp = bps->bp[idx];
+
+		if (bp_match (bp, seg, addr)) {
+			return (bp);
 		}
 	}
 
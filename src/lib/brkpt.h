@@ -54,8 +54,21 @@ typedef struct breakpoint_t {
 
 /* a set of breakpoints */
 typedef struct {
-	unsigned     cnt;
-	breakpoint_t **bp;
+	unsigned      cnt;
+	breakpoint_t  **bp;
+
+	/*
+	 * The address and segment:offset breakpoints, hashed by linear
+	 * address. Each entry is a breakpoint index plus one, chained
+	 * through next[], or 0 for the end of a chain.
+	 */
+	unsigned      hash_size;
+	unsigned      *hash;
+	unsigned      *next;
+
+	/* the indices of all other breakpoints */
+	unsigned      other_cnt;
+	unsigned      *other;
 } bp_set_t;
 
 
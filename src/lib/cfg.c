@@ -27,6 +27,14 @@
 #include <libini/libini.h>
 
 
+static const char *par_cache = NULL;
+
+
+void pce_set_config_cache (const char *fname)
+{
+	par_cache = fname;
+}
+
 int pce_load_config (ini_sct_t *ini, const char *fname)
 {
 	if (fname == NULL) {
@@ -35,7 +43,7 @@ int pce_load_config (ini_sct_t *ini, const char *fname)
 
 	pce_log_tag (MSG_INF, "CONFIG:", "file=\"%s\"\n", fname);
 
-	if (ini_read (ini, fname)) {
+	if (ini_read_cache (ini, fname, par_cache)) {
 		pce_log (MSG_ERR, "*** loading config file failed\n");
 		return (1);
 	}
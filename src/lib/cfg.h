@@ -27,6 +27,14 @@
 #include <libini/libini.h>
 
 
+/*!***************************************************************************
+ * @short Set the config cache file name
+ *
+ * If a cache file name is set, pce_load_config() reads the config
+ * from the cache file if it is up to date and rewrites it otherwise.
+ *****************************************************************************/
+void pce_set_config_cache (const char *fname);
+
 int pce_load_config (ini_sct_t *ini, const char *fname);
 
 
@@ -0,0 +1,501 @@
+/*****************************************************************************
+ * pce                                                                       *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * File name:   src/lib/cover.c                                              *
+ * Created:     2026-10-19 by agent <agent@local>                            *
+ * Copyright:   (C) 2026 agent <agent@local>                                 *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * This program is free software. You can redistribute it and / or modify it *
+ * under the terms of the GNU General Public License version 2 as  published *
+ * by the Free Software Foundation.                                          *
+ *                                                                           *
+ * This program is distributed in the hope  that  it  will  be  useful,  but *
+ * WITHOUT  ANY   WARRANTY,   without   even   the   implied   warranty   of *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU  General *
+ * Public License for more details.                                          *
+ *****************************************************************************/
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cover.h"
+#include "ihex.h"
+#include "srec.h"
+
+
+#define COVER_NONE 0xffffffffUL
+
+#define COVER_FMT_BIN  0
+#define COVER_FMT_IHEX 1
+#define COVER_FMT_SREC 2
+#define COVER_FMT_LCOV 3
+
+
+static
+unsigned long cover_hash (unsigned long base)
+{
+	unsigned long h;
+
+	h = (base / COVER_PAGE_SIZE) & 0xffffffffUL;
+	h = (h ^ (h >> 15)) * 0x2c1b3c6dUL;
+	h = (h ^ (h >> 12)) & 0xffffffffUL;
+
+	return (h);
+}
+
+
+void cover_init (cover_t *cov)
+{
+	cov->enabled = 0;
+
+	cov->page_cnt = 0;
+	cov->page_max = 0;
+	cov->page = NULL;
+
+	cov->hash_max = 0;
+	cov->hash = NULL;
+
+	cov->last = NULL;
+}
+
+void cover_free (cover_t *cov)
+{
+	unsigned long i;
+
+	for (i = 0; i < cov->page_cnt; i++) {
+		free (cov->page[i]);
+	}
+
+	free (cov->page);
+	free (cov->hash);
+
+	cov->page = NULL;
+	cov->hash = NULL;
+	cov->last = NULL;
+}
+
+void cover_clear (cover_t *cov)
+{
+	cover_free (cov);
+
+	cov->page_cnt = 0;
+	cov->page_max = 0;
+	cov->hash_max = 0;
+}
+
+static
+int cover_grow (cover_t *cov)
+{
+	unsigned long i, j, max;
+	unsigned long *hash;
+	cover_page_t  **page;
+
+	max = (cov->page_max < 16) ? 16 : (2 * cov->page_max);
+
+	hash = malloc (2 * max * sizeof (unsigned long));
+
+	if (hash == NULL) {
+		return (1);
+	}
+
+	page = realloc (cov->page, max * sizeof (cover_page_t *));
+
+	if (page == NULL) {
+		free (hash);
+		return (1);
+	}
+
+	cov->page = page;
+
+	for (i = 0; i < 2 * max; i++) {
+		hash[i] = COVER_NONE;
+	}
+
+	for (i = 0; i < cov->page_cnt; i++) {
+		j = cover_hash (cov->page[i]->base) & (2 * max - 1);
+
+		while (hash[j] != COVER_NONE) {
+			j = (j + 1) & (2 * max - 1);
+		}
+
+		hash[j] = i;
+	}
+
+	free (cov->hash);
+
+	cov->page_max = max;
+	cov->hash = hash;
+	cov->hash_max = 2 * max;
+
+	return (0);
+}
+
+/*
+ * Get the page containing addr, optionally creating it
+ */
+static
+cover_page_t *cover_get_page (cover_t *cov, unsigned long addr, int create)
+{
+	unsigned long i, base;
+	cover_page_t  *pg;
+
+	base = addr & ~(unsigned long) (COVER_PAGE_SIZE - 1);
+
+	if (cov->hash != NULL) {
+		i = cover_hash (base) & (cov->hash_max - 1);
+
+		while (cov->hash[i] != COVER_NONE) {
+			pg = cov->page[cov->hash[i]];
+
+			if (pg->base == base) {
+				return (pg);
+			}
+
+			i = (i + 1) & (cov->hash_max - 1);
+		}
+	}
+
+	if (create == 0) {
+		return (NULL);
+	}
+
+	if ((cov->hash == NULL) || (cov->page_cnt >= cov->page_max)) {
+		if (cover_grow (cov)) {
+			return (NULL);
+		}
+
+		i = cover_hash (base) & (cov->hash_max - 1);
+
+		while (cov->hash[i] != COVER_NONE) {
+			i = (i + 1) & (cov->hash_max - 1);
+		}
+	}
+
+	pg = malloc (sizeof (cover_page_t));
+
+	if (pg == NULL) {
+		return (NULL);
+	}
+
+	pg->base = base;
+	pg->cnt = 0;
+
+	memset (pg->map, 0, sizeof (pg->map));
+
+	cov->hash[i] = cov->page_cnt;
+	cov->page[cov->page_cnt++] = pg;
+
+	return (pg);
+}
+
+void cover_add (cover_t *cov, unsigned long addr)
+{
+	unsigned      ofs, msk;
+	cover_page_t  *pg;
+
+	pg = cov->last;
+
+	if ((pg == NULL) || ((addr - pg->base) >= COVER_PAGE_SIZE)) {
+		if ((pg = cover_get_page (cov, addr, 1)) == NULL) {
+			return;
+		}
+
+		cov->last = pg;
+	}
+
+	ofs = addr - pg->base;
+	msk = 1U << (ofs & 7);
+
+	if ((pg->map[ofs >> 3] & msk) == 0) {
+		pg->map[ofs >> 3] |= msk;
+		pg->cnt += 1;
+	}
+}
+
+int cover_get (cover_t *cov, unsigned long addr)
+{
+	unsigned      ofs;
+	cover_page_t  *pg;
+
+	if ((pg = cover_get_page (cov, addr, 0)) == NULL) {
+		return (0);
+	}
+
+	ofs = addr - pg->base;
+
+	return ((pg->map[ofs >> 3] >> (ofs & 7)) & 1);
+}
+
+unsigned long cover_get_count (const cover_t *cov)
+{
+	unsigned long i, cnt;
+
+	cnt = 0;
+
+	for (i = 0; i < cov->page_cnt; i++) {
+		cnt += cov->page[i]->cnt;
+	}
+
+	return (cnt);
+}
+
+static
+int cover_cmp_base (const void *p1, const void *p2)
+{
+	const cover_page_t *pg1, *pg2;
+
+	pg1 = *(const cover_page_t **) p1;
+	pg2 = *(const cover_page_t **) p2;
+
+	if (pg1->base < pg2->base) {
+		return (-1);
+	}
+	else if (pg1->base > pg2->base) {
+		return (1);
+	}
+
+	return (0);
+}
+
+/*
+ * Get the pages sorted by address
+ */
+static
+cover_page_t **cover_get_sorted (cover_t *cov)
+{
+	cover_page_t **page;
+
+	page = malloc ((cov->page_cnt + 1) * sizeof (cover_page_t *));
+
+	if (page == NULL) {
+		return (NULL);
+	}
+
+	if (cov->page_cnt > 0) {
+		memcpy (page, cov->page, cov->page_cnt * sizeof (cover_page_t *));
+		qsort (page, cov->page_cnt, sizeof (cover_page_t *), cover_cmp_base);
+	}
+
+	return (page);
+}
+
+void cover_print (cover_t *cov, FILE *fp)
+{
+	unsigned long i;
+	cover_page_t  **page;
+
+	if ((page = cover_get_sorted (cov)) == NULL) {
+		return;
+	}
+
+	fprintf (fp, "PAGE      COUNT\n");
+
+	for (i = 0; i < cov->page_cnt; i++) {
+		fprintf (fp, "%08lX  %5lu\n", page[i]->base, page[i]->cnt);
+	}
+
+	fprintf (fp, "%lu addresses in %lu pages\n",
+		cover_get_count (cov), cov->page_cnt
+	);
+
+	free (page);
+}
+
+static
+unsigned char cover_get_byte (void *ext, unsigned long addr)
+{
+	return (cover_get (ext, addr));
+}
+
+static
+void cover_save_hex (cover_t *cov, cover_page_t **page, FILE *fp, int fmt)
+{
+	unsigned long i, j;
+
+	i = 0;
+
+	while (i < cov->page_cnt) {
+		/* save contiguous pages in one run */
+		j = i + 1;
+
+		while ((j < cov->page_cnt) && (page[j]->base == (page[j - 1]->base + COVER_PAGE_SIZE))) {
+			j += 1;
+		}
+
+		if (fmt == COVER_FMT_IHEX) {
+			ihex_save_linear (fp, page[i]->base, (j - i) * COVER_PAGE_SIZE,
+				cov, cover_get_byte
+			);
+		}
+		else {
+			srec_save (fp, page[i]->base, (j - i) * COVER_PAGE_SIZE,
+				cov, cover_get_byte
+			);
+		}
+
+		i = j;
+	}
+}
+
+static
+void cover_save_lcov (cover_t *cov, cover_page_t **page, FILE *fp, const char *name)
+{
+	unsigned long i, j;
+
+	fprintf (fp, "TN:\nSF:%s\n", name);
+
+	for (i = 0; i < cov->page_cnt; i++) {
+		for (j = 0; j < COVER_PAGE_SIZE; j++) {
+			if (page[i]->map[j >> 3] & (1U << (j & 7))) {
+				fprintf (fp, "DA:%lu,1\n", page[i]->base + j);
+			}
+		}
+	}
+
+	fprintf (fp, "LH:%lu\nLF:%lu\nend_of_record\n",
+		cover_get_count (cov), cover_get_count (cov)
+	);
+}
+
+static
+void cover_save_bin (cover_t *cov, cover_page_t **page, FILE *fp)
+{
+	unsigned long i;
+	unsigned char buf[4];
+
+	for (i = 0; i < cov->page_cnt; i++) {
+		buf[0] = (page[i]->base >> 24) & 0xff;
+		buf[1] = (page[i]->base >> 16) & 0xff;
+		buf[2] = (page[i]->base >> 8) & 0xff;
+		buf[3] = page[i]->base & 0xff;
+
+		fwrite (buf, 1, 4, fp);
+		fwrite (page[i]->map, 1, COVER_PAGE_SIZE / 8, fp);
+	}
+}
+
+static
+int cover_get_format (const char *fname)
+{
+	const char *ext;
+
+	if ((ext = strrchr (fname, '.')) == NULL) {
+		return (COVER_FMT_BIN);
+	}
+
+	if ((strcmp (ext, ".ihex") == 0) || (strcmp (ext, ".hex") == 0)) {
+		return (COVER_FMT_IHEX);
+	}
+	else if (strcmp (ext, ".srec") == 0) {
+		return (COVER_FMT_SREC);
+	}
+	else if ((strcmp (ext, ".info") == 0) || (strcmp (ext, ".lcov") == 0)) {
+		return (COVER_FMT_LCOV);
+	}
+
+	return (COVER_FMT_BIN);
+}
+
+int cover_save (cover_t *cov, const char *fname)
+{
+	int          fmt;
+	FILE         *fp;
+	cover_page_t **page;
+
+	fmt = cover_get_format (fname);
+
+	if ((page = cover_get_sorted (cov)) == NULL) {
+		return (1);
+	}
+
+	fp = fopen (fname, (fmt == COVER_FMT_BIN) ? "wb" : "w");
+
+	if (fp == NULL) {
+		free (page);
+		return (1);
+	}
+
+	switch (fmt) {
+	case COVER_FMT_IHEX:
+		cover_save_hex (cov, page, fp, fmt);
+		ihex_save_done (fp);
+		break;
+
+	case COVER_FMT_SREC:
+		srec_save_start (fp, "coverage");
+		cover_save_hex (cov, page, fp, fmt);
+		srec_save_done (fp);
+		break;
+
+	case COVER_FMT_LCOV:
+		cover_save_lcov (cov, page, fp, "guest");
+		break;
+
+	default:
+		cover_save_bin (cov, page, fp);
+		break;
+	}
+
+	fclose (fp);
+
+	free (page);
+
+	return (0);
+}
+
+void cover_cmd (cmd_t *cmd, cover_t *cov)
+{
+	char fname[256];
+
+	if (cmd_match_eol (cmd)) {
+		printf ("coverage is %s, %lu addresses in %lu pages\n",
+			cov->enabled ? "on" : "off",
+			cover_get_count (cov), cov->page_cnt
+		);
+		return;
+	}
+
+	if (cmd_match (cmd, "on")) {
+		if (cmd_match_end (cmd)) {
+			cov->enabled = 1;
+		}
+	}
+	else if (cmd_match (cmd, "off")) {
+		if (cmd_match_end (cmd)) {
+			cov->enabled = 0;
+		}
+	}
+	else if (cmd_match (cmd, "clear")) {
+		if (cmd_match_end (cmd)) {
+			cover_clear (cov);
+		}
+	}
+	else if (cmd_match (cmd, "list")) {
+		if (cmd_match_end (cmd)) {
+			cover_print (cov, stdout);
+		}
+	}
+	else if (cmd_match (cmd, "save")) {
+		if (!cmd_match_str (cmd, fname, 256)) {
+			cmd_error (cmd, "expecting a file name");
+			return;
+		}
+
+		if (!cmd_match_end (cmd)) {
+			return;
+		}
+
+		if (cover_save (cov, fname)) {
+			printf ("writing coverage failed (%s)\n", fname);
+		}
+	}
+	else {
+		cmd_error (cmd, "cover: unknown command");
+	}
+}
@@ -0,0 +1,109 @@
+/*****************************************************************************
+ * pce                                                                       *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * File name:   src/lib/cover.h                                              *
+ * Created:     2026-10-19 by agent <agent@local>                            *
+ * Copyright:   (C) 2026 agent <agent@local>                                 *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * This program is free software. You can redistribute it and / or modify it *
+ * under the terms of the GNU General Public License version 2 as  published *
+ * by the Free Software Foundation.                                          *
+ *                                                                           *
+ * This program is distributed in the hope  that  it  will  be  useful,  but *
+ * WITHOUT  ANY   WARRANTY,   without   even   the   implied   warranty   of *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU  General *
+ * Public License for more details.                                          *
+ *****************************************************************************/
+
+
+#ifndef PCE_LIB_COVER_H
+#define PCE_LIB_COVER_H 1
+
+
+#include <stdio.h>
+
+#include <lib/cmd.h>
+
+
+#define COVER_PAGE_SIZE 4096
+
+
+/* the coverage bitmap of one page of guest memory */
+typedef struct {
+	unsigned long base;
+	unsigned long cnt;
+	unsigned char map[COVER_PAGE_SIZE / 8];
+} cover_page_t;
+
+
+typedef struct {
+	char          enabled;
+
+	unsigned long page_cnt;
+	unsigned long page_max;
+	cover_page_t  **page;
+
+	unsigned long hash_max;
+	unsigned long *hash;
+
+	/* the most recently used page */
+	cover_page_t  *last;
+} cover_t;
+
+
+void cover_init (cover_t *cov);
+void cover_free (cover_t *cov);
+
+/*!***************************************************************************
+ * @short Discard all coverage data
+ *****************************************************************************/
+void cover_clear (cover_t *cov);
+
+/*!***************************************************************************
+ * @short Mark an address as executed
+ *****************************************************************************/
+void cover_add (cover_t *cov, unsigned long addr);
+
+/*!***************************************************************************
+ * @short Check if an address was executed
+ *****************************************************************************/
+int cover_get (cover_t *cov, unsigned long addr);
+
+/*!***************************************************************************
+ * @short Get the number of executed addresses
+ *****************************************************************************/
+unsigned long cover_get_count (const cover_t *cov);
+
+/*!***************************************************************************
+ * @short Print the number of executed addresses in each page
+ *****************************************************************************/
+void cover_print (cover_t *cov, FILE *fp);
+
+/*!***************************************************************************
+ * @short Save the coverage data to a file
+ *
+ * The file format is selected by the file name extension:
+ *
+ * .ihex, .hex  Intel hex, one byte per address in each executed page,
+ *              1 if the address was executed and 0 otherwise
+ * .srec        Motorola S-records, in the same layout as ihex
+ * .info, .lcov An lcov tracefile, using the address as the line number
+ *
+ * Any other file name selects the binary format. For each executed
+ * page, the binary format contains the 32 bit big endian page address,
+ * followed by COVER_PAGE_SIZE / 8 bytes of bitmap, lowest address in
+ * the least significant bit.
+ *****************************************************************************/
+int cover_save (cover_t *cov, const char *fname);
+
+/*!***************************************************************************
+ * @short Handle the cover monitor command
+ *****************************************************************************/
+void cover_cmd (cmd_t *cmd, cover_t *cov);
+
+
+#endif
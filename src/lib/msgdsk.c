@@ -38,6 +38,7 @@ void msg_dsk_print_help (void)
 {
 	pce_puts (
 		"disk.commit          [<id>]\n"
+		"disk.compact         [<id>]\n"
 		"disk.eject           [<id>]\n"
 		"disk.id              [<id>]\n"
 		"disk.insert          <filename>\n"
@@ -132,6 +133,22 @@ int msg_dsk_emu_disk_commit (const char *val, disks_t *dsks, unsigned *id)
 	return (0);
 }
 
+int msg_dsk_emu_disk_compact (const char *val, disks_t *dsks, unsigned *id)
+{
+	if (msg_dsk_get_disk_id (val, id)) {
+		return (1);
+	}
+
+	pce_log (MSG_INF, "compacting disk %u\n", *id);
+
+	if (dsks_set_msg (dsks, *id, "compact", NULL)) {
+		pce_log (MSG_ERR, "*** disk %u compact error\n", *id);
+		return (1);
+	}
+
+	return (0);
+}
+
 int msg_dsk_emu_disk_eject (const char *val, disks_t *dsks, unsigned *id)
 {
 	disk_t *dsk;
@@ -250,6 +267,9 @@ int msg_dsk_set_msg (const char *msg, const char *val, disks_t *dsks, unsigned *
 	if (msg_is_message ("disk.commit", msg)) {
 		return (msg_dsk_emu_disk_commit (val, dsks, id));
 	}
+	else if (msg_is_message ("disk.compact", msg)) {
+		return (msg_dsk_emu_disk_compact (val, dsks, id));
+	}
 	else if (msg_is_message ("disk.eject", msg)) {
 		return (msg_dsk_emu_disk_eject (val, dsks, id));
 	}
@@ -33,6 +33,7 @@ void dsks_print_info (disks_t *dsks);
 int msg_dsk_get_disk_id (const char *val, unsigned *id);
 
 int msg_dsk_emu_disk_commit (const char *val, disks_t *dsks, unsigned *id);
+int msg_dsk_emu_disk_compact (const char *val, disks_t *dsks, unsigned *id);
 int msg_dsk_emu_disk_eject (const char *val, disks_t *dsks, unsigned *id);
 int msg_dsk_emu_disk_id (const char *val, unsigned *id);
 int msg_dsk_emu_disk_insert (const char *val, disks_t *dsks, unsigned id);
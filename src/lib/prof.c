@@ -0,0 +1,698 @@
+/*****************************************************************************
+ * pce                                                                       *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * File name:   src/lib/prof.c                                               *
+ * Created:     2026-10-19 by agent <agent@local>                            *
+ * Copyright:   (C) 2026 agent <agent@local>                                 *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * This program is free software. You can redistribute it and / or modify it *
+ * under the terms of the GNU General Public License version 2 as  published *
+ * by the Free Software Foundation.                                          *
+ *                                                                           *
+ * This program is distributed in the hope  that  it  will  be  useful,  but *
+ * WITHOUT  ANY   WARRANTY,   without   even   the   implied   warranty   of *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU  General *
+ * Public License for more details.                                          *
+ *****************************************************************************/
+
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cmd.h"
+#include "prof.h"
+
+
+#define PROF_NONE 0xffffffffUL
+
+
+static
+unsigned long prof_hash (unsigned long node, unsigned long addr)
+{
+	unsigned long h;
+
+	h = (addr ^ (node * 0x9e3779b1UL)) & 0xffffffffUL;
+	h = (h ^ (h >> 15)) * 0x2c1b3c6dUL;
+	h = (h ^ (h >> 12)) & 0xffffffffUL;
+
+	return (h);
+}
+
+
+void prof_init (prof_t *prof)
+{
+	prof->enabled = 0;
+	prof->stack = 0;
+
+	prof->node_cnt = 0;
+	prof->node_max = 0;
+	prof->node = NULL;
+
+	prof->hash_max = 0;
+	prof->hash = NULL;
+
+	prof->ent_cnt = 0;
+	prof->ent_max = 0;
+	prof->ent = NULL;
+
+	prof->cur = 0;
+	prof->skip = 0;
+	prof->call = 0;
+
+	prof->total_cnt = 0;
+	prof->total_clk = 0;
+}
+
+void prof_free (prof_t *prof)
+{
+	free (prof->ent);
+	free (prof->hash);
+	free (prof->node);
+
+	prof->ent = NULL;
+	prof->hash = NULL;
+	prof->node = NULL;
+}
+
+void prof_clear (prof_t *prof)
+{
+	prof_free (prof);
+
+	prof->node_cnt = 0;
+	prof->node_max = 0;
+	prof->hash_max = 0;
+	prof->ent_cnt = 0;
+	prof->ent_max = 0;
+
+	prof->cur = 0;
+	prof->skip = 0;
+	prof->call = 0;
+
+	prof->total_cnt = 0;
+	prof->total_clk = 0;
+}
+
+void prof_set_enabled (prof_t *prof, int val)
+{
+	prof->enabled = (val != 0);
+}
+
+/*
+ * Create the root node of the call tree
+ */
+static
+int prof_init_nodes (prof_t *prof)
+{
+	unsigned long i;
+
+	prof->node = malloc (256 * sizeof (prof_node_t));
+	prof->hash = malloc (512 * sizeof (unsigned long));
+
+	if ((prof->node == NULL) || (prof->hash == NULL)) {
+		free (prof->node);
+		free (prof->hash);
+		prof->node = NULL;
+		prof->hash = NULL;
+		return (1);
+	}
+
+	prof->node_max = 256;
+	prof->hash_max = 512;
+
+	for (i = 0; i < prof->hash_max; i++) {
+		prof->hash[i] = PROF_NONE;
+	}
+
+	prof->node[0].parent = PROF_NONE;
+	prof->node[0].addr = 0;
+	prof->node[0].depth = 0;
+
+	prof->node_cnt = 1;
+	prof->cur = 0;
+
+	return (0);
+}
+
+static
+int prof_grow_nodes (prof_t *prof)
+{
+	unsigned long i, j, max;
+	unsigned long *hash;
+	prof_node_t   *node;
+	prof_node_t   *nd;
+
+	max = 2 * prof->node_max;
+
+	hash = malloc (2 * max * sizeof (unsigned long));
+
+	if (hash == NULL) {
+		return (1);
+	}
+
+	node = realloc (prof->node, max * sizeof (prof_node_t));
+
+	if (node == NULL) {
+		free (hash);
+		return (1);
+	}
+
+	prof->node = node;
+
+	for (i = 0; i < 2 * max; i++) {
+		hash[i] = PROF_NONE;
+	}
+
+	for (i = 1; i < prof->node_cnt; i++) {
+		nd = &prof->node[i];
+		j = prof_hash (nd->parent, nd->addr) & (2 * max - 1);
+
+		while (hash[j] != PROF_NONE) {
+			j = (j + 1) & (2 * max - 1);
+		}
+
+		hash[j] = i;
+	}
+
+	free (prof->hash);
+
+	prof->node_max = max;
+	prof->hash = hash;
+	prof->hash_max = 2 * max;
+
+	return (0);
+}
+
+/*
+ * Get the child of node parent for a call to addr
+ */
+static
+unsigned long prof_get_node (prof_t *prof, unsigned long parent, unsigned long addr)
+{
+	unsigned long i, idx;
+	prof_node_t   *nd;
+
+	if (prof->node == NULL) {
+		if (prof_init_nodes (prof)) {
+			return (PROF_NONE);
+		}
+	}
+
+	i = prof_hash (parent, addr) & (prof->hash_max - 1);
+
+	while (prof->hash[i] != PROF_NONE) {
+		nd = &prof->node[prof->hash[i]];
+
+		if ((nd->parent == parent) && (nd->addr == addr)) {
+			return (prof->hash[i]);
+		}
+
+		i = (i + 1) & (prof->hash_max - 1);
+	}
+
+	if (prof->node_cnt >= prof->node_max) {
+		if (prof_grow_nodes (prof)) {
+			return (PROF_NONE);
+		}
+
+		return (prof_get_node (prof, parent, addr));
+	}
+
+	idx = prof->node_cnt++;
+
+	nd = &prof->node[idx];
+	nd->parent = parent;
+	nd->addr = addr;
+	nd->depth = prof->node[parent].depth + 1;
+
+	prof->hash[i] = idx;
+
+	return (idx);
+}
+
+static
+int prof_grow_ents (prof_t *prof)
+{
+	unsigned long i, j, max;
+	prof_ent_t    *ent, *src;
+
+	max = (prof->ent_max == 0) ? 4096 : (2 * prof->ent_max);
+
+	ent = malloc (max * sizeof (prof_ent_t));
+
+	if (ent == NULL) {
+		return (1);
+	}
+
+	for (i = 0; i < max; i++) {
+		ent[i].cnt = 0;
+	}
+
+	for (i = 0; i < prof->ent_max; i++) {
+		src = &prof->ent[i];
+
+		if (src->cnt == 0) {
+			continue;
+		}
+
+		j = prof_hash (src->node, src->addr) & (max - 1);
+
+		while (ent[j].cnt != 0) {
+			j = (j + 1) & (max - 1);
+		}
+
+		ent[j] = *src;
+	}
+
+	free (prof->ent);
+
+	prof->ent = ent;
+	prof->ent_max = max;
+
+	return (0);
+}
+
+void prof_add (prof_t *prof, unsigned long addr, unsigned long clk)
+{
+	unsigned long i;
+	prof_ent_t    *ent;
+
+	if (2 * prof->ent_cnt >= prof->ent_max) {
+		if (prof_grow_ents (prof)) {
+			return;
+		}
+	}
+
+	prof->total_cnt += 1;
+	prof->total_clk += clk;
+
+	i = prof_hash (prof->cur, addr) & (prof->ent_max - 1);
+
+	while (1) {
+		ent = &prof->ent[i];
+
+		if (ent->cnt == 0) {
+			ent->node = prof->cur;
+			ent->addr = addr;
+			ent->cnt = 1;
+			ent->clk = clk;
+			prof->ent_cnt += 1;
+			return;
+		}
+
+		if ((ent->addr == addr) && (ent->node == prof->cur)) {
+			ent->cnt += 1;
+			ent->clk += clk;
+			return;
+		}
+
+		i = (i + 1) & (prof->ent_max - 1);
+	}
+}
+
+void prof_call (prof_t *prof, unsigned long addr)
+{
+	unsigned long idx;
+
+	if (prof->node == NULL) {
+		if (prof_init_nodes (prof)) {
+			return;
+		}
+	}
+
+	if ((prof->skip > 0) || (prof->node[prof->cur].depth >= PROF_DEPTH_MAX)) {
+		prof->skip += 1;
+		return;
+	}
+
+	idx = prof_get_node (prof, prof->cur, addr);
+
+	if (idx == PROF_NONE) {
+		prof->skip += 1;
+		return;
+	}
+
+	prof->cur = idx;
+}
+
+void prof_ret (prof_t *prof)
+{
+	if (prof->skip > 0) {
+		prof->skip -= 1;
+		return;
+	}
+
+	if (prof->cur != 0) {
+		prof->cur = prof->node[prof->cur].parent;
+	}
+}
+
+/*
+ * The callee address is only known when the instruction after the
+ * call is executed.
+ */
+void prof_op_e86 (prof_t *prof, unsigned long addr, unsigned op1, unsigned op2)
+{
+	if (prof->call) {
+		prof->call = 0;
+		prof_call (prof, addr);
+	}
+
+	switch (op1) {
+	case 0x9a: /* call far */
+	case 0xe8: /* call near */
+		prof->call = 1;
+		break;
+
+	case 0xff:
+		if ((op2 & 0x30) == 0x10) {
+			/* call near / far indirect */
+			prof->call = 1;
+		}
+		break;
+
+	case 0xc2: /* ret */
+	case 0xc3:
+	case 0xca: /* retf */
+	case 0xcb:
+		prof_ret (prof);
+		break;
+	}
+}
+
+void prof_op_e68 (prof_t *prof, unsigned long addr, unsigned long ir)
+{
+	if (prof->call) {
+		prof->call = 0;
+		prof_call (prof, addr);
+	}
+
+	if ((ir & 0xffc0) == 0x4e80) {
+		/* jsr */
+		prof->call = 1;
+	}
+	else if ((ir & 0xff00) == 0x6100) {
+		/* bsr */
+		prof->call = 1;
+	}
+	else if ((ir == 0x4e74) || (ir == 0x4e75) || (ir == 0x4e77)) {
+		/* rtd, rts, rtr */
+		prof_ret (prof);
+	}
+}
+
+
+static
+int prof_cmp_addr (const void *p1, const void *p2)
+{
+	const prof_ent_t *e1 = p1;
+	const prof_ent_t *e2 = p2;
+
+	if (e1->addr < e2->addr) {
+		return (-1);
+	}
+	else if (e1->addr > e2->addr) {
+		return (1);
+	}
+
+	return (0);
+}
+
+static
+int prof_cmp_clk (const void *p1, const void *p2)
+{
+	const prof_ent_t *e1 = p1;
+	const prof_ent_t *e2 = p2;
+
+	if (e1->clk > e2->clk) {
+		return (-1);
+	}
+	else if (e1->clk < e2->clk) {
+		return (1);
+	}
+	else if (e1->addr < e2->addr) {
+		return (-1);
+	}
+	else if (e1->addr > e2->addr) {
+		return (1);
+	}
+
+	return (0);
+}
+
+/*
+ * Get the histogram entries, summed over all call tree nodes if flat
+ * is true, and sorted by clock cycles
+ */
+static
+prof_ent_t *prof_get_sorted (prof_t *prof, int flat, unsigned long *cnt)
+{
+	unsigned long i, j, n;
+	prof_ent_t    *lst;
+
+	*cnt = 0;
+
+	if (prof->ent_cnt == 0) {
+		return (NULL);
+	}
+
+	lst = malloc (prof->ent_cnt * sizeof (prof_ent_t));
+
+	if (lst == NULL) {
+		return (NULL);
+	}
+
+	n = 0;
+
+	for (i = 0; i < prof->ent_max; i++) {
+		if (prof->ent[i].cnt != 0) {
+			lst[n] = prof->ent[i];
+
+			if (flat) {
+				lst[n].node = 0;
+			}
+
+			n += 1;
+		}
+	}
+
+	if (flat) {
+		qsort (lst, n, sizeof (prof_ent_t), prof_cmp_addr);
+
+		/* merge entries with the same address */
+		j = 0;
+
+		for (i = 1; i < n; i++) {
+			if (lst[i].addr == lst[j].addr) {
+				lst[j].cnt += lst[i].cnt;
+				lst[j].clk += lst[i].clk;
+			}
+			else {
+				lst[++j] = lst[i];
+			}
+		}
+
+		n = j + 1;
+	}
+
+	qsort (lst, n, sizeof (prof_ent_t), prof_cmp_clk);
+
+	*cnt = n;
+
+	return (lst);
+}
+
+void prof_print_flat (prof_t *prof, FILE *fp, unsigned max)
+{
+	unsigned long i, n;
+	unsigned long sum;
+	double        tot;
+	prof_ent_t    *lst;
+
+	fprintf (fp, "samples: %lu  clocks: %lu\n",
+		prof->total_cnt, prof->total_clk
+	);
+
+	lst = prof_get_sorted (prof, 1, &n);
+
+	if (lst == NULL) {
+		return;
+	}
+
+	if ((max > 0) && (n > max)) {
+		n = max;
+	}
+
+	fprintf (fp, "%8s  %6s  %6s  %12s  %10s\n",
+		"ADDR", "%", "CUM%", "CLOCKS", "SAMPLES"
+	);
+
+	tot = (prof->total_clk > 0) ? prof->total_clk : 1;
+	sum = 0;
+
+	for (i = 0; i < n; i++) {
+		sum += lst[i].clk;
+
+		fprintf (fp, "%08lX  %6.2f  %6.2f  %12lu  %10lu\n",
+			lst[i].addr,
+			(100.0 * lst[i].clk) / tot,
+			(100.0 * sum) / tot,
+			lst[i].clk, lst[i].cnt
+		);
+	}
+
+	free (lst);
+}
+
+static
+void prof_print_stack (prof_t *prof, FILE *fp, unsigned long node)
+{
+	if (node == 0) {
+		fputs ("root", fp);
+		return;
+	}
+
+	prof_print_stack (prof, fp, prof->node[node].parent);
+
+	fprintf (fp, ";%08lX", prof->node[node].addr);
+}
+
+void prof_print_folded (prof_t *prof, FILE *fp)
+{
+	unsigned long i, n;
+	prof_ent_t    *lst;
+
+	lst = prof_get_sorted (prof, 0, &n);
+
+	if (lst == NULL) {
+		return;
+	}
+
+	for (i = 0; i < n; i++) {
+		prof_print_stack (prof, fp, lst[i].node);
+		fprintf (fp, ";%08lX %lu\n", lst[i].addr, lst[i].clk);
+	}
+
+	free (lst);
+}
+
+int prof_fname_folded (const char *fname)
+{
+	size_t n;
+
+	n = strlen (fname);
+
+	if ((n >= 7) && (strcmp (fname + n - 7, ".folded") == 0)) {
+		return (1);
+	}
+
+	return (0);
+}
+
+int prof_save (prof_t *prof, const char *fname)
+{
+	FILE *fp;
+
+	fp = fopen (fname, "w");
+
+	if (fp == NULL) {
+		return (1);
+	}
+
+	if (prof_fname_folded (fname)) {
+		prof_print_folded (prof, fp);
+	}
+	else {
+		prof_print_flat (prof, fp, 0);
+	}
+
+	fclose (fp);
+
+	return (0);
+}
+
+
+static
+void prof_cmd_stack (cmd_t *cmd, prof_t *prof)
+{
+	if (cmd_match_eol (cmd)) {
+		printf ("call tracking is %s\n", prof->stack ? "on" : "off");
+		return;
+	}
+
+	if (cmd_match (cmd, "on")) {
+		prof->stack = 1;
+	}
+	else if (cmd_match (cmd, "off")) {
+		prof->stack = 0;
+	}
+	else {
+		cmd_error (cmd, "on or off expected\n");
+		return;
+	}
+
+	cmd_match_end (cmd);
+}
+
+void prof_cmd (cmd_t *cmd, prof_t *prof)
+{
+	unsigned short cnt;
+	char           fname[256];
+
+	if (cmd_match_eol (cmd)) {
+		printf ("profiling is %s\n", prof->enabled ? "on" : "off");
+		return;
+	}
+
+	if (cmd_match (cmd, "on")) {
+		if (cmd_match_end (cmd)) {
+			prof->enabled = 1;
+		}
+	}
+	else if (cmd_match (cmd, "off")) {
+		if (cmd_match_end (cmd)) {
+			prof->enabled = 0;
+		}
+	}
+	else if (cmd_match (cmd, "clear")) {
+		if (cmd_match_end (cmd)) {
+			prof_clear (prof);
+		}
+	}
+	else if (cmd_match (cmd, "stack")) {
+		prof_cmd_stack (cmd, prof);
+	}
+	else if (cmd_match (cmd, "folded")) {
+		if (cmd_match_end (cmd)) {
+			prof_print_folded (prof, stdout);
+		}
+	}
+	else if (cmd_match (cmd, "save")) {
+		if (!cmd_match_str (cmd, fname, 256)) {
+			cmd_error (cmd, "expecting a file name");
+			return;
+		}
+
+		if (!cmd_match_end (cmd)) {
+			return;
+		}
+
+		if (prof_save (prof, fname)) {
+			printf ("writing profile failed (%s)\n", fname);
+		}
+	}
+	else {
+		cnt = 20;
+
+		cmd_match (cmd, "flat");
+		cmd_match_uint16 (cmd, &cnt);
+
+		if (cmd_match_end (cmd)) {
+			prof_print_flat (prof, stdout, cnt);
+		}
+	}
+}
@@ -0,0 +1,165 @@
+/*****************************************************************************
+ * pce                                                                       *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * File name:   src/lib/prof.h                                               *
+ * Created:     2026-10-19 by agent <agent@local>                            *
+ * Copyright:   (C) 2026 agent <agent@local>                                 *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * This program is free software. You can redistribute it and / or modify it *
+ * under the terms of the GNU General Public License version 2 as  published *
+ * by the Free Software Foundation.                                          *
+ *                                                                           *
+ * This program is distributed in the hope  that  it  will  be  useful,  but *
+ * WITHOUT  ANY   WARRANTY,   without   even   the   implied   warranty   of *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU  General *
+ * Public License for more details.                                          *
+ *****************************************************************************/
+
+
+#ifndef PCE_LIB_PROF_H
+#define PCE_LIB_PROF_H 1
+
+
+#include <stdio.h>
+
+#include <lib/cmd.h>
+
+
+#define PROF_DEPTH_MAX 256
+
+
+/* a node in the call tree */
+typedef struct {
+	unsigned long parent;
+	unsigned long addr;
+	unsigned      depth;
+} prof_node_t;
+
+
+/* a histogram entry */
+typedef struct {
+	unsigned long node;
+	unsigned long addr;
+	unsigned long cnt;
+	unsigned long clk;
+} prof_ent_t;
+
+
+typedef struct {
+	char          enabled;
+
+	/* track calls and returns */
+	char          stack;
+
+	unsigned long node_cnt;
+	unsigned long node_max;
+	prof_node_t   *node;
+
+	unsigned long hash_max;
+	unsigned long *hash;
+
+	unsigned long ent_cnt;
+	unsigned long ent_max;
+	prof_ent_t    *ent;
+
+	/* the current call tree node */
+	unsigned long cur;
+
+	/* a call was executed, the next instruction is the callee */
+	char          call;
+
+	/* calls that were not recorded because the tree was too deep */
+	unsigned long skip;
+
+	unsigned long total_cnt;
+	unsigned long total_clk;
+} prof_t;
+
+
+void prof_init (prof_t *prof);
+void prof_free (prof_t *prof);
+
+/*!***************************************************************************
+ * @short Discard all samples
+ *****************************************************************************/
+void prof_clear (prof_t *prof);
+
+void prof_set_enabled (prof_t *prof, int val);
+
+/*!***************************************************************************
+ * @short Add a sample
+ * @param addr The current program counter
+ * @param clk  The number of clock cycles until the next sample
+ *
+ * The emulators take the sample before they run the CPU for clk cycles.
+ * If those cycles cover more than one instruction, all of them are
+ * charged to the instruction at addr. Most emulators clock the CPU in
+ * small batches, but at full speed the ibmpc emulator adds extra
+ * cycles to each batch, so a sample can span several instructions.
+ *****************************************************************************/
+void prof_add (prof_t *prof, unsigned long addr, unsigned long clk);
+
+/*!***************************************************************************
+ * @short Enter a subroutine
+ * @param addr The subroutine address
+ *****************************************************************************/
+void prof_call (prof_t *prof, unsigned long addr);
+
+/*!***************************************************************************
+ * @short Return from a subroutine
+ *****************************************************************************/
+void prof_ret (prof_t *prof);
+
+/*!***************************************************************************
+ * @short Track calls and returns of an 8086 CPU
+ * @param addr The linear address of the current instruction
+ * @param op1  The first byte of the current instruction
+ * @param op2  The second byte of the current instruction
+ *****************************************************************************/
+void prof_op_e86 (prof_t *prof, unsigned long addr, unsigned op1, unsigned op2);
+
+/*!***************************************************************************
+ * @short Track calls and returns of a 68000 CPU
+ * @param addr The address of the current instruction
+ * @param ir   The first word of the current instruction
+ *****************************************************************************/
+void prof_op_e68 (prof_t *prof, unsigned long addr, unsigned long ir);
+
+/*!***************************************************************************
+ * @short Print a flat profile
+ * @param max The maximum number of addresses (0 for all)
+ *****************************************************************************/
+void prof_print_flat (prof_t *prof, FILE *fp, unsigned max);
+
+/*!***************************************************************************
+ * @short Print the profile in folded stacks format
+ *
+ * Each line contains the call stack and the sampled address, separated
+ * by semicolons, and the number of clock cycles.
+ *****************************************************************************/
+void prof_print_folded (prof_t *prof, FILE *fp);
+
+/*!***************************************************************************
+ * @short Check if a file name selects the folded stacks format
+ *****************************************************************************/
+int prof_fname_folded (const char *fname);
+
+/*!***************************************************************************
+ * @short Save the profile to a file
+ *
+ * If the file name ends in ".folded", the profile is saved in folded
+ * stacks format, otherwise a flat profile is saved.
+ *****************************************************************************/
+int prof_save (prof_t *prof, const char *fname);
+
+/*!***************************************************************************
+ * @short Handle the prof monitor command
+ *****************************************************************************/
+void prof_cmd (cmd_t *cmd, prof_t *prof);
+
+
+#endif
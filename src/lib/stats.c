@@ -0,0 +1,458 @@
+/*****************************************************************************
+ * pce                                                                       *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * File name:   src/lib/stats.c                                              *
+ * Created:     2026-10-19 by agent <agent@local>                            *
+ * Copyright:   (C) 2026 agent <agent@local>                                 *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * This program is free software. You can redistribute it and / or modify it *
+ * under the terms of the GNU General Public License version 2 as  published *
+ * by the Free Software Foundation.                                          *
+ *                                                                           *
+ * This program is distributed in the hope  that  it  will  be  useful,  but *
+ * WITHOUT  ANY   WARRANTY,   without   even   the   implied   warranty   of *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU  General *
+ * Public License for more details.                                          *
+ *****************************************************************************/
+
+
+#include <config.h>
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <lib/cmd.h>
+#include <lib/stats.h>
+#include <lib/sysdep.h>
+
+
+static pce_stat_t         *par_stats = NULL;
+
+static pce_stats_update_f par_update_fct = NULL;
+static void               *par_update_ext = NULL;
+
+static unsigned long long par_host_start = 0;
+
+/* host CPU time spent in the drivers during the current update */
+static unsigned long long par_video_us;
+static unsigned long long par_audio_us;
+static unsigned long long par_disk_us;
+
+static FILE               *par_dump_fp = NULL;
+static unsigned long      par_dump_ms = 1000;
+static unsigned long      par_dump_clk = 0;
+static unsigned long long par_dump_us = 0;
+
+
+void pce_stats_init (void)
+{
+	par_stats = NULL;
+
+	par_update_fct = NULL;
+	par_update_ext = NULL;
+
+	par_host_start = pce_get_time_us();
+
+	par_dump_fp = NULL;
+}
+
+void pce_stats_done (void)
+{
+	pce_stat_t *st;
+
+	if (par_dump_fp != NULL) {
+		fclose (par_dump_fp);
+		par_dump_fp = NULL;
+	}
+
+	while (par_stats != NULL) {
+		st = par_stats;
+		par_stats = st->next;
+
+		free (st->name);
+		free (st);
+	}
+}
+
+pce_stat_t *pce_stat_get (const char *name)
+{
+	int        r;
+	pce_stat_t *st, *prv;
+
+	prv = NULL;
+	st = par_stats;
+
+	while (st != NULL) {
+		r = strcmp (st->name, name);
+
+		if (r == 0) {
+			return (st);
+		}
+		else if (r > 0) {
+			break;
+		}
+
+		prv = st;
+		st = st->next;
+	}
+
+	st = malloc (sizeof (pce_stat_t));
+
+	if (st == NULL) {
+		return (NULL);
+	}
+
+	st->name = malloc (strlen (name) + 1);
+
+	if (st->name == NULL) {
+		free (st);
+		return (NULL);
+	}
+
+	strcpy (st->name, name);
+
+	st->counter = 1;
+	st->val = 0;
+	st->base = 0;
+
+	if (prv == NULL) {
+		st->next = par_stats;
+		par_stats = st;
+	}
+	else {
+		st->next = prv->next;
+		prv->next = st;
+	}
+
+	return (st);
+}
+
+void pce_stat_set (const char *name, unsigned long long val)
+{
+	pce_stat_t *st;
+
+	if ((st = pce_stat_get (name)) != NULL) {
+		st->val = val;
+	}
+}
+
+static
+unsigned long long pce_stat_value (const pce_stat_t *st)
+{
+	if (st->counter && (st->val >= st->base)) {
+		return (st->val - st->base);
+	}
+
+	return (st->val);
+}
+
+static
+unsigned long long pce_stat_get_val (const char *name)
+{
+	pce_stat_t *st;
+
+	st = par_stats;
+
+	while (st != NULL) {
+		if (strcmp (st->name, name) == 0) {
+			return (pce_stat_value (st));
+		}
+
+		st = st->next;
+	}
+
+	return (0);
+}
+
+static
+void pce_stat_set_gauge (const char *name, unsigned long long val)
+{
+	pce_stat_t *st;
+
+	if ((st = pce_stat_get (name)) != NULL) {
+		st->counter = 0;
+		st->val = val;
+	}
+}
+
+void pce_stats_set_update_fct (pce_stats_update_f fct, void *ext)
+{
+	par_update_fct = fct;
+	par_update_ext = ext;
+}
+
+void pce_stats_update (void)
+{
+	unsigned long long cpu, emu, sim, host;
+
+	par_video_us = 0;
+	par_audio_us = 0;
+	par_disk_us = 0;
+
+	if (par_update_fct != NULL) {
+		par_update_fct (par_update_ext);
+	}
+
+	/* the driver times are measured in the same CPU clock */
+	cpu = pce_get_cpu_us();
+
+	emu = par_video_us + par_audio_us + par_disk_us;
+	emu = (cpu > emu) ? (cpu - emu) : 0;
+
+	pce_stat_set ("host.time_us", pce_get_time_us() - par_host_start);
+	pce_stat_set ("host.cpu_us", cpu);
+	pce_stat_set ("host.emu_us", emu);
+	pce_stat_set ("host.video_us", par_video_us);
+	pce_stat_set ("host.audio_us", par_audio_us);
+	pce_stat_set ("host.disk_us", par_disk_us);
+
+	host = pce_stat_get_val ("host.time_us");
+	sim = pce_stat_get_val ("sim.time_us");
+
+	pce_stat_set_gauge ("sim.speed_pct", (host > 0) ? ((100 * sim) / host) : 0);
+}
+
+void pce_stats_clear (void)
+{
+	pce_stat_t *st;
+
+	pce_stats_update();
+
+	st = par_stats;
+
+	while (st != NULL) {
+		st->base = st->val;
+		st = st->next;
+	}
+}
+
+void pce_stats_set_sim (unsigned long long insn, unsigned long long clk, unsigned long freq)
+{
+	pce_stat_set ("sim.insn", insn);
+	pce_stat_set ("sim.clock", clk);
+
+	if (freq > 0) {
+		pce_stat_set ("sim.time_us",
+			(clk / freq) * 1000000 + ((clk % freq) * 1000000) / freq
+		);
+	}
+}
+
+void pce_stats_set_disks (disks_t *dsks)
+{
+	unsigned i;
+	disk_t   *dsk;
+	char     name[64];
+
+	for (i = 0; i < dsks->cnt; i++) {
+		dsk = dsks->dsk[i];
+
+		sprintf (name, "disk.%u.rd_ops", dsk->drive);
+		pce_stat_set (name, dsk->stat_rd_ops);
+
+		sprintf (name, "disk.%u.rd_bytes", dsk->drive);
+		pce_stat_set (name, 512 * dsk->stat_rd_blk);
+
+		sprintf (name, "disk.%u.wr_ops", dsk->drive);
+		pce_stat_set (name, dsk->stat_wr_ops);
+
+		sprintf (name, "disk.%u.wr_bytes", dsk->drive);
+		pce_stat_set (name, 512 * dsk->stat_wr_blk);
+
+		par_disk_us += dsk->stat_us;
+	}
+}
+
+void pce_stats_set_chr (const char *name, const char_drv_t *cdrv)
+{
+	char str[64];
+
+	if (cdrv == NULL) {
+		return;
+	}
+
+	sprintf (str, "chr.%.32s.rd_bytes", name);
+	pce_stat_set (str, cdrv->stat_rd);
+
+	sprintf (str, "chr.%.32s.wr_bytes", name);
+	pce_stat_set (str, cdrv->stat_wr);
+}
+
+void pce_stats_set_snd (const char *name, const sound_drv_t *sdrv)
+{
+	char str[64];
+
+	if (sdrv == NULL) {
+		return;
+	}
+
+	sprintf (str, "snd.%.32s.samples", name);
+	pce_stat_set (str, sdrv->stat_samples);
+
+	par_audio_us += sdrv->stat_us;
+}
+
+void pce_stats_set_trm (const terminal_t *trm)
+{
+	if (trm == NULL) {
+		return;
+	}
+
+	pce_stat_set ("trm.updates", trm->stat_updates);
+
+	par_video_us += trm->stat_us;
+}
+
+void pce_stats_print (FILE *fp, const char *prefix)
+{
+	unsigned   n;
+	pce_stat_t *st;
+
+	pce_stats_update();
+
+	n = strlen (prefix);
+
+	st = par_stats;
+
+	while (st != NULL) {
+		if (strncmp (st->name, prefix, n) == 0) {
+			fprintf (fp, "%-24s %llu\n", st->name,
+				pce_stat_value (st)
+			);
+		}
+
+		st = st->next;
+	}
+}
+
+void pce_stats_dump (FILE *fp)
+{
+	pce_stat_t *st;
+
+	pce_stats_update();
+
+	st = par_stats;
+
+	while (st != NULL) {
+		fprintf (fp, "%s=%llu", st->name, pce_stat_value (st));
+
+		st = st->next;
+
+		fputc ((st == NULL) ? '\n' : ' ', fp);
+	}
+
+	fflush (fp);
+}
+
+int pce_stats_set_dump (const char *fname, unsigned long ms)
+{
+	if (par_dump_fp != NULL) {
+		fclose (par_dump_fp);
+		par_dump_fp = NULL;
+	}
+
+	if (fname == NULL) {
+		return (0);
+	}
+
+	par_dump_fp = fopen (fname, "a");
+
+	if (par_dump_fp == NULL) {
+		return (1);
+	}
+
+	pce_set_stat_timing (1);
+
+	par_dump_ms = (ms > 0) ? ms : 1;
+
+	pce_get_interval_us (&par_dump_clk);
+	par_dump_us = 0;
+
+	pce_stats_dump (par_dump_fp);
+
+	return (0);
+}
+
+void pce_stats_check (void)
+{
+	if (par_dump_fp == NULL) {
+		return;
+	}
+
+	par_dump_us += pce_get_interval_us (&par_dump_clk);
+
+	if (par_dump_us < (1000ULL * par_dump_ms)) {
+		return;
+	}
+
+	par_dump_us -= 1000ULL * par_dump_ms;
+
+	if (par_dump_us > (1000ULL * par_dump_ms)) {
+		par_dump_us = 0;
+	}
+
+	pce_stats_dump (par_dump_fp);
+}
+
+static
+void pce_stats_cmd_dump (cmd_t *cmd)
+{
+	unsigned long ms;
+	char          fname[256];
+
+	if (cmd_match (cmd, "off")) {
+		if (cmd_match_end (cmd)) {
+			pce_stats_set_dump (NULL, 0);
+		}
+
+		return;
+	}
+
+	if (!cmd_match_str (cmd, fname, 256)) {
+		cmd_error (cmd, "expecting a file name");
+		return;
+	}
+
+	ms = 1000;
+
+	cmd_match_uint32 (cmd, &ms);
+
+	if (!cmd_match_end (cmd)) {
+		return;
+	}
+
+	if (pce_stats_set_dump (fname, ms)) {
+		printf ("can't open file (%s)\n", fname);
+	}
+}
+
+void pce_stats_cmd (cmd_t *cmd)
+{
+	char prefix[256];
+
+	/* the driver times are only measured once someone looks at them */
+	pce_set_stat_timing (1);
+
+	if (cmd_match (cmd, "clear")) {
+		if (cmd_match_end (cmd)) {
+			pce_stats_clear();
+		}
+	}
+	else if (cmd_match (cmd, "dump")) {
+		pce_stats_cmd_dump (cmd);
+	}
+	else {
+		prefix[0] = 0;
+
+		cmd_match_str (cmd, prefix, 256);
+
+		if (cmd_match_end (cmd)) {
+			pce_stats_print (stdout, prefix);
+		}
+	}
+}
@@ -0,0 +1,131 @@
+/*****************************************************************************
+ * pce                                                                       *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * File name:   src/lib/stats.h                                              *
+ * Created:     2026-10-19 by agent <agent@local>                            *
+ * Copyright:   (C) 2026 agent <agent@local>                                 *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * This program is free software. You can redistribute it and / or modify it *
+ * under the terms of the GNU General Public License version 2 as  published *
+ * by the Free Software Foundation.                                          *
+ *                                                                           *
+ * This program is distributed in the hope  that  it  will  be  useful,  but *
+ * WITHOUT  ANY   WARRANTY,   without   even   the   implied   warranty   of *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU  General *
+ * Public License for more details.                                          *
+ *****************************************************************************/
+
+
+#ifndef PCE_LIB_STATS_H
+#define PCE_LIB_STATS_H 1
+
+
+#include <stdio.h>
+
+#include <drivers/block/block.h>
+#include <drivers/char/char.h>
+#include <drivers/sound/sound.h>
+#include <drivers/video/terminal.h>
+
+#include <lib/cmd.h>
+
+
+typedef struct pce_stat_s {
+	struct pce_stat_s  *next;
+
+	char               *name;
+
+	/* the value is a counter, not a gauge */
+	char               counter;
+
+	unsigned long long val;
+
+	/* the counter value at the last clear */
+	unsigned long long base;
+} pce_stat_t;
+
+
+typedef void (*pce_stats_update_f) (void *ext);
+
+
+void pce_stats_init (void);
+void pce_stats_done (void);
+
+/*!***************************************************************************
+ * @short Get a counter, creating it if it does not exist
+ *****************************************************************************/
+pce_stat_t *pce_stat_get (const char *name);
+
+/*!***************************************************************************
+ * @short Set a counter by name
+ *****************************************************************************/
+void pce_stat_set (const char *name, unsigned long long val);
+
+/*!***************************************************************************
+ * @short Set the function that updates the counters
+ *
+ * The update function is called before the counters are printed or
+ * dumped. It usually copies counters from the emulated machine and
+ * the host drivers into the registry.
+ *****************************************************************************/
+void pce_stats_set_update_fct (pce_stats_update_f fct, void *ext);
+
+void pce_stats_update (void);
+
+/*!***************************************************************************
+ * @short Reset all counters to zero
+ *****************************************************************************/
+void pce_stats_clear (void);
+
+/*!***************************************************************************
+ * @short Set the guest counters
+ * @param insn The number of instructions executed
+ * @param clk  The number of CPU clock cycles
+ * @param freq The CPU clock frequency in Hz
+ *****************************************************************************/
+void pce_stats_set_sim (unsigned long long insn, unsigned long long clk, unsigned long freq);
+
+void pce_stats_set_disks (disks_t *dsks);
+void pce_stats_set_chr (const char *name, const char_drv_t *cdrv);
+void pce_stats_set_snd (const char *name, const sound_drv_t *sdrv);
+void pce_stats_set_trm (const terminal_t *trm);
+
+/*!***************************************************************************
+ * @short Print all counters whose names start with prefix
+ *****************************************************************************/
+void pce_stats_print (FILE *fp, const char *prefix);
+
+/*!***************************************************************************
+ * @short Print all counters on a single line
+ *****************************************************************************/
+void pce_stats_dump (FILE *fp);
+
+/*!***************************************************************************
+ * @short Dump the counters to a file periodically
+ * @param fname The file name or NULL to stop dumping
+ * @param ms    The dump interval in milliseconds
+ *****************************************************************************/
+int pce_stats_set_dump (const char *fname, unsigned long ms);
+
+/*!***************************************************************************
+ * @short Dump the counters if the dump interval has passed
+ *
+ * This function should be called regularly by the emulator.
+ *****************************************************************************/
+void pce_stats_check (void);
+
+/*!***************************************************************************
+ * @short Handle the stats monitor command
+ *
+ * The host CPU time of the drivers (host.video_us, host.audio_us and
+ * host.disk_us) is only measured after the first stats command or
+ * after a dump file has been set.
+ *****************************************************************************/
+void pce_stats_cmd (cmd_t *cmd);
+
+
+#endif
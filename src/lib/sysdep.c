@@ -50,6 +50,9 @@
 #include "sysdep.h"
 
 
+static int par_stat_timing = 0;
+
+
 int pce_usleep (unsigned long usec)
 {
 #if defined(HAVE_NANOSLEEP)
@@ -95,6 +98,48 @@ unsigned long pce_get_interval_us (unsigned long *val)
 #endif
 }
 
+unsigned long long pce_get_time_us (void)
+{
+#ifdef HAVE_GETTIMEOFDAY
+	struct timeval tv;
+
+	if (gettimeofday (&tv, NULL)) {
+		return (0);
+	}
+
+	return (1000000ULL * (unsigned long long) tv.tv_sec + tv.tv_usec);
+#else
+	return (1000000ULL * (unsigned long long) time (NULL));
+#endif
+}
+
+unsigned long long pce_get_cpu_us (void)
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+	struct timespec ts;
+
+	if (clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts) == 0) {
+		return (1000000ULL * (unsigned long long) ts.tv_sec + ts.tv_nsec / 1000);
+	}
+#endif
+
+	return (((unsigned long long) clock() * 1000000) / CLOCKS_PER_SEC);
+}
+
+void pce_set_stat_timing (int val)
+{
+	par_stat_timing = (val != 0);
+}
+
+unsigned long long pce_get_stat_us (void)
+{
+	if (par_stat_timing == 0) {
+		return (0);
+	}
+
+	return (pce_get_cpu_us());
+}
+
 void pce_srand (unsigned val)
 {
 #ifdef HAVE_GETTIMEOFDAY
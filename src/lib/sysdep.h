@@ -38,6 +38,32 @@ int pce_usleep (unsigned long usec);
  *****************************************************************************/
 unsigned long pce_get_interval_us (unsigned long *val);
 
+/*!***************************************************************************
+ * @short Get the wall clock time in microseconds
+ *****************************************************************************/
+unsigned long long pce_get_time_us (void);
+
+/*!***************************************************************************
+ * @short Get the CPU time used by the calling thread in microseconds
+ *
+ * If the thread CPU time is not available, the CPU time of the process
+ * is returned.
+ *****************************************************************************/
+unsigned long long pce_get_cpu_us (void);
+
+/*!***************************************************************************
+ * @short Enable or disable measuring the host CPU time of the drivers
+ *****************************************************************************/
+void pce_set_stat_timing (int val);
+
+/*!***************************************************************************
+ * @short Get the CPU time for the driver performance counters
+ *
+ * Returns the same value as pce_get_cpu_us() or 0 if driver timing is
+ * disabled.
+ *****************************************************************************/
+unsigned long long pce_get_stat_us (void);
+
 void pce_srand (unsigned val);
 
 void pce_set_fd_interactive (int fd, int interactive);
@@ -0,0 +1,668 @@
+/*****************************************************************************
+ * libini                                                                    *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * File name:   src/libini/cache.c                                           *
+ * Created:     2026-10-19 by agent <agent@local>                            *
+ * Copyright:   (C) 2026 agent <agent@local>                                 *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * This program is free software. You can redistribute it and / or modify it *
+ * under the terms of the GNU General Public License version 2 as  published *
+ * by the Free Software Foundation.                                          *
+ *                                                                           *
+ * This program is distributed in the hope  that  it  will  be  useful,  but *
+ * WITHOUT  ANY   WARRANTY,   without   even   the   implied   warranty   of *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU  General *
+ * Public License for more details.                                          *
+ *****************************************************************************/
+
+
+/*
+ * The cache file layout, all integers are 32 bit big endian:
+ *
+ * magic, version
+ * key size, key          the tree before the ini file was read
+ * dep count
+ *   name, found, size high, size low, mtime high, mtime low
+ * tree size, tree        the tree after the ini file was read
+ *
+ * A tree is stored as a section:
+ *
+ * name, value count, values, subsection count, subsections
+ *
+ * and a value as:
+ *
+ * name, type, value high, value low    (INI_VAL_INT)
+ * name, type, string                   (INI_VAL_STR)
+ *
+ * Strings are stored as their length followed by the characters.
+ */
+
+
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/stat.h>
+
+#include <libini/libini.h>
+#include <libini/scanner.h>
+
+
+#define INI_CACHE_MAGIC   0x50434943
+#define INI_CACHE_VERSION 1
+
+
+typedef struct {
+	unsigned long cnt;
+	unsigned long max;
+	unsigned char *buf;
+} ini_buf_t;
+
+
+static
+int ini_buf_put (ini_buf_t *buf, const void *data, unsigned long cnt)
+{
+	unsigned long max;
+	unsigned char *tmp;
+
+	if ((buf->cnt + cnt) > buf->max) {
+		max = (buf->max < 1024) ? 1024 : buf->max;
+
+		while ((buf->cnt + cnt) > max) {
+			max *= 2;
+		}
+
+		if ((tmp = realloc (buf->buf, max)) == NULL) {
+			return (1);
+		}
+
+		buf->buf = tmp;
+		buf->max = max;
+	}
+
+	memcpy (buf->buf + buf->cnt, data, cnt);
+
+	buf->cnt += cnt;
+
+	return (0);
+}
+
+static
+int ini_buf_put_uint32 (ini_buf_t *buf, unsigned long val)
+{
+	unsigned char tmp[4];
+
+	tmp[0] = (val >> 24) & 0xff;
+	tmp[1] = (val >> 16) & 0xff;
+	tmp[2] = (val >> 8) & 0xff;
+	tmp[3] = val & 0xff;
+
+	return (ini_buf_put (buf, tmp, 4));
+}
+
+static
+int ini_buf_put_uint64 (ini_buf_t *buf, unsigned long long val)
+{
+	if (ini_buf_put_uint32 (buf, (val >> 32) & 0xffffffff)) {
+		return (1);
+	}
+
+	return (ini_buf_put_uint32 (buf, val & 0xffffffff));
+}
+
+static
+int ini_buf_put_str (ini_buf_t *buf, const char *str)
+{
+	unsigned long n;
+
+	if (str == NULL) {
+		str = "";
+	}
+
+	n = strlen (str);
+
+	if (ini_buf_put_uint32 (buf, n)) {
+		return (1);
+	}
+
+	return (ini_buf_put (buf, str, n));
+}
+
+static
+int ini_buf_get_uint32 (ini_buf_t *buf, unsigned long *val)
+{
+	const unsigned char *p;
+
+	if ((buf->cnt + 4) > buf->max) {
+		return (1);
+	}
+
+	p = buf->buf + buf->cnt;
+
+	*val = ((unsigned long) p[0] << 24) | ((unsigned long) p[1] << 16);
+	*val |= ((unsigned long) p[2] << 8) | p[3];
+
+	buf->cnt += 4;
+
+	return (0);
+}
+
+static
+int ini_buf_get_uint64 (ini_buf_t *buf, unsigned long long *val)
+{
+	unsigned long v1, v2;
+
+	if (ini_buf_get_uint32 (buf, &v1) || ini_buf_get_uint32 (buf, &v2)) {
+		return (1);
+	}
+
+	*val = ((unsigned long long) v1 << 32) | v2;
+
+	return (0);
+}
+
+/*
+ * Get a string from the buffer. The string is copied to a newly
+ * allocated buffer.
+ */
+static
+char *ini_buf_get_str (ini_buf_t *buf)
+{
+	unsigned long n;
+	char          *str;
+
+	if (ini_buf_get_uint32 (buf, &n)) {
+		return (NULL);
+	}
+
+	if (n > (buf->max - buf->cnt)) {
+		return (NULL);
+	}
+
+	if ((str = malloc (n + 1)) == NULL) {
+		return (NULL);
+	}
+
+	memcpy (str, buf->buf + buf->cnt, n);
+	str[n] = 0;
+
+	buf->cnt += n;
+
+	return (str);
+}
+
+static
+int ini_cache_put_sct (ini_buf_t *buf, const ini_sct_t *sct)
+{
+	unsigned long   n;
+	const ini_val_t *val;
+	const ini_sct_t *sub;
+
+	if (ini_buf_put_str (buf, sct->name)) {
+		return (1);
+	}
+
+	n = 0;
+
+	for (val = sct->val_head; val != NULL; val = val->next) {
+		n += 1;
+	}
+
+	if (ini_buf_put_uint32 (buf, n)) {
+		return (1);
+	}
+
+	for (val = sct->val_head; val != NULL; val = val->next) {
+		if (ini_buf_put_str (buf, val->name)) {
+			return (1);
+		}
+
+		if (ini_buf_put_uint32 (buf, val->type)) {
+			return (1);
+		}
+
+		if (val->type == INI_VAL_INT) {
+			if (ini_buf_put_uint64 (buf, val->val.u32)) {
+				return (1);
+			}
+		}
+		else if (val->type == INI_VAL_STR) {
+			if (ini_buf_put_str (buf, val->val.str)) {
+				return (1);
+			}
+		}
+	}
+
+	n = 0;
+
+	for (sub = sct->sub_head; sub != NULL; sub = sub->next) {
+		n += 1;
+	}
+
+	if (ini_buf_put_uint32 (buf, n)) {
+		return (1);
+	}
+
+	for (sub = sct->sub_head; sub != NULL; sub = sub->next) {
+		if (ini_cache_put_sct (buf, sub)) {
+			return (1);
+		}
+	}
+
+	return (0);
+}
+
+/*
+ * Get the values and subsections of sct from the buffer. The section
+ * name must have been read already.
+ */
+static
+int ini_cache_get_sct (ini_buf_t *buf, ini_sct_t *sct)
+{
+	unsigned long      i, n, type;
+	unsigned long long v;
+	char               *str;
+	ini_val_t          *val;
+	ini_sct_t          *sub;
+
+	if (ini_buf_get_uint32 (buf, &n)) {
+		return (1);
+	}
+
+	for (i = 0; i < n; i++) {
+		if ((str = ini_buf_get_str (buf)) == NULL) {
+			return (1);
+		}
+
+		val = ini_val_new (str);
+
+		free (str);
+
+		if (val == NULL) {
+			return (1);
+		}
+
+		if (sct->val_head == NULL) {
+			sct->val_head = val;
+		}
+		else {
+			sct->val_tail->next = val;
+		}
+
+		sct->val_tail = val;
+
+		if (ini_buf_get_uint32 (buf, &type)) {
+			return (1);
+		}
+
+		if (type == INI_VAL_INT) {
+			if (ini_buf_get_uint64 (buf, &v)) {
+				return (1);
+			}
+
+			ini_val_set_uint32 (val, v);
+		}
+		else if (type == INI_VAL_STR) {
+			if ((str = ini_buf_get_str (buf)) == NULL) {
+				return (1);
+			}
+
+			ini_val_set_str (val, str);
+
+			free (str);
+		}
+		else if (type != INI_VAL_NONE) {
+			return (1);
+		}
+	}
+
+	if (ini_buf_get_uint32 (buf, &n)) {
+		return (1);
+	}
+
+	for (i = 0; i < n; i++) {
+		if ((str = ini_buf_get_str (buf)) == NULL) {
+			return (1);
+		}
+
+		sub = ini_sct_new (str);
+
+		free (str);
+
+		if (sub == NULL) {
+			return (1);
+		}
+
+		sub->parent = sct;
+
+		if (sct->sub_head == NULL) {
+			sct->sub_head = sub;
+		}
+		else {
+			sct->sub_tail->next = sub;
+		}
+
+		sct->sub_tail = sub;
+
+		if (ini_cache_get_sct (buf, sub)) {
+			return (1);
+		}
+	}
+
+	return (0);
+}
+
+/*
+ * Replace the values and subsections of dst with those of src and
+ * delete src.
+ */
+static
+void ini_cache_move_sct (ini_sct_t *dst, ini_sct_t *src)
+{
+	ini_sct_t *sub;
+
+	ini_val_del (dst->val_head);
+	ini_sct_del (dst->sub_head);
+
+	dst->val_head = src->val_head;
+	dst->val_tail = src->val_tail;
+	dst->sub_head = src->sub_head;
+	dst->sub_tail = src->sub_tail;
+
+	for (sub = dst->sub_head; sub != NULL; sub = sub->next) {
+		sub->parent = dst;
+	}
+
+	src->val_head = NULL;
+	src->val_tail = NULL;
+	src->sub_head = NULL;
+	src->sub_tail = NULL;
+
+	ini_sct_del (src);
+}
+
+/*
+ * Check if a file is unchanged since the cache was written
+ */
+static
+int ini_cache_check_dep (ini_buf_t *buf)
+{
+	int                r;
+	unsigned long      found;
+	unsigned long long size, mtime;
+	char               *name;
+	struct stat        st;
+
+	if ((name = ini_buf_get_str (buf)) == NULL) {
+		return (1);
+	}
+
+	r = stat (name, &st);
+
+	free (name);
+
+	if (ini_buf_get_uint32 (buf, &found)) {
+		return (1);
+	}
+
+	if (ini_buf_get_uint64 (buf, &size) || ini_buf_get_uint64 (buf, &mtime)) {
+		return (1);
+	}
+
+	if (found == 0) {
+		return (r == 0);
+	}
+
+	if (r != 0) {
+		return (1);
+	}
+
+	if ((size != (unsigned long long) st.st_size) || (mtime != (unsigned long long) st.st_mtime)) {
+		return (1);
+	}
+
+	return (0);
+}
+
+static
+int ini_cache_load (ini_sct_t *sct, const char *cache, const ini_buf_t *key)
+{
+	int           r;
+	unsigned long i, n, val;
+	long          size;
+	char          *str;
+	FILE          *fp;
+	ini_sct_t     *tmp;
+	ini_buf_t     buf;
+
+	if ((fp = fopen (cache, "rb")) == NULL) {
+		return (1);
+	}
+
+	if (fseek (fp, 0, SEEK_END) || ((size = ftell (fp)) < 0)) {
+		fclose (fp);
+		return (1);
+	}
+
+	rewind (fp);
+
+	if ((buf.buf = malloc (size + 1)) == NULL) {
+		fclose (fp);
+		return (1);
+	}
+
+	buf.cnt = 0;
+	buf.max = fread (buf.buf, 1, size, fp);
+
+	fclose (fp);
+
+	r = 1;
+
+	if (ini_buf_get_uint32 (&buf, &val) || (val != INI_CACHE_MAGIC)) {
+		goto done;
+	}
+
+	if (ini_buf_get_uint32 (&buf, &val) || (val != INI_CACHE_VERSION)) {
+		goto done;
+	}
+
+	if (ini_buf_get_uint32 (&buf, &n) || (n != key->cnt)) {
+		goto done;
+	}
+
+	if ((n > (buf.max - buf.cnt)) || (memcmp (buf.buf + buf.cnt, key->buf, n) != 0)) {
+		goto done;
+	}
+
+	buf.cnt += n;
+
+	if (ini_buf_get_uint32 (&buf, &n)) {
+		goto done;
+	}
+
+	for (i = 0; i < n; i++) {
+		if (ini_cache_check_dep (&buf)) {
+			goto done;
+		}
+	}
+
+	if (ini_buf_get_uint32 (&buf, &n) || (n != (buf.max - buf.cnt))) {
+		goto done;
+	}
+
+	if ((str = ini_buf_get_str (&buf)) == NULL) {
+		goto done;
+	}
+
+	free (str);
+
+	if ((tmp = ini_sct_new (NULL)) == NULL) {
+		goto done;
+	}
+
+	if (ini_cache_get_sct (&buf, tmp)) {
+		ini_sct_del (tmp);
+		goto done;
+	}
+
+	ini_cache_move_sct (sct, tmp);
+
+	r = 0;
+
+done:
+	free (buf.buf);
+
+	return (r);
+}
+
+static
+int ini_cache_save (const ini_sct_t *sct, const char *cache, const ini_buf_t *key, const scn_dep_t *dep)
+{
+	int             r;
+	unsigned long   n;
+	const scn_dep_t *tmp;
+	struct stat     st;
+	ini_buf_t       buf, tree;
+	FILE            *fp;
+	char            *name;
+
+	buf.cnt = 0;
+	buf.max = 0;
+	buf.buf = NULL;
+
+	tree.cnt = 0;
+	tree.max = 0;
+	tree.buf = NULL;
+
+	r = 1;
+
+	if (ini_cache_put_sct (&tree, sct)) {
+		goto done;
+	}
+
+	ini_buf_put_uint32 (&buf, INI_CACHE_MAGIC);
+	ini_buf_put_uint32 (&buf, INI_CACHE_VERSION);
+	ini_buf_put_uint32 (&buf, key->cnt);
+	ini_buf_put (&buf, key->buf, key->cnt);
+
+	n = 0;
+
+	for (tmp = dep; tmp != NULL; tmp = tmp->next) {
+		n += 1;
+	}
+
+	ini_buf_put_uint32 (&buf, n);
+
+	for (tmp = dep; tmp != NULL; tmp = tmp->next) {
+		if (tmp->found) {
+			if (stat (tmp->name, &st)) {
+				goto done;
+			}
+		}
+		else {
+			st.st_size = 0;
+			st.st_mtime = 0;
+		}
+
+		ini_buf_put_str (&buf, tmp->name);
+		ini_buf_put_uint32 (&buf, tmp->found != 0);
+		ini_buf_put_uint64 (&buf, st.st_size);
+		ini_buf_put_uint64 (&buf, st.st_mtime);
+	}
+
+	ini_buf_put_uint32 (&buf, tree.cnt);
+
+	if (ini_buf_put (&buf, tree.buf, tree.cnt)) {
+		goto done;
+	}
+
+	/* write to a temporary file so that readers never see a partial cache */
+	n = strlen (cache);
+
+	if ((name = malloc (n + 5)) == NULL) {
+		goto done;
+	}
+
+	memcpy (name, cache, n);
+	memcpy (name + n, ".tmp", 5);
+
+	if ((fp = fopen (name, "wb")) == NULL) {
+		free (name);
+		goto done;
+	}
+
+	r = (fwrite (buf.buf, 1, buf.cnt, fp) != buf.cnt);
+
+	if (fclose (fp)) {
+		r = 1;
+	}
+
+	if (r == 0) {
+		r = (rename (name, cache) != 0);
+	}
+
+	if (r) {
+		remove (name);
+	}
+
+	free (name);
+
+done:
+	free (tree.buf);
+	free (buf.buf);
+
+	return (r);
+}
+
+int ini_read_cache (ini_sct_t *sct, const char *fname, const char *cache)
+{
+	int       r;
+	FILE      *fp;
+	scanner_t scn;
+	ini_buf_t key;
+
+	if (cache == NULL) {
+		return (ini_read (sct, fname));
+	}
+
+	key.cnt = 0;
+	key.max = 0;
+	key.buf = NULL;
+
+	if (ini_cache_put_sct (&key, sct)) {
+		free (key.buf);
+		return (ini_read (sct, fname));
+	}
+
+	if (ini_cache_load (sct, cache, &key) == 0) {
+		free (key.buf);
+		return (0);
+	}
+
+	if ((fp = fopen (fname, "rb")) == NULL) {
+		free (key.buf);
+		return (1);
+	}
+
+	scn_init (&scn);
+
+	r = ini_read_scn (&scn, sct, fp, fname);
+
+	fclose (fp);
+
+	if (r == 0) {
+		ini_cache_save (sct, cache, &key, scn.dep);
+	}
+
+	scn_free (&scn);
+
+	free (key.buf);
+
+	return (r);
+}
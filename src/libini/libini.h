@@ -42,6 +42,7 @@ typedef struct ini_val_s {
 	struct ini_val_s *next;
 
 	char             *name;
+	unsigned long    hash;
 	unsigned         type;
 
 	union {
@@ -60,6 +61,7 @@ typedef struct ini_sct_s {
 	struct ini_sct_s *parent;
 
 	char             *name;
+	unsigned long    hash;
 
 	struct ini_sct_s *sub_head;
 	struct ini_sct_s *sub_tail;
@@ -76,6 +78,11 @@ typedef struct {
 } ini_strings_t;
 
 
+/*!***************************************************************************
+ * @short Get the hash value of a section or value name
+ *****************************************************************************/
+unsigned long ini_hash (const char *str);
+
 void ini_val_init (ini_val_t *val, const char *name);
 
 void ini_val_free (ini_val_t *val);
@@ -288,6 +295,20 @@ int ini_read_fp (ini_sct_t *sct, FILE *fp, const char *fname);
  *****************************************************************************/
 int ini_read (ini_sct_t *sct, const char *fname);
 
+/*!***************************************************************************
+ * @short  Read an ini tree from a file, using a cache file
+ * @param  fname The file name
+ * @param  cache The cache file name or NULL
+ * @return True on error
+ *
+ * The cache file contains the tree after the file was read, in binary
+ * form. It is used instead of the file if the tree before reading
+ * is the same as when the cache was written, and if the file and all
+ * files it includes have the same size and modification time.
+ * Otherwise the file is read and the cache file is rewritten.
+ *****************************************************************************/
+int ini_read_cache (ini_sct_t *sct, const char *fname, const char *cache);
+
 
 /*!***************************************************************************
  * @short  Write an ini tree to a file
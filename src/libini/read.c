@@ -362,33 +362,44 @@ int ini_read_str (ini_sct_t *sct, const char *str)
 	return (0);
 }
 
-int ini_read_fp (ini_sct_t *sct, FILE *fp, const char *fname)
+/*
+ * Read an ini tree from a file, using an initialized scanner. The
+ * scanner is not freed.
+ */
+int ini_read_scn (scanner_t *scn, ini_sct_t *sct, FILE *fp, const char *fname)
 {
-	scanner_t scn;
-	char      buf[256];
+	char buf[256];
 
-	scn_init (&scn);
-
-	if (scn_add_file (&scn, fname, fp, 0, 0)) {
+	if (scn_add_file (scn, fname, fp, 0, 0)) {
 		ini_sct_del (sct);
 		return (1);
 	}
 
-	if (parse_section (&scn, sct, buf)) {
-		parse_error (&scn, "parse error before", 1);
-		scn_free (&scn);
+	if (parse_section (scn, sct, buf)) {
+		parse_error (scn, "parse error before", 1);
 		return (1);
 	}
 
-	if (scn_get_chr (&scn, 0) != 0) {
-		parse_error (&scn, "parse error before", 1);
-		scn_free (&scn);
+	if (scn_get_chr (scn, 0) != 0) {
+		parse_error (scn, "parse error before", 1);
 		return (1);
 	}
 
+	return (0);
+}
+
+int ini_read_fp (ini_sct_t *sct, FILE *fp, const char *fname)
+{
+	int       r;
+	scanner_t scn;
+
+	scn_init (&scn);
+
+	r = ini_read_scn (&scn, sct, fp, fname);
+
 	scn_free (&scn);
 
-	return (0);
+	return (r);
 }
 
 int ini_read (ini_sct_t *sct, const char *fname)
@@ -125,6 +125,42 @@ void scn_file_del (scn_file_t *scf)
 	}
 }
 
+static
+void scn_dep_del (scn_dep_t *dep)
+{
+	scn_dep_t *tmp;
+
+	while (dep != NULL) {
+		tmp = dep;
+		dep = dep->next;
+
+		free (tmp->name);
+		free (tmp);
+	}
+}
+
+static
+int scn_add_dep (scanner_t *scn, const char *name, int found)
+{
+	scn_dep_t *dep;
+
+	if ((dep = malloc (sizeof (scn_dep_t))) == NULL) {
+		return (1);
+	}
+
+	if ((dep->name = strdup (name)) == NULL) {
+		free (dep);
+		return (1);
+	}
+
+	dep->found = found;
+
+	dep->next = scn->dep;
+	scn->dep = dep;
+
+	return (0);
+}
+
 void scn_init (scanner_t *scn)
 {
 	scn->cnt = 0;
@@ -133,6 +169,7 @@ void scn_init (scanner_t *scn)
 	scn->offset = 0;
 
 	scn->file = NULL;
+	scn->dep = NULL;
 	scn->str = NULL;
 }
 
@@ -140,6 +177,7 @@ void scn_free (scanner_t *scn)
 {
 	if (scn != NULL) {
 		scn_file_del (scn->file);
+		scn_dep_del (scn->dep);
 	}
 }
 
@@ -185,6 +223,15 @@ int scn_add_file (scanner_t *scn, const char *fname, FILE *fp, int del, int rel)
 		scf->fp = fopen (name, "r");
 	}
 
+	if (scn_add_dep (scn, name, scf->fp != NULL)) {
+		if ((fp == NULL) && (scf->fp != NULL)) {
+			fclose (scf->fp);
+		}
+
+		scn_file_del (scf);
+		return (1);
+	}
+
 	if (scf->fp == NULL) {
 		scn_file_del (scf);
 		return (1);
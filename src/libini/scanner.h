@@ -26,6 +26,8 @@
 
 #include <stdio.h>
 
+#include <libini/libini.h>
+
 
 #define SCN_BUF_MAX 256
 
@@ -41,6 +43,14 @@ typedef struct scn_file_t {
 } scn_file_t;
 
 
+/* a file that was opened or could not be opened by the scanner */
+typedef struct scn_dep_t {
+	struct scn_dep_t *next;
+	char             *name;
+	int              found;
+} scn_dep_t;
+
+
 /*!***************************************************************************
  * @short The scanner type
  *****************************************************************************/
@@ -55,6 +65,9 @@ typedef struct {
 
 	scn_file_t    *file;
 
+	/* all files used so far, in reverse order */
+	scn_dep_t     *dep;
+
 	const char    *str;
 } scanner_t;
 
@@ -80,4 +93,11 @@ int scn_match_ident (scanner_t *scn, const char *str);
 int scn_match (scanner_t *scn, const char *str);
 
 
+/*!***************************************************************************
+ * @short  Read an ini tree from a file, using an initialized scanner
+ * @return Zero if successful, nonzero otherwise
+ *****************************************************************************/
+int ini_read_scn (scanner_t *scn, ini_sct_t *sct, FILE *fp, const char *fname);
+
+
 #endif
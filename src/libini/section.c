@@ -170,6 +170,8 @@ ini_sct_t *ini_sct_new (const char *name)
 		sct->name = NULL;
 	}
 
+	sct->hash = ini_hash (name);
+
 	sct->sub_head = NULL;
 	sct->sub_tail = NULL;
 
@@ -249,6 +251,8 @@ ini_val_t *ini_new_val (ini_sct_t *sct, const char *name)
 
 ini_sct_t *ini_next_sct (ini_sct_t *sct, ini_sct_t *val, const char *name)
 {
+	unsigned long hash;
+
 	if (val == NULL) {
 		if (sct == NULL) {
 			return (NULL);
@@ -268,8 +272,10 @@ ini_sct_t *ini_next_sct (ini_sct_t *sct, ini_sct_t *val, const char *name)
 		return (val);
 	}
 
+	hash = ini_hash (name);
+
 	while (val != NULL) {
-		if (strcmp (val->name, name) == 0) {
+		if ((val->hash == hash) && (strcmp (val->name, name) == 0)) {
 			return (val);
 		}
 
@@ -281,6 +287,8 @@ ini_sct_t *ini_next_sct (ini_sct_t *sct, ini_sct_t *val, const char *name)
 
 ini_val_t *ini_next_val (ini_sct_t *sct, ini_val_t *val, const char *name)
 {
+	unsigned long hash;
+
 	if (val == NULL) {
 		if (sct == NULL) {
 			return (NULL);
@@ -300,8 +308,10 @@ ini_val_t *ini_next_val (ini_sct_t *sct, ini_val_t *val, const char *name)
 		return (NULL);
 	}
 
+	hash = ini_hash (name);
+
 	while (val != NULL) {
-		if (strcmp (val->name, name) == 0) {
+		if ((val->hash == hash) && (strcmp (val->name, name) == 0)) {
 			return (val);
 		}
 
@@ -318,13 +328,16 @@ ini_val_t *ini_next_val (ini_sct_t *sct, ini_val_t *val, const char *name)
 static
 ini_sct_t *ini_get_last_sct (ini_sct_t *sct, const char *name, int add)
 {
-	ini_sct_t *sub, *ret;
+	unsigned long hash;
+	ini_sct_t     *sub, *ret;
+
+	hash = ini_hash (name);
 
 	sub = sct->sub_head;
 	ret = NULL;
 
 	while (sub != NULL) {
-		if (strcmp (sub->name, name) == 0) {
+		if ((sub->hash == hash) && (strcmp (sub->name, name) == 0)) {
 			ret = sub;
 		}
 
@@ -342,12 +355,15 @@ static
 ini_sct_t *ini_get_indexed_sct (ini_sct_t *sct, const char *name,
 	unsigned index, int add)
 {
-	ini_sct_t *sub;
+	unsigned long hash;
+	ini_sct_t     *sub;
+
+	hash = ini_hash (name);
 
 	sub = sct->sub_head;
 
 	while (sub != NULL) {
-		if (strcmp (sub->name, name) == 0) {
+		if ((sub->hash == hash) && (strcmp (sub->name, name) == 0)) {
 			if (index == 0) {
 				return (sub);
 			}
@@ -380,13 +396,16 @@ ini_sct_t *ini_get_indexed_sct (ini_sct_t *sct, const char *name,
 static
 ini_val_t *ini_get_last_val (ini_sct_t *sct, const char *name, int add)
 {
-	ini_val_t *val, *ret;
+	unsigned long hash;
+	ini_val_t     *val, *ret;
+
+	hash = ini_hash (name);
 
 	val = sct->val_head;
 	ret = NULL;
 
 	while (val != NULL) {
-		if (strcmp (val->name, name) == 0) {
+		if ((val->hash == hash) && (strcmp (val->name, name) == 0)) {
 			ret = val;
 		}
 
@@ -404,12 +423,15 @@ static
 ini_val_t *ini_get_indexed_val (ini_sct_t *sct, const char *name,
 	unsigned index, int add)
 {
-	ini_val_t *val;
+	unsigned long hash;
+	ini_val_t     *val;
+
+	hash = ini_hash (name);
 
 	val = sct->val_head;
 
 	while (val != NULL) {
-		if (strcmp (val->name, name) == 0) {
+		if ((val->hash == hash) && (strcmp (val->name, name) == 0)) {
 			if (index == 0) {
 				return (val);
 			}
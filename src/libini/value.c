@@ -28,14 +28,29 @@
 #include <libini/libini.h>
 
 
+unsigned long ini_hash (const char *str)
+{
+	unsigned long h;
+
+	h = 0;
+
+	while (*str != 0) {
+		h = (31 * h + (unsigned char) *(str++)) & 0xffffffff;
+	}
+
+	return (h);
+}
+
 void ini_val_init (ini_val_t *val, const char *name)
 {
 	val->next = NULL;
 	val->name = NULL;
+	val->hash = 0;
 	val->type = INI_VAL_NONE;
 
 	if (name != NULL) {
 		val->name = strdup (name);
+		val->hash = ini_hash (name);
 	}
 }
 
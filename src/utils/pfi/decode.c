@@ -42,6 +42,9 @@ struct decode_bits_s {
 	const char    *type;
 	FILE          *fp;
 	unsigned long rate;
+
+	/* the decode buffer, shared by all tracks */
+	pfi_dec_t     bit;
 };
 
 
@@ -56,6 +59,9 @@ struct decode_pri_s {
 	unsigned      fold_mode;
 	unsigned      fold_window;
 	unsigned long max_compare;
+
+	/* the decode buffer, shared by all tracks */
+	pfi_dec_t     bit;
 };
 
 
@@ -156,32 +162,30 @@ int pfi_decode_bits_cb (pfi_img_t *img, pfi_trk_t *trk, unsigned long c, unsigne
 {
 	int                  r;
 	struct decode_bits_s *par;
-	pfi_dec_t            bit;
+	pfi_dec_t            *bit;
 
 	par = opaque;
+	bit = &par->bit;
 
-	pfi_dec_init (&bit, 0);
+	pfi_dec_reset (bit);
 
-	if (pfi_trk_decode_bits (trk, &bit, par->rate, par_revolution)) {
-		pfi_dec_free (&bit);
+	if (pfi_trk_decode_bits (trk, bit, par->rate, par_revolution)) {
 		return (1);
 	}
 
 	if (strcmp (par->type, "raw") == 0) {
-		r = pfi_decode_bits_raw (par->fp, bit.buf, bit.index);
+		r = pfi_decode_bits_raw (par->fp, bit->buf, bit->index);
 	}
 	else if (strcmp (par->type, "gcr-raw") == 0) {
-		r = pfi_decode_bits_gcr (par->fp, bit.buf, bit.index);
+		r = pfi_decode_bits_gcr (par->fp, bit->buf, bit->index);
 	}
 	else if (strcmp (par->type, "mfm-raw") == 0) {
-		r = pfi_decode_bits_mfm (par->fp, bit.buf, bit.index);
+		r = pfi_decode_bits_mfm (par->fp, bit->buf, bit->index);
 	}
 	else {
 		r = 1;
 	}
 
-	pfi_dec_free (&bit);
-
 	return (r);
 }
 
@@ -198,8 +202,15 @@ int pfi_decode_bits (pfi_img_t *img, const char *type, unsigned long rate, const
 		return (1);
 	}
 
+	if (pfi_dec_init (&par.bit, 0)) {
+		fclose (par.fp);
+		return (1);
+	}
+
 	r = pfi_for_all_tracks (img, pfi_decode_bits_cb, &par);
 
+	pfi_dec_free (&par.bit);
+
 	fclose (par.fp);
 
 	return (r);
@@ -487,17 +498,16 @@ int pfi_decode_pri_trk_cb (pfi_img_t *img, pfi_trk_t *strk, unsigned long c, uns
 	unsigned long       rate;
 	pri_trk_t           *dtrk;
 	struct decode_pri_s *par;
-	pfi_dec_t           bit;
+	pfi_dec_t           *bit;
 
 	par = opaque;
+	bit = &par->bit;
 
 	if ((dtrk = pri_img_get_track (par->img, c, h, 1)) == NULL) {
 		return (1);
 	}
 
-	if (pfi_dec_init (&bit, 0)) {
-		return (1);
-	}
+	pfi_dec_reset (bit);
 
 	pfi_trk_rewind (strk);
 
@@ -508,40 +518,37 @@ int pfi_decode_pri_trk_cb (pfi_img_t *img, pfi_trk_t *strk, unsigned long c, uns
 		rate = par->default_rate;
 	}
 
-	if (pfi_trk_decode_bits (strk, &bit, rate, par->revolution)) {
-		pfi_dec_free (&bit);
+	if (pfi_trk_decode_bits (strk, bit, rate, par->revolution)) {
 		return (1);
 	}
 
 	switch (par->fold_mode) {
 	case PFI_FOLD_MAXRUN:
-		pfi_dec_fold_maxrun (&bit, par->fold_window, par->max_compare, c, h);
+		pfi_dec_fold_maxrun (bit, par->fold_window, par->max_compare, c, h);
 		break;
 
 	case PFI_FOLD_MINDIFF:
-		pfi_dec_fold_mindiff (&bit, par->fold_window, par->max_compare, c, h);
+		pfi_dec_fold_mindiff (bit, par->fold_window, par->max_compare, c, h);
 		break;
 
 	default:
-		bit.cnt = bit.index;
+		bit->cnt = bit->index;
 		break;
 	}
 
 	pri_trk_set_clock (dtrk, rate);
-	pri_trk_set_size (dtrk, bit.index);
+	pri_trk_set_size (dtrk, bit->index);
 
-	memcpy (dtrk->data, bit.buf, (bit.index + 7) / 8);
+	memcpy (dtrk->data, bit->buf, (bit->index + 7) / 8);
 
 	if (par_weak_bits) {
-		pfi_decode_weak (dtrk, &bit, par_weak_i1, par_weak_i2);
+		pfi_decode_weak (dtrk, bit, par_weak_i1, par_weak_i2);
 	}
 
 	if (par_decode_clock) {
-		pfi_decode_clock (dtrk, &bit, par_clock_tolerance);
+		pfi_decode_clock (dtrk, bit, par_clock_tolerance);
 	}
 
-	pfi_dec_free (&bit);
-
 	pri_trk_clear_slack (dtrk);
 
 	return (0);
@@ -595,11 +602,19 @@ pri_img_t *pfi_decode_pri (pfi_img_t *img, unsigned mode, unsigned long rate)
 	par.fold_window = par_fold_window;
 	par.max_compare = par_fold_max;
 
+	if (pfi_dec_init (&par.bit, 0)) {
+		pri_img_del (par.img);
+		return (NULL);
+	}
+
 	if (pfi_for_all_tracks (img, pfi_decode_pri_trk_cb, &par)) {
+		pfi_dec_free (&par.bit);
 		pri_img_del (par.img);
 		return (NULL);
 	}
 
+	pfi_dec_free (&par.bit);
+
 	if (img->comment_size > 0) {
 		pri_img_set_comment (par.img, img->comment, img->comment_size);
 	}
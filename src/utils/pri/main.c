@@ -657,6 +657,20 @@ int pri_operation (pri_img_t **img, const char *op, int argc, char **argv)
 }
 
 
+static
+void pri_load_journal (pri_img_t *img, const char *fname)
+{
+	unsigned long cnt;
+
+	if (pri_journal_load (fname, img, &cnt)) {
+		fprintf (stderr, "%s: damaged journal (%s.jnl)\n", arg0, fname);
+	}
+
+	if (par_verbose && (cnt > 0)) {
+		fprintf (stderr, "%s: applied %lu journal records\n", arg0, cnt);
+	}
+}
+
 static
 pri_img_t *pri_load_image (const char *fname)
 {
@@ -671,6 +685,10 @@ pri_img_t *pri_load_image (const char *fname)
 	}
 	else {
 		img = pri_img_load (fname, par_fmt_inp);
+
+		if (img != NULL) {
+			pri_load_journal (img, fname);
+		}
 	}
 
 	if (img == NULL) {
@@ -713,6 +731,11 @@ int pri_save_image (const char *fname, pri_img_t **img)
 	}
 	else {
 		r = pri_img_save (fname, *img, par_fmt_out);
+
+		/* the journal is part of the old image */
+		if (r == 0) {
+			r = pri_journal_remove (fname);
+		}
 	}
 
 	if (r) {
@@ -570,6 +570,20 @@ int psi_operation (psi_img_t **img, const char *op, int argc, char **argv)
 }
 
 
+static
+void psi_load_journal (psi_img_t *img, const char *fname)
+{
+	unsigned long cnt;
+
+	if (psi_journal_load (fname, img, &cnt)) {
+		fprintf (stderr, "%s: damaged journal (%s.jnl)\n", arg0, fname);
+	}
+
+	if (par_verbose && (cnt > 0)) {
+		fprintf (stderr, "%s: applied %lu journal records\n", arg0, cnt);
+	}
+}
+
 static
 psi_img_t *psi_load_image (const char *fname)
 {
@@ -589,6 +603,10 @@ psi_img_t *psi_load_image (const char *fname)
 	}
 	else {
 		img = psi_load (fname, par_fmt_inp);
+
+		if (img != NULL) {
+			psi_load_journal (img, fname);
+		}
 	}
 
 	if (img == NULL) {
@@ -643,6 +661,11 @@ int psi_save_image (psi_img_t **img, const char *fname)
 	}
 	else {
 		r = psi_save (fname, *img, par_fmt_out);
+
+		/* the journal is part of the old image */
+		if (r == 0) {
+			r = psi_journal_remove (fname);
+		}
 	}
 
 	if (r) {